@@ -0,0 +1,96 @@
+#include "BackgroundMaterial.h"
+
+#include <QMatrix4x4>
+#include <QSGMaterialShader>
+#include <cstring>
+#include <functional>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+namespace
+{
+// std140 layout of the shaders' uniform block.
+constexpr int MatrixOffset = 0;
+constexpr int TintOffset = 64;
+constexpr int UOffsetOffset = 80;
+constexpr int SaturationOffset = 84;
+constexpr int BrightnessOffset = 88;
+constexpr int OpacityOffset = 92;
+
+class BackgroundShader : public QSGMaterialShader
+{
+public:
+    BackgroundShader()
+    {
+        setShaderFileName(VertexStage, QStringLiteral(":/EarthView/shaders/background.vert.qsb"));
+        setShaderFileName(FragmentStage, QStringLiteral(":/EarthView/shaders/background.frag.qsb"));
+    }
+
+    bool updateUniformData(RenderState &state, QSGMaterial *newMaterial, QSGMaterial *) override
+    {
+        QByteArray *buf = state.uniformData();
+        Q_ASSERT(buf->size() >= OpacityOffset + 4);
+        if (state.isMatrixDirty()) {
+            const QMatrix4x4 m = state.combinedMatrix();
+            std::memcpy(buf->data() + MatrixOffset, m.constData(), 64);
+        }
+        if (state.isOpacityDirty()) {
+            const float opacity = state.opacity();
+            std::memcpy(buf->data() + OpacityOffset, &opacity, sizeof opacity);
+        }
+        // Written every time: a pan changes the offset of the same material object.
+        const auto *mat = static_cast<const BackgroundMaterial *>(newMaterial);
+        const QColor t = mat->tint();
+        const float tint[4] = {float(t.redF()), float(t.greenF()), float(t.blueF()), 1.0f};
+        const float uOffset = mat->uOffset();
+        const float saturation = mat->saturation();
+        const float brightness = mat->brightness();
+        std::memcpy(buf->data() + TintOffset, tint, sizeof tint);
+        std::memcpy(buf->data() + UOffsetOffset, &uOffset, sizeof uOffset);
+        std::memcpy(buf->data() + SaturationOffset, &saturation, sizeof saturation);
+        std::memcpy(buf->data() + BrightnessOffset, &brightness, sizeof brightness);
+        return true;
+    }
+
+    void updateSampledImage(RenderState &state, int binding, QSGTexture **texture, QSGMaterial *newMaterial,
+                            QSGMaterial *) override
+    {
+        if (binding != 1)
+            return;
+        QSGTexture *t = static_cast<BackgroundMaterial *>(newMaterial)->texture();
+        t->setFiltering(QSGTexture::Linear);
+        t->setMipmapFiltering(t->hasMipmaps() ? QSGTexture::Linear : QSGTexture::None);
+        t->setHorizontalWrapMode(QSGTexture::Repeat);
+        t->setVerticalWrapMode(QSGTexture::ClampToEdge);
+        t->commitTextureOperations(state.rhi(), state.resourceUpdateBatch());
+        *texture = t;
+    }
+};
+}
+
+BackgroundMaterial::BackgroundMaterial()
+{
+    setFlag(Blending);
+}
+
+QSGMaterialType *BackgroundMaterial::type() const
+{
+    static QSGMaterialType type;
+    return &type;
+}
+
+QSGMaterialShader *BackgroundMaterial::createShader(QSGRendererInterface::RenderMode) const
+{
+    return new BackgroundShader;
+}
+
+int BackgroundMaterial::compare(const QSGMaterial *other) const
+{
+    const auto *o = static_cast<const BackgroundMaterial *>(other);
+    if (m_texture != o->m_texture)
+        return std::less<const void *>()(m_texture, o->m_texture) ? -1 : 1;
+    if (m_uOffset != o->m_uOffset || m_tint != o->m_tint || m_saturation != o->m_saturation || m_brightness != o->m_brightness)
+        return std::less<const void *>()(this, other) ? -1 : 1;
+    return 0;
+}
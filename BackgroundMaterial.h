@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QColor>
+#include <QSGMaterial>
+#include <QSGTexture>
+#include <QtGlobal>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// The background texture over the whole view in one draw: texture coordinates are map fractions (u 0 at the left
+// edge of the map, v 0 at the north pole), offset horizontally by uOffset in the shader with a repeating wrap mode, so
+// panning changes a uniform rather than the geometry. Tint, saturation and brightness theme the texture without
+// another asset. RHI backends only.
+class BackgroundMaterial : public QSGMaterial
+{
+public:
+    BackgroundMaterial();
+
+    QSGTexture *texture() const { return m_texture; }
+    void setTexture(QSGTexture *texture) { m_texture = texture; }
+    // Texture u at the left edge of the map: centerLongitude / 360 for a texture starting at -180 degrees.
+    float uOffset() const { return m_uOffset; }
+    void setUOffset(float offset) { m_uOffset = offset; }
+    QColor tint() const { return m_tint; }
+    void setTint(const QColor &tint) { m_tint = tint; }
+    float saturation() const { return m_saturation; }
+    void setSaturation(float saturation) { m_saturation = saturation; }
+    float brightness() const { return m_brightness; }
+    void setBrightness(float brightness) { m_brightness = brightness; }
+
+    QSGMaterialType *type() const override;
+    QSGMaterialShader *createShader(QSGRendererInterface::RenderMode renderMode) const override;
+    int compare(const QSGMaterial *other) const override;
+
+private:
+    QSGTexture *m_texture {nullptr}; // not owned
+    float m_uOffset {0.0f};
+    QColor m_tint {Qt::white};
+    float m_saturation {1.0f};
+    float m_brightness {1.0f};
+};
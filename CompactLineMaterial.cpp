@@ -0,0 +1,88 @@
+#include "CompactLineMaterial.h"
+
+#include <QMatrix4x4>
+#include <QSGMaterialShader>
+#include <cstring>
+#include <functional>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+namespace
+{
+// std140 layout of the shaders' uniform block.
+constexpr int MatrixOffset = 0;
+constexpr int ColorOffset = 64;
+constexpr int MapRectOffset = 80;
+constexpr int OpacityOffset = 96;
+
+class CompactLineShader : public QSGMaterialShader
+{
+public:
+    CompactLineShader()
+    {
+        setShaderFileName(VertexStage, QStringLiteral(":/EarthView/shaders/compactline.vert.qsb"));
+        setShaderFileName(FragmentStage, QStringLiteral(":/EarthView/shaders/compactline.frag.qsb"));
+    }
+
+    bool updateUniformData(RenderState &state, QSGMaterial *newMaterial, QSGMaterial *) override
+    {
+        QByteArray *buf = state.uniformData();
+        Q_ASSERT(buf->size() >= OpacityOffset + 4);
+        if (state.isMatrixDirty()) {
+            const QMatrix4x4 m = state.combinedMatrix();
+            std::memcpy(buf->data() + MatrixOffset, m.constData(), 64);
+        }
+        if (state.isOpacityDirty()) {
+            const float opacity = state.opacity();
+            std::memcpy(buf->data() + OpacityOffset, &opacity, sizeof opacity);
+        }
+        // Colour and rect are written every time: the same material object gets a new rect on resize.
+        const auto *mat = static_cast<const CompactLineMaterial *>(newMaterial);
+        const QColor c = mat->color();
+        const float color[4] = {float(c.redF() * c.alphaF()), float(c.greenF() * c.alphaF()), float(c.blueF() * c.alphaF()),
+                                float(c.alphaF())};
+        const QRectF r = mat->mapRect();
+        const float rect[4] = {float(r.x()), float(r.y()), float(r.width()), float(r.height())};
+        std::memcpy(buf->data() + ColorOffset, color, sizeof color);
+        std::memcpy(buf->data() + MapRectOffset, rect, sizeof rect);
+        return true;
+    }
+};
+}
+
+const QSGGeometry::AttributeSet &CompactPoint2D::attributes()
+{
+    static const QSGGeometry::Attribute attr = QSGGeometry::Attribute::createWithAttributeType(
+        0, 2, QSGGeometry::UnsignedShortType, QSGGeometry::PositionAttribute);
+    static const QSGGeometry::AttributeSet set = {1, sizeof(CompactPoint2D), &attr};
+    return set;
+}
+
+CompactLineMaterial::CompactLineMaterial()
+{
+    // The vertex data is not in item coordinates, so the batch renderer must not merge it (it transforms merged
+    // positions on the CPU).
+    setFlag(Blending | RequiresFullMatrix);
+}
+
+QSGMaterialType *CompactLineMaterial::type() const
+{
+    static QSGMaterialType type;
+    return &type;
+}
+
+QSGMaterialShader *CompactLineMaterial::createShader(QSGRendererInterface::RenderMode) const
+{
+    return new CompactLineShader;
+}
+
+int CompactLineMaterial::compare(const QSGMaterial *other) const
+{
+    const auto *o = static_cast<const CompactLineMaterial *>(other);
+    if (m_color != o->m_color)
+        return m_color.rgba() < o->m_color.rgba() ? -1 : 1;
+    if (m_mapRect != o->m_mapRect)
+        return std::less<const void *>()(this, other) ? -1 : 1;
+    return 0;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <QColor>
+#include <QRectF>
+#include <QSGGeometry>
+#include <QSGMaterial>
+#include <QSizeF>
+#include <QtGlobal>
+#include <algorithm>
+#include <cmath>
+
+#include "Projection.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Compact vertex layout for line layers: two unsigned 16-bit map coordinates per vertex (4 bytes instead of 8),
+// placed in the view by the vertex shader from the material's map rect. Map x is the wrapped longitude fraction in
+// [0, 1) with room for seam copies down to -1 and up to 2; map y is the latitude fraction, 0 at the north pole.
+// Because positions do not depend on the item size, resizing only updates the material. RHI backends only.
+struct CompactPoint2D
+{
+    quint16 x;
+    quint16 y;
+
+    static constexpr float XMin = -1.0f;
+    static constexpr float XRange = 3.0f;
+    // Largest quantisation step, in device pixels, at which lines still meet the float-positioned dots.
+    static constexpr qreal MaxStepPixels = 0.5;
+
+    void set(float mapX, float mapY)
+    {
+        x = quint16(std::lround(std::clamp((mapX - XMin) / XRange, 0.0f, 1.0f) * 65535.0f));
+        y = quint16(std::lround(std::clamp(mapY, 0.0f, 1.0f) * 65535.0f));
+    }
+
+    static const QSGGeometry::AttributeSet &attributes();
+
+    // Whether 16-bit map units resolve a map of `mapSize` item pixels within MaxStepPixels. The step grows with the
+    // zoom (x spans three map widths), so zoomed far in the lines would stair-step and drift off the dots; layers
+    // then fall back to float vertices.
+    static bool resolves(const QSizeF &mapSize, qreal devicePixelRatio)
+    {
+        const qreal step = std::max(mapSize.width() * XRange, mapSize.height()) / 65535.0;
+        return step * devicePixelRatio <= MaxStepPixels;
+    }
+};
+
+// Map units as a Projection mapping: the unit rect, so x and y come out as map fractions.
+inline Projection::Mapping compactMapping(double centerLongitude)
+{
+    return Projection::Mapping::forView(QRectF(0, 0, 1, 1), centerLongitude);
+}
+
+class CompactLineMaterial : public QSGMaterial
+{
+public:
+    CompactLineMaterial();
+
+    QColor color() const { return m_color; }
+    void setColor(const QColor &color) { m_color = color; }
+    // The view rect in item pixels that map x in [0, 1) and y in [0, 1] cover.
+    QRectF mapRect() const { return m_mapRect; }
+    void setMapRect(const QRectF &rect) { m_mapRect = rect; }
+
+    QSGMaterialType *type() const override;
+    QSGMaterialShader *createShader(QSGRendererInterface::RenderMode renderMode) const override;
+    int compare(const QSGMaterial *other) const override;
+
+private:
+    QColor m_color;
+    QRectF m_mapRect;
+};
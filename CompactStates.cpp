@@ -0,0 +1,362 @@
+#include "CompactStates.h"
+
+#include <QVariantMap>
+#include <QtEndian>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+namespace
+{
+constexpr qint32 Missing = std::numeric_limits<qint32>::min();
+constexpr qint64 HalfTurn = 18000000; // 180 deg in 1e-5 deg
+constexpr qint64 FullTurn = 2 * HalfTurn;
+
+struct Column
+{
+    const QVector<double> *values; // encoder side only
+    double scale;
+    bool wraps;
+};
+
+// Column order shared by encoder and decoder.
+int columnCount(quint8 fields)
+{
+    return 2 + ((fields & CompactStates::AltField) ? 1 : 0) + ((fields & CompactStates::PastField) ? 2 : 0)
+        + ((fields & CompactStates::FutureField) ? 2 : 0);
+}
+
+void columnLayout(quint8 fields, double *scales, bool *wraps)
+{
+    int c = 0;
+    auto add = [&](double scale, bool wrap) {
+        scales[c] = scale;
+        wraps[c] = wrap;
+        ++c;
+    };
+    add(CompactStates::AngleScale, false);
+    add(CompactStates::AngleScale, true);
+    if (fields & CompactStates::AltField)
+        add(CompactStates::AltitudeScale, false);
+    if (fields & CompactStates::PastField) {
+        add(CompactStates::AngleScale, false);
+        add(CompactStates::AngleScale, true);
+    }
+    if (fields & CompactStates::FutureField) {
+        add(CompactStates::AngleScale, false);
+        add(CompactStates::AngleScale, true);
+    }
+}
+
+inline qint32 wrapAngle(qint64 v)
+{
+    v = (v + HalfTurn) % FullTurn;
+    if (v < 0)
+        v += FullTurn;
+    return qint32(v - HalfTurn);
+}
+
+// Prediction from up to two earlier frames; identical on both sides, so any result decodes exactly.
+inline qint32 predict(qint32 p1, qint32 p2, bool havePrev2, bool wraps)
+{
+    if (!havePrev2)
+        return p1;
+    if (wraps)
+        return qint32(qint64(p1) + wrapAngle(qint64(p1) - p2));
+    return qint32(quint32(p1) * 2u - quint32(p2));
+}
+
+inline qint32 residual(qint32 cur, qint32 pred, bool wraps)
+{
+    if (wraps)
+        return wrapAngle(qint64(cur) - pred);
+    return qint32(quint32(cur) - quint32(pred));
+}
+
+inline qint32 reconstruct(qint32 pred, qint32 r, bool wraps)
+{
+    if (wraps)
+        return wrapAngle(qint64(pred) + r);
+    return qint32(quint32(pred) + quint32(r));
+}
+
+template<typename T>
+void readResiduals(const uchar *src, qint32 *out, int count)
+{
+    for (int i = 0; i < count; ++i)
+        out[i] = qFromLittleEndian<T>(src + i * sizeof(T));
+}
+}
+
+namespace CompactStates
+{
+
+bool isCompact(QByteArrayView payload)
+{
+    return payload.size() >= HeaderSize && std::memcmp(payload.data(), Magic, sizeof(Magic)) == 0;
+}
+
+QVariantList toVariantList(const Batch &batch)
+{
+    const int n = batch.count();
+    const auto value = [n](const QVector<double> &column, int i) {
+        return column.size() == n ? column[i] : std::numeric_limits<double>::quiet_NaN();
+    };
+    QVariantList satellites;
+    satellites.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        const double lat = value(batch.lat, i);
+        const double lon = value(batch.lon, i);
+        if (!std::isfinite(lat) || !std::isfinite(lon))
+            continue;
+        QVariantMap sat;
+        sat.insert(QStringLiteral("ID"), batch.ids[i]);
+        sat.insert(QStringLiteral("Lat"), lat);
+        sat.insert(QStringLiteral("Lon"), lon);
+        if (std::isfinite(value(batch.alt, i)))
+            sat.insert(QStringLiteral("Alt"), value(batch.alt, i));
+        if (std::isfinite(value(batch.latPast, i)) && std::isfinite(value(batch.lonPast, i))) {
+            sat.insert(QStringLiteral("LatPast"), value(batch.latPast, i));
+            sat.insert(QStringLiteral("LonPast"), value(batch.lonPast, i));
+        }
+        if (std::isfinite(value(batch.latFuture, i)) && std::isfinite(value(batch.lonFuture, i))) {
+            sat.insert(QStringLiteral("LatFuture"), value(batch.latFuture, i));
+            sat.insert(QStringLiteral("LonFuture"), value(batch.lonFuture, i));
+        }
+        satellites.append(sat);
+    }
+    return satellites;
+}
+
+void Encoder::setKeyInterval(int frames)
+{
+    m_keyInterval = std::max(frames, 1);
+}
+
+QByteArray Encoder::encode(const Batch &batch)
+{
+    const int count = batch.count();
+    quint8 fields = 0;
+    if (batch.alt.size() == count && count > 0)
+        fields |= AltField;
+    if (batch.latPast.size() == count && batch.lonPast.size() == count && count > 0)
+        fields |= PastField;
+    if (batch.latFuture.size() == count && batch.lonFuture.size() == count && count > 0)
+        fields |= FutureField;
+
+    const Column all[] = {
+        {&batch.lat, AngleScale, false},       {&batch.lon, AngleScale, true},
+        {&batch.alt, AltitudeScale, false},    {&batch.latPast, AngleScale, false},
+        {&batch.lonPast, AngleScale, true},    {&batch.latFuture, AngleScale, false},
+        {&batch.lonFuture, AngleScale, true},
+    };
+    std::vector<Column> columns = {all[0], all[1]};
+    if (fields & AltField)
+        columns.push_back(all[2]);
+    if (fields & PastField) {
+        columns.push_back(all[3]);
+        columns.push_back(all[4]);
+    }
+    if (fields & FutureField) {
+        columns.push_back(all[5]);
+        columns.push_back(all[6]);
+    }
+
+    // Quantize.
+    bool missing = false;
+    std::vector<std::vector<qint32>> cur(columns.size(), std::vector<qint32>(count));
+    for (size_t c = 0; c < columns.size(); ++c) {
+        const double *src = columns[c].values->constData();
+        qint32 *dst = cur[c].data();
+        const double scale = columns[c].scale;
+        for (int i = 0; i < count; ++i) {
+            const double v = src[i];
+            if (!std::isfinite(v) || std::abs(v * scale) >= 2147483647.0) {
+                dst[i] = Missing;
+                missing = true;
+            } else {
+                dst[i] = qint32(std::lround(v * scale));
+            }
+        }
+    }
+
+    // Missing values would not survive longitude wrapping, so such batches are always sent whole.
+    const bool key = missing || m_history == 0 || m_sinceKey + 1 >= m_keyInterval || fields != m_fields
+        || batch.ids != m_ids;
+    const FrameKind kind = key ? FrameKind::Key : (m_history >= 2 ? FrameKind::Delta2 : FrameKind::Delta1);
+
+    QByteArray out;
+    out.reserve(HeaderSize + count * int(4 + columns.size() * 4));
+    uchar header[HeaderSize] = {};
+    std::memcpy(header, Magic, sizeof(Magic));
+    header[4] = quint8(kind);
+    header[5] = fields;
+    qToLittleEndian<quint32>(++m_sequence, header + 8);
+    qToLittleEndian<quint32>(quint32(count), header + 12);
+    out.append(reinterpret_cast<const char *>(header), HeaderSize);
+
+    if (key) {
+        const qsizetype base = out.size();
+        out.resize(base + qsizetype(count) * 4 * qsizetype(1 + columns.size()));
+        uchar *p = reinterpret_cast<uchar *>(out.data()) + base;
+        for (int i = 0; i < count; ++i, p += 4)
+            qToLittleEndian<quint32>(batch.ids[i], p);
+        for (const auto &col : cur) {
+            for (int i = 0; i < count; ++i, p += 4)
+                qToLittleEndian<qint32>(col[i], p);
+        }
+        m_ids = batch.ids;
+        m_fields = fields;
+        m_sinceKey = 0;
+        m_history = missing ? 0 : 1;
+    } else {
+        std::vector<qint32> res(count);
+        for (size_t c = 0; c < columns.size(); ++c) {
+            const bool wraps = columns[c].wraps;
+            qint32 maxAbs = 0;
+            for (int i = 0; i < count; ++i) {
+                const qint32 pred = predict(m_prev[c][i], m_history >= 2 ? m_prev2[c][i] : 0, m_history >= 2, wraps);
+                res[i] = residual(cur[c][i], pred, wraps);
+                maxAbs = std::max(maxAbs, res[i] == std::numeric_limits<qint32>::min() ? std::numeric_limits<qint32>::max()
+                                                                                         : std::abs(res[i]));
+            }
+            const int width = maxAbs <= 127 ? 1 : (maxAbs <= 32767 ? 2 : 4);
+            const qsizetype base = out.size();
+            out.resize(base + 1 + qsizetype(count) * width);
+            uchar *p = reinterpret_cast<uchar *>(out.data()) + base;
+            *p++ = quint8(width);
+            for (int i = 0; i < count; ++i, p += width) {
+                if (width == 1)
+                    *p = uchar(qint8(res[i]));
+                else if (width == 2)
+                    qToLittleEndian<qint16>(qint16(res[i]), p);
+                else
+                    qToLittleEndian<qint32>(res[i], p);
+            }
+        }
+        ++m_sinceKey;
+        m_history = std::min(m_history + 1, 2);
+    }
+
+    if (m_history > 0) {
+        m_prev2 = std::move(m_prev);
+        m_prev = std::move(cur);
+    }
+    return out;
+}
+
+bool Decoder::decode(QByteArrayView payload, Batch &batch)
+{
+    if (!isCompact(payload))
+        return false;
+    const auto *data = reinterpret_cast<const uchar *>(payload.data());
+    const auto kind = FrameKind(data[4]);
+    const quint8 fields = data[5];
+    const quint32 sequence = qFromLittleEndian<quint32>(data + 8);
+    const quint32 count32 = qFromLittleEndian<quint32>(data + 12);
+    const int columns = columnCount(fields);
+    if (count32 > quint32(std::numeric_limits<int>::max() / (4 * (1 + columns))))
+        return false;
+    const int count = int(count32);
+
+    double scales[7];
+    bool wraps[7];
+    columnLayout(fields, scales, wraps);
+
+    std::vector<std::vector<qint32>> cur(columns, std::vector<qint32>(count));
+    const uchar *p = data + HeaderSize;
+    const uchar *end = data + payload.size();
+
+    bool hasMissing = false;
+    if (kind == FrameKind::Key) {
+        if (end - p < qint64(count) * 4 * (1 + columns)) {
+            m_valid = false;
+            return false;
+        }
+        m_ids.resize(count);
+        for (int i = 0; i < count; ++i)
+            m_ids[i] = qFromLittleEndian<quint32>(p + i * 4);
+        p += qint64(count) * 4;
+        for (int c = 0; c < columns; ++c) {
+            readResiduals<qint32>(p, cur[c].data(), count);
+            p += qint64(count) * 4;
+            hasMissing = hasMissing || std::find(cur[c].begin(), cur[c].end(), Missing) != cur[c].end();
+        }
+        m_fields = fields;
+        m_havePrev2 = false;
+    } else if (kind == FrameKind::Delta1 || kind == FrameKind::Delta2) {
+        // Deltas only apply on top of the immediately preceding frame.
+        if (!m_valid || sequence != m_sequence + 1 || fields != m_fields || count != m_ids.size()
+            || (kind == FrameKind::Delta2 && !m_havePrev2)) {
+            m_valid = false;
+            return false;
+        }
+        const bool usePrev2 = kind == FrameKind::Delta2;
+        for (int c = 0; c < columns; ++c) {
+            if (p >= end) {
+                m_valid = false;
+                return false;
+            }
+            const int width = *p++;
+            if ((width != 1 && width != 2 && width != 4) || end - p < qint64(count) * width) {
+                m_valid = false;
+                return false;
+            }
+            qint32 *dst = cur[c].data();
+            if (width == 1) {
+                for (int i = 0; i < count; ++i)
+                    dst[i] = qint8(p[i]);
+            } else if (width == 2) {
+                readResiduals<qint16>(p, dst, count);
+            } else {
+                readResiduals<qint32>(p, dst, count);
+            }
+            p += qint64(count) * width;
+
+            const qint32 *p1 = m_prev[c].data();
+            const qint32 *p2 = usePrev2 ? m_prev2[c].data() : p1;
+            const bool w = wraps[c];
+            for (int i = 0; i < count; ++i)
+                dst[i] = reconstruct(predict(p1[i], p2[i], usePrev2, w), dst[i], w);
+        }
+        m_havePrev2 = true;
+    } else {
+        m_valid = false;
+        return false;
+    }
+    m_sequence = sequence;
+    m_valid = !hasMissing;
+    m_prev2 = std::move(m_prev);
+    m_prev = cur;
+
+    // Dequantize straight into the batch columns; no per-object map is built.
+    batch = Batch();
+    batch.ids = m_ids;
+    QVector<double> *targets[7] = {&batch.lat, &batch.lon};
+    int next = 2;
+    if (fields & AltField)
+        targets[next++] = &batch.alt;
+    if (fields & PastField) {
+        targets[next++] = &batch.latPast;
+        targets[next++] = &batch.lonPast;
+    }
+    if (fields & FutureField) {
+        targets[next++] = &batch.latFuture;
+        targets[next++] = &batch.lonFuture;
+    }
+    for (int c = 0; c < columns; ++c) {
+        const double inv = 1.0 / scales[c];
+        const qint32 *src = cur[c].data();
+        targets[c]->resize(count);
+        double *dst = targets[c]->data();
+        for (int i = 0; i < count; ++i)
+            dst[i] = src[i] == Missing ? std::numeric_limits<double>::quiet_NaN() : src[i] * inv;
+    }
+    return true;
+}
+
+} // namespace CompactStates
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QMetaType>
+#include <QVariantList>
+#include <QVector>
+#include <vector>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Compact `m.orbit.*` batch encoding: fixed-point columns, delta-coded against earlier frames of the same stream.
+// All integers little endian.
+//
+//   header (16 bytes): magic[4] "EVQ1", u8 kind, u8 fields, u16 reserved, u32 sequence, u32 count
+//   key frame:   u32 ids[count], then one i32[count] column per field
+//   delta frame: per field, u8 width (1, 2 or 4) followed by width * count bytes of residuals
+//
+// Fields, in column order: Lat, Lon (always), Alt (AltField), LatPast/LonPast (PastField), LatFuture/LonFuture
+// (FutureField). Angles are in units of 1e-5 deg (about 1 m), altitude in metres. Delta frames carry the same objects
+// in the same order as the frame before; residuals are against that frame (Delta1) or against a linear
+// extrapolation of the two frames before (Delta2, small for smooth motion). Longitude columns wrap at +/-180 deg.
+// A decoder that missed a frame drops deltas until the next key frame.
+namespace CompactStates
+{
+inline constexpr char Magic[4] = {'E', 'V', 'Q', '1'};
+inline constexpr int HeaderSize = 16;
+inline constexpr double AngleScale = 1e5;
+inline constexpr double AltitudeScale = 1e3; // km -> m
+
+enum class FrameKind : quint8 {
+    Key = 0,
+    Delta1 = 1,
+    Delta2 = 2,
+};
+
+enum Field : quint8 {
+    AltField = 0x1,
+    PastField = 0x2,
+    FutureField = 0x4,
+};
+
+bool isCompact(QByteArrayView payload);
+
+// Column-wise batch; optional columns are either empty or count() long (NaN marks a missing value).
+struct Batch
+{
+    QVector<quint32> ids;
+    QVector<double> lat, lon, alt, latPast, lonPast, latFuture, lonFuture;
+
+    int count() const { return int(ids.size()); }
+};
+
+// The same objects in the FeedCodec::decodeStates list shape; rows without a position are left out.
+QVariantList toVariantList(const Batch &batch);
+
+class Encoder
+{
+public:
+    // Frames between key frames; a key frame is also sent whenever the object list or field set changes.
+    void setKeyInterval(int frames);
+    QByteArray encode(const Batch &batch);
+
+private:
+    int m_keyInterval {30};
+    int m_sinceKey {0};
+    quint32 m_sequence {0};
+    quint8 m_fields {0};
+    QVector<quint32> m_ids;
+    int m_history {0}; // frames available for prediction since the last key frame (0..2)
+    std::vector<std::vector<qint32>> m_prev, m_prev2;
+};
+
+// Stateful per stream (one per subject); not thread-safe.
+class Decoder
+{
+public:
+    // Returns false for malformed frames and for deltas whose base frame was missed. Rows keep the frame's order;
+    // a position the publisher marked missing is NaN.
+    bool decode(QByteArrayView payload, Batch &batch);
+
+private:
+    bool m_valid {false};
+    quint32 m_sequence {0};
+    quint8 m_fields {0};
+    QVector<quint32> m_ids;
+    std::vector<std::vector<qint32>> m_prev, m_prev2;
+    bool m_havePrev2 {false};
+};
+}
+
+Q_DECLARE_METATYPE(CompactStates::Batch)
@@ -0,0 +1,167 @@
+#include "CompressedTexture.h"
+
+#include <QVarLengthArray>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+namespace
+{
+constexpr char KtxIdentifier[12] = {'\xAB', 'K', 'T', 'X', ' ', '1', '1', '\xBB', '\r', '\n', '\x1A', '\n'};
+constexpr int KtxHeaderSize = 64;
+constexpr quint32 KtxLittleEndian = 0x04030201;
+
+// KTX glInternalFormat values (OpenGL enums) that map to QRhi formats.
+constexpr quint32 GlRgbDxt1 = 0x83F0;
+constexpr quint32 GlRgbaDxt1 = 0x83F1;
+constexpr quint32 GlRgbaDxt3 = 0x83F2;
+constexpr quint32 GlRgbaDxt5 = 0x83F3;
+constexpr quint32 GlRgbaBptc = 0x8E8C;
+constexpr quint32 GlRgb8Etc2 = 0x9274;
+constexpr quint32 GlRgb8A1Etc2 = 0x9276;
+constexpr quint32 GlRgba8Etc2Eac = 0x9278;
+constexpr quint32 GlRgbaAstc4x4 = 0x93B0; // 4x4 to 8x8 follow in QRhi's order
+}
+
+KtxFile::~KtxFile()
+{
+    if (m_mapped)
+        m_file.unmap(const_cast<uchar *>(m_mapped));
+}
+
+bool KtxFile::open(const QString &fileName)
+{
+    m_file.setFileName(fileName);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_error = m_file.errorString();
+        return false;
+    }
+    const qint64 size = m_file.size();
+    const uchar *data = m_file.map(0, size);
+    if (data) {
+        m_mapped = data;
+    } else {
+        m_bytes = m_file.readAll();
+        data = reinterpret_cast<const uchar *>(m_bytes.constData());
+    }
+
+    auto u32 = [data](qint64 offset) { return qFromLittleEndian<quint32>(data + offset); };
+    if (size < KtxHeaderSize || std::memcmp(data, KtxIdentifier, sizeof(KtxIdentifier)) != 0) {
+        m_error = QStringLiteral("Not a KTX 1 file: %1").arg(fileName);
+        return false;
+    }
+    if (u32(12) != KtxLittleEndian) {
+        m_error = QStringLiteral("Big-endian KTX files are not supported: %1").arg(fileName);
+        return false;
+    }
+    // glType 0 marks compressed data; one 2D image: no depth, array elements or cube faces.
+    const quint32 glType = u32(16);
+    const quint32 width = u32(36);
+    const quint32 height = u32(40);
+    if (glType != 0 || width == 0 || height == 0 || u32(44) > 1 || u32(48) > 1 || u32(52) != 1) {
+        m_error = QStringLiteral("KTX file is not a compressed 2D texture: %1").arg(fileName);
+        return false;
+    }
+    m_glInternalFormat = u32(28);
+    m_size = QSize(int(width), int(height));
+
+    const int levels = std::max(1, int(u32(56)));
+    qint64 offset = KtxHeaderSize + qint64(u32(60)); // after the key/value data
+    for (int level = 0; level < levels; ++level) {
+        if (offset + 4 > size)
+            break;
+        const qint64 imageSize = u32(offset);
+        offset += 4;
+        if (offset + imageSize > size)
+            break;
+        m_levels.append(QByteArrayView(reinterpret_cast<const char *>(data + offset), imageSize));
+        offset += (imageSize + 3) & ~qint64(3);
+    }
+    if (m_levels.size() != levels) {
+        m_levels.clear();
+        m_error = QStringLiteral("Truncated KTX file: %1").arg(fileName);
+        return false;
+    }
+    return true;
+}
+
+QRhiTexture::Format CompressedTexture::rhiFormat(quint32 glInternalFormat)
+{
+    switch (glInternalFormat) {
+    case GlRgbDxt1:
+    case GlRgbaDxt1:
+        return QRhiTexture::BC1;
+    case GlRgbaDxt3:
+        return QRhiTexture::BC2;
+    case GlRgbaDxt5:
+        return QRhiTexture::BC3;
+    case GlRgbaBptc:
+        return QRhiTexture::BC7;
+    case GlRgb8Etc2:
+        return QRhiTexture::ETC2_RGB8;
+    case GlRgb8A1Etc2:
+        return QRhiTexture::ETC2_RGB8A1;
+    case GlRgba8Etc2Eac:
+        return QRhiTexture::ETC2_RGBA8;
+    default:
+        break;
+    }
+    static constexpr QRhiTexture::Format Astc[] = {QRhiTexture::ASTC_4x4, QRhiTexture::ASTC_5x4, QRhiTexture::ASTC_5x5,
+                                                   QRhiTexture::ASTC_6x5, QRhiTexture::ASTC_6x6, QRhiTexture::ASTC_8x5,
+                                                   QRhiTexture::ASTC_8x6, QRhiTexture::ASTC_8x8};
+    if (glInternalFormat >= GlRgbaAstc4x4 && glInternalFormat < GlRgbaAstc4x4 + std::size(Astc))
+        return Astc[glInternalFormat - GlRgbaAstc4x4];
+    return QRhiTexture::UnknownFormat;
+}
+
+CompressedTexture *CompressedTexture::create(QRhi *rhi, std::shared_ptr<const KtxFile> file)
+{
+    const QRhiTexture::Format format = rhiFormat(file->glInternalFormat());
+    if (!rhi || format == QRhiTexture::UnknownFormat || !rhi->isTextureFormatSupported(format))
+        return nullptr;
+    const bool hasAlpha = file->glInternalFormat() != GlRgbDxt1 && file->glInternalFormat() != GlRgb8Etc2;
+    const bool mipmapped = file->levelCount() > 1 && file->levelCount() == QRhi::mipLevelsForSize(file->size());
+    // Created here rather than on first use, so a texture the driver rejects is reported to the caller, which can
+    // fall back to another source, instead of surfacing as an invalid texture mid-frame.
+    std::unique_ptr<QRhiTexture> texture(
+        rhi->newTexture(format, file->size(), 1, mipmapped ? QRhiTexture::MipMapped : QRhiTexture::Flags()));
+    if (!texture->create()) {
+        qWarning("CompressedTexture: cannot create a %dx%d texture", file->size().width(), file->size().height());
+        return nullptr;
+    }
+    return new CompressedTexture(std::move(file), texture.release(), hasAlpha, mipmapped);
+}
+
+CompressedTexture::CompressedTexture(std::shared_ptr<const KtxFile> file, QRhiTexture *texture, bool hasAlpha,
+                                     bool mipmapped)
+    : m_file(std::move(file))
+    , m_hasAlpha(hasAlpha)
+    , m_mipmapped(mipmapped)
+    , m_texture(texture)
+{
+}
+
+CompressedTexture::~CompressedTexture()
+{
+    delete m_texture;
+}
+
+void CompressedTexture::commitTextureOperations(QRhi *, QRhiResourceUpdateBatch *resourceUpdates)
+{
+    if (m_uploaded)
+        return;
+    m_uploaded = true;
+    const int levels = m_mipmapped ? m_file->levelCount() : 1;
+    QVarLengthArray<QRhiTextureUploadEntry, 16> entries;
+    for (int level = 0; level < levels; ++level) {
+        const QByteArrayView bytes = m_file->level(level);
+        entries.append(QRhiTextureUploadEntry(0, level, QRhiTextureSubresourceUploadDescription(bytes.data(), quint32(bytes.size()))));
+    }
+    QRhiTextureUploadDescription description;
+    description.setEntries(entries.cbegin(), entries.cend());
+    resourceUpdates->uploadTexture(m_texture, description);
+}
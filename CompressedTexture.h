@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QFile>
+#include <QSGTexture>
+#include <QSize>
+#include <QString>
+#include <QVector>
+#include <memory>
+#include <rhi/qrhi.h>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// A KTX (version 1) texture file: one 2D image with its mip chain, already in a GPU block-compressed format. The
+// file is memory-mapped where possible (compressed resources are read instead); opening reads only the header and
+// the level offsets. Thread-safe once open.
+class KtxFile
+{
+public:
+    ~KtxFile();
+
+    bool open(const QString &fileName);
+    QString errorString() const { return m_error; }
+
+    quint32 glInternalFormat() const { return m_glInternalFormat; }
+    QSize size() const { return m_size; }
+    int levelCount() const { return int(m_levels.size()); }
+    // Compressed bytes of mip level `level` (0: full size).
+    QByteArrayView level(int level) const { return m_levels.value(level); }
+
+private:
+    QFile m_file;
+    const uchar *m_mapped {nullptr};
+    QByteArray m_bytes; // when the file cannot be mapped
+    quint32 m_glInternalFormat {0};
+    QSize m_size;
+    QVector<QByteArrayView> m_levels;
+    QString m_error;
+};
+
+// A KtxFile as a scene graph texture. The RHI texture is created with it; every level is uploaded on first use,
+// through the material's resource update batch, as Qt's own compressed textures are. RHI backends only.
+class CompressedTexture : public QSGTexture
+{
+public:
+    // The QRhi format of a KTX internal format (ETC2, ASTC 4x4 to 8x8 and BC1/2/3/7), UnknownFormat if none.
+    static QRhiTexture::Format rhiFormat(quint32 glInternalFormat);
+    // `file` if its format is usable on `rhi` and the texture could be created, otherwise null.
+    static CompressedTexture *create(QRhi *rhi, std::shared_ptr<const KtxFile> file);
+
+    ~CompressedTexture() override;
+
+    qint64 comparisonKey() const override { return qint64(quintptr(this)); }
+    QRhiTexture *rhiTexture() const override { return m_texture; }
+    QSize textureSize() const override { return m_file->size(); }
+    bool hasAlphaChannel() const override { return m_hasAlpha; }
+    bool hasMipmaps() const override { return m_mipmapped; }
+    void commitTextureOperations(QRhi *rhi, QRhiResourceUpdateBatch *resourceUpdates) override;
+
+private:
+    CompressedTexture(std::shared_ptr<const KtxFile> file, QRhiTexture *texture, bool hasAlpha, bool mipmapped);
+
+    std::shared_ptr<const KtxFile> m_file;
+    bool m_hasAlpha;
+    bool m_mipmapped; // the file has the full mip chain; otherwise only level 0 is used
+    QRhiTexture *m_texture; // owned
+    bool m_uploaded {false};
+};
@@ -0,0 +1,104 @@
+#include "DeclutterGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+bool DeclutterGrid::configure(const QRectF &rect, int cellSize, int threshold)
+{
+    cellSize = std::max(cellSize, 0);
+    threshold = std::max(threshold, 1);
+    if (rect == m_rect && cellSize == m_cellSize && threshold == m_threshold)
+        return false;
+    m_rect = rect;
+    m_cellSize = cellSize;
+    m_threshold = threshold;
+    m_columns = cellSize ? std::max(1, int(std::ceil(rect.width() / cellSize))) : 0;
+    m_rows = cellSize ? std::max(1, int(std::ceil(rect.height() / cellSize))) : 0;
+    m_cells.fill(Cell(), qsizetype(m_columns) * m_rows);
+    m_cellOf.fill(-1);
+    m_changed = true;
+    return true;
+}
+
+void DeclutterGrid::resize(int slotCount)
+{
+    for (int slot = slotCount; slot < m_cellOf.size(); ++slot)
+        remove(slot);
+    m_cellOf.resize(slotCount, -1);
+    m_position.resize(2 * qsizetype(slotCount));
+}
+
+qint32 DeclutterGrid::cellAt(float x, float y) const
+{
+    const int column = std::clamp(int((x - m_rect.x()) / m_cellSize), 0, m_columns - 1);
+    const int row = std::clamp(int((y - m_rect.y()) / m_cellSize), 0, m_rows - 1);
+    return qint32(row) * m_columns + column;
+}
+
+void DeclutterGrid::add(qint32 cell, float x, float y, int sign)
+{
+    Cell &c = m_cells[cell];
+    const bool wasCluster = c.count >= m_threshold;
+    c.count += sign;
+    if (c.count) {
+        c.sumX += sign * double(x);
+        c.sumY += sign * double(y);
+    } else {
+        c = Cell(); // no rounding left behind in an empty cell
+    }
+    if (wasCluster || c.count >= m_threshold)
+        m_changed = true;
+}
+
+void DeclutterGrid::place(int slot, float x, float y)
+{
+    if (!m_cellSize)
+        return;
+    if (!std::isfinite(x) || !std::isfinite(y)) {
+        remove(slot);
+        return;
+    }
+    float *position = m_position.data() + 2 * slot;
+    const qint32 old = m_cellOf[slot];
+    if (old >= 0 && position[0] == x && position[1] == y)
+        return;
+    const qint32 cell = cellAt(x, y);
+    if (old >= 0)
+        add(old, position[0], position[1], -1);
+    add(cell, x, y, 1);
+    m_cellOf[slot] = cell;
+    position[0] = x;
+    position[1] = y;
+}
+
+void DeclutterGrid::remove(int slot)
+{
+    const qint32 old = m_cellOf[slot];
+    if (old < 0)
+        return;
+    add(old, m_position[2 * slot], m_position[2 * slot + 1], -1);
+    m_cellOf[slot] = -1;
+}
+
+bool DeclutterGrid::takeChanged()
+{
+    const bool changed = m_changed;
+    m_changed = false;
+    return changed;
+}
+
+int DeclutterGrid::clusters(QVector<Cluster> &out) const
+{
+    out.clear();
+    int objects = 0;
+    for (const Cell &c : m_cells) {
+        if (c.count < m_threshold)
+            continue;
+        out.append({float(c.sumX / c.count), float(c.sumY / c.count), c.count});
+        objects += c.count;
+    }
+    return objects;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QRectF>
+#include <QVector>
+#include <QtGlobal>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Screen-space grid of object counts for decluttering dense layers. Objects are placed by stable slot, and each
+// frame only the slots that moved update their old and new cells, so the grid is kept in step with position updates
+// instead of being rebuilt. A cell holding at least `threshold` objects is a cluster: its objects are drawn as one
+// marker at their centroid, sized by count, so the marker count is bounded by the cell count.
+class DeclutterGrid
+{
+public:
+    struct Cluster
+    {
+        float x;
+        float y;
+        int count;
+    };
+
+    // A new rect, cell size or threshold empties the grid; returns true if it did. cellSize 0 disables clustering.
+    bool configure(const QRectF &rect, int cellSize, int threshold);
+    bool isEnabled() const { return m_cellSize > 0; }
+    // Slot range; slots past a shrunk range are removed.
+    void resize(int slotCount);
+
+    // Moves `slot` to (x, y) in item pixels, or takes it off the grid.
+    void place(int slot, float x, float y);
+    void remove(int slot);
+
+    bool isClustered(int slot) const
+    {
+        const qint32 cell = m_cellOf[slot];
+        return cell >= 0 && m_cells[cell].count >= m_threshold;
+    }
+    // Whether any cluster appeared, went or changed since the last call.
+    bool takeChanged();
+    // Current clusters, in cell order; returns the number of objects they hold.
+    int clusters(QVector<Cluster> &out) const;
+
+private:
+    struct Cell
+    {
+        int count {0};
+        double sumX {0.0};
+        double sumY {0.0};
+    };
+
+    qint32 cellAt(float x, float y) const;
+    void add(qint32 cell, float x, float y, int sign);
+
+    QRectF m_rect;
+    int m_cellSize {0};
+    int m_threshold {1};
+    int m_columns {0};
+    int m_rows {0};
+    QVector<Cell> m_cells;
+    QVector<qint32> m_cellOf;  // per slot, -1 off the grid
+    QVector<float> m_position; // per slot, as counted in its cell
+    bool m_changed {true};
+};
@@ -0,0 +1,221 @@
+#include "DotBufferNode.h"
+
+#include <QFile>
+#include <QMatrix4x4>
+#include <QQuickWindow>
+#include <algorithm>
+#include <rhi/qrhi.h>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+namespace
+{
+// Dirty slots at most this far apart are uploaded as one range: fewer, slightly larger copies.
+constexpr int MergeGapSlots = 8;
+
+// std140 layout of the shaders' uniform block.
+constexpr int MatrixOffset = 0;
+constexpr int ColorOffset = 64;
+constexpr int UniformSize = 80;
+
+QShader loadShader(const QString &fileName)
+{
+    QFile file(fileName);
+    return file.open(QIODevice::ReadOnly) ? QShader::fromSerialized(file.readAll()) : QShader();
+}
+}
+
+DotBufferNode::DotBufferNode(QQuickWindow *window)
+    : m_window(window)
+{
+}
+
+DotBufferNode::~DotBufferNode() = default;
+
+void DotBufferNode::resize(int slots, int verticesPerSlot)
+{
+    m_slots = std::max(slots, 0);
+    m_verticesPerSlot = std::max(verticesPerSlot, 0);
+    m_vertices.assign(qsizetype(m_slots) * m_verticesPerSlot, QSGGeometry::Point2D {0.0f, 0.0f});
+    m_dirty.clear();
+    m_uploadAll = true;
+}
+
+QSGGeometry::Point2D *DotBufferNode::writeSlot(int slot)
+{
+    Q_ASSERT(slot >= 0 && slot < m_slots);
+    if (!m_uploadAll) {
+        if (!m_dirty.isEmpty() && slot >= m_dirty.last().first && slot <= m_dirty.last().second + MergeGapSlots)
+            m_dirty.last().second = std::max(m_dirty.last().second, slot + 1);
+        else
+            m_dirty.append({slot, slot + 1});
+    }
+    return m_vertices.data() + qsizetype(slot) * m_verticesPerSlot;
+}
+
+qint64 DotBufferNode::pendingBytes() const
+{
+    if (m_uploadAll)
+        return capacityBytes();
+    qint64 slots = 0;
+    for (const auto &range : m_dirty)
+        slots += range.second - range.first;
+    return slots * m_verticesPerSlot * qint64(sizeof(QSGGeometry::Point2D));
+}
+
+int DotBufferNode::pendingRanges() const
+{
+    if (m_uploadAll)
+        return m_slots ? 1 : 0;
+    return int(m_dirty.size());
+}
+
+bool DotBufferNode::ensurePipelines(QRhi *rhi)
+{
+    QRhiRenderPassDescriptor *renderPass = renderTarget()->renderPassDescriptor();
+    if (m_pipeline && m_renderPass == renderPass)
+        return true;
+    m_pipeline.reset();
+    m_stencilPipeline.reset();
+    m_renderPass = renderPass;
+
+    const QShader vertexShader = loadShader(QStringLiteral(":/EarthView/shaders/dots.vert.qsb"));
+    const QShader fragmentShader = loadShader(QStringLiteral(":/EarthView/shaders/dots.frag.qsb"));
+    QRhiVertexInputLayout inputLayout;
+    inputLayout.setBindings({{quint32(sizeof(QSGGeometry::Point2D))}});
+    inputLayout.setAttributes({{0, 0, QRhiVertexInputAttribute::Float2, 0}});
+    QRhiGraphicsPipeline::TargetBlend blend; // premultiplied alpha
+    blend.enable = true;
+    blend.srcColor = QRhiGraphicsPipeline::One;
+    blend.dstColor = QRhiGraphicsPipeline::OneMinusSrcAlpha;
+    blend.srcAlpha = QRhiGraphicsPipeline::One;
+    blend.dstAlpha = QRhiGraphicsPipeline::OneMinusSrcAlpha;
+
+    for (bool stencil : {false, true}) {
+        std::unique_ptr<QRhiGraphicsPipeline> pipeline(rhi->newGraphicsPipeline());
+        pipeline->setTopology(QRhiGraphicsPipeline::Triangles);
+        pipeline->setTargetBlends({blend});
+        pipeline->setSampleCount(renderTarget()->sampleCount());
+        pipeline->setShaderStages({{QRhiShaderStage::Vertex, vertexShader}, {QRhiShaderStage::Fragment, fragmentShader}});
+        pipeline->setVertexInputLayout(inputLayout);
+        pipeline->setShaderResourceBindings(m_bindings.get());
+        pipeline->setRenderPassDescriptor(renderPass);
+        QRhiGraphicsPipeline::Flags flags = QRhiGraphicsPipeline::UsesScissor;
+        if (stencil) {
+            // Pass where the clip wrote the reference value; leave the stencil buffer as it is.
+            QRhiGraphicsPipeline::StencilOpState op;
+            op.compareOp = QRhiGraphicsPipeline::Equal;
+            pipeline->setStencilTest(true);
+            pipeline->setStencilFront(op);
+            pipeline->setStencilBack(op);
+            pipeline->setStencilWriteMask(0);
+            flags |= QRhiGraphicsPipeline::UsesStencilRef;
+        }
+        pipeline->setFlags(flags);
+        if (!pipeline->create()) {
+            qWarning("DotBufferNode: cannot create the dot pipeline");
+            m_pipeline.reset();
+            return false;
+        }
+        (stencil ? m_stencilPipeline : m_pipeline) = std::move(pipeline);
+    }
+    return true;
+}
+
+void DotBufferNode::prepare()
+{
+    QRhi *rhi = m_window ? m_window->rhi() : nullptr;
+    QRhiCommandBuffer *cb = commandBuffer();
+    if (!rhi || !cb || m_vertices.isEmpty())
+        return;
+
+    QRhiResourceUpdateBatch *updates = rhi->nextResourceUpdateBatch();
+    const quint32 bytes = quint32(capacityBytes());
+    if (!m_buffer || m_buffer->size() < bytes) {
+        m_buffer.reset(rhi->newBuffer(QRhiBuffer::Static, QRhiBuffer::VertexBuffer, bytes));
+        if (!m_buffer->create()) {
+            qWarning("DotBufferNode: cannot create a %u byte vertex buffer", bytes);
+            m_buffer.reset();
+            updates->release();
+            return;
+        }
+        m_uploadAll = true;
+    }
+    if (m_uploadAll) {
+        updates->uploadStaticBuffer(m_buffer.get(), 0, bytes, m_vertices.constData());
+    } else {
+        const quint32 slotBytes = quint32(m_verticesPerSlot * sizeof(QSGGeometry::Point2D));
+        for (const auto &range : std::as_const(m_dirty)) {
+            const int end = std::min(range.second, m_slots);
+            if (end > range.first)
+                updates->uploadStaticBuffer(m_buffer.get(), quint32(range.first) * slotBytes,
+                                            quint32(end - range.first) * slotBytes,
+                                            m_vertices.constData() + qsizetype(range.first) * m_verticesPerSlot);
+        }
+    }
+    m_dirty.clear();
+    m_uploadAll = false;
+
+    if (!m_uniforms) {
+        m_uniforms.reset(rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer, UniformSize));
+        m_uniforms->create();
+        m_bindings.reset(rhi->newShaderResourceBindings());
+        m_bindings->setBindings({QRhiShaderResourceBinding::uniformBuffer(
+            0, QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage, m_uniforms.get())});
+        m_bindings->create();
+    }
+    const QMatrix4x4 mvp = *projectionMatrix() * *matrix();
+    const float a = float(m_color.alphaF() * inheritedOpacity());
+    const float color[4] = {float(m_color.redF()) * a, float(m_color.greenF()) * a, float(m_color.blueF()) * a, a};
+    updates->updateDynamicBuffer(m_uniforms.get(), MatrixOffset, 64, mvp.constData());
+    updates->updateDynamicBuffer(m_uniforms.get(), ColorOffset, sizeof color, color);
+    cb->resourceUpdate(updates);
+
+    ensurePipelines(rhi);
+}
+
+void DotBufferNode::render(const RenderState *state)
+{
+    QRhiCommandBuffer *cb = commandBuffer();
+    const bool stencil = state->stencilEnabled();
+    QRhiGraphicsPipeline *pipeline = stencil ? m_stencilPipeline.get() : m_pipeline.get();
+    if (!cb || !pipeline || !m_buffer || m_vertices.isEmpty())
+        return;
+
+    cb->setGraphicsPipeline(pipeline);
+    const QSize size = renderTarget()->pixelSize();
+    cb->setViewport(QRhiViewport(0, 0, size.width(), size.height()));
+    // Both rects are in framebuffer pixels with a bottom-left origin, as QRhiScissor expects.
+    const QRect scissor = state->scissorEnabled() ? state->scissorRect() : QRect(QPoint(0, 0), size);
+    cb->setScissor(QRhiScissor(scissor.x(), scissor.y(), scissor.width(), scissor.height()));
+    if (stencil)
+        cb->setStencilRef(quint32(state->stencilValue()));
+    cb->setShaderResources();
+    const QRhiCommandBuffer::VertexInput input(m_buffer.get(), 0);
+    cb->setVertexInput(0, 1, &input);
+    cb->draw(quint32(m_vertices.size()));
+}
+
+void DotBufferNode::releaseResources()
+{
+    m_pipeline.reset();
+    m_stencilPipeline.reset();
+    m_bindings.reset();
+    m_uniforms.reset();
+    m_buffer.reset();
+    m_renderPass = nullptr;
+    m_uploadAll = true;
+}
+
+QSGRenderNode::StateFlags DotBufferNode::changedStates() const
+{
+    return ViewportState | ScissorState;
+}
+
+QSGRenderNode::RenderingFlags DotBufferNode::flags() const
+{
+    // Drawn through QRhi only. Not depth aware: the pipelines skip the depth test, so the renderer keeps the node in
+    // paint order.
+    return NoExternalRendering;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QColor>
+#include <QPair>
+#include <QSGGeometry>
+#include <QSGRenderNode>
+#include <QVector>
+#include <memory>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+class QQuickWindow;
+class QRhi;
+class QRhiBuffer;
+class QRhiGraphicsPipeline;
+class QRhiRenderPassDescriptor;
+class QRhiShaderResourceBindings;
+
+// Dots of stable slots (SatelliteStore::slot) in one static RHI vertex buffer, a fixed run of triangles per slot.
+// Slots written since the last frame are uploaded as sub-ranges, runs a few slots apart merged into one, so upload
+// volume follows the number of objects that moved rather than the batch or a chunk. Flat premultiplied colour times
+// the inherited opacity; honours the scene graph's scissor and stencil clips. Draws nothing without an RHI (the
+// software backend skips the other geometry layers too).
+class DotBufferNode : public QSGRenderNode
+{
+public:
+    explicit DotBufferNode(QQuickWindow *window);
+    ~DotBufferNode() override;
+
+    void setColor(const QColor &color) { m_color = color; }
+    QColor color() const { return m_color; }
+
+    // Reallocates for `slots` slots, all empty (zero-area); the whole buffer is uploaded with the next frame.
+    void resize(int slots, int verticesPerSlot);
+    int slotCount() const { return m_slots; }
+    int verticesPerSlot() const { return m_verticesPerSlot; }
+    // The vertices of `slot` to rewrite, scheduled for upload. Ranges merge best in ascending slot order.
+    QSGGeometry::Point2D *writeSlot(int slot);
+
+    qint64 capacityBytes() const { return qint64(m_vertices.size()) * qint64(sizeof(QSGGeometry::Point2D)); }
+    // Scheduled for the next frame: bytes and upload ranges.
+    qint64 pendingBytes() const;
+    int pendingRanges() const;
+
+    void prepare() override;
+    void render(const RenderState *state) override;
+    void releaseResources() override;
+    StateFlags changedStates() const override;
+    RenderingFlags flags() const override;
+
+private:
+    bool ensurePipelines(QRhi *rhi);
+
+    QQuickWindow *m_window;
+    QColor m_color;
+    int m_slots {0};
+    int m_verticesPerSlot {0};
+    QVector<QSGGeometry::Point2D> m_vertices; // CPU copy, the source of every upload
+    QVector<QPair<int, int>> m_dirty;         // slot ranges [first, end)
+    bool m_uploadAll {true};
+
+    std::unique_ptr<QRhiBuffer> m_buffer;
+    std::unique_ptr<QRhiBuffer> m_uniforms;
+    std::unique_ptr<QRhiShaderResourceBindings> m_bindings;
+    std::unique_ptr<QRhiGraphicsPipeline> m_pipeline;        // scissor clip
+    std::unique_ptr<QRhiGraphicsPipeline> m_stencilPipeline; // stencil clip (a rotated view)
+    QRhiRenderPassDescriptor *m_renderPass {nullptr};        // the pipelines were built for
+};
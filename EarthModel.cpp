@@ -0,0 +1,240 @@
+#include "EarthModel.h"
+#include "CompressedTexture.h"
+#include "LatencyHistogram.h"
+
+#include <QLoggingCategory>
+#include <QMetaObject>
+#include <QMutexLocker>
+#include <QQuickWindow>
+#include <QSGTexture>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+namespace
+{
+Q_LOGGING_CATEGORY(lcBackground, "earthview.background")
+
+// Station list generations are unique across models, so a view that switches models never mistakes one list for
+// another in its render caches.
+std::atomic<quint64> g_groundStationGeneration {0};
+}
+
+EarthModel::EarthModel(QObject *parent)
+    : QObject(parent)
+    , m_groundStationGeneration(++g_groundStationGeneration)
+{
+}
+
+EarthModel::~EarthModel()
+{
+    if (m_backgroundThread.joinable())
+        m_backgroundThread.join();
+}
+
+QVariantList EarthModel::groundStations() const
+{
+    if (!m_groundStationsVariantValid) {
+        m_groundStations.clear();
+        m_groundStations.reserve(m_groundStationData.size());
+        for (const auto &gs : m_groundStationData)
+            m_groundStations.append(gs.toVariantMap());
+        m_groundStationsVariantValid = true;
+    }
+    return m_groundStations;
+}
+
+void EarthModel::setGroundStations(const QVariantList &stations)
+{
+    GroundStationList data;
+    data.reserve(stations.size());
+    for (const auto &v : stations)
+        data.append(GroundStation::fromVariantMap(v.toMap()));
+    setGroundStationData(std::move(data));
+
+    // Keep the caller's list as-is for the property getter.
+    m_groundStations = stations;
+    m_groundStationsVariantValid = true;
+}
+
+void EarthModel::setGroundStationData(GroundStationList stations)
+{
+    stations.removeIf([](const GroundStation &gs) { return !gs.isValid(); });
+    m_groundStationData = std::move(stations);
+    m_groundStationGeneration = ++g_groundStationGeneration;
+    m_footprintBounds.clear();
+    m_footprintBounds.reserve(m_groundStationData.size());
+    for (const GroundStation &gs : std::as_const(m_groundStationData)) {
+        FootprintBounds b {gs.lat, gs.lat, gs.lon, 0.0};
+        double west = 0.0;
+        double east = 0.0;
+        for (const GeoPoint &p : gs.mask) {
+            b.south = std::min(b.south, p.lat);
+            b.north = std::max(b.north, p.lat);
+            const double d = std::remainder(p.lon - gs.lon, 360.0);
+            west = std::min(west, d);
+            east = std::max(east, d);
+        }
+        b.lonCentre = gs.lon + (west + east) / 2;
+        b.lonHalfSpan = (east - west) / 2; // about 180 for a mask around a pole
+        m_footprintBounds.append(b);
+    }
+    m_groundStations.clear();
+    m_groundStationsVariantValid = false;
+
+    emit groundStationsChanged();
+}
+
+void EarthModel::setSatellites(const QVariantList &sats)
+{
+    setSatellites(sats, 0);
+}
+
+void EarthModel::setSatellites(const QVariantList &sats, qint64 originNs)
+{
+    beginBatch(originNs);
+    m_satellites = sats;
+    m_satellitesVariantValid = true;
+    m_satelliteData.assign(sats);
+    endBatch();
+}
+
+void EarthModel::setSatelliteStates(const CompactStates::Batch &states, qint64 originNs)
+{
+    beginBatch(originNs);
+    m_satellites.clear();
+    m_satellitesVariantValid = false;
+    m_satelliteData.assign(states);
+    endBatch();
+}
+
+QVariantList EarthModel::satellites() const
+{
+    if (!m_satellitesVariantValid) {
+        m_satellites = m_satelliteData.toVariantList();
+        m_satellitesVariantValid = true;
+    }
+    return m_satellites;
+}
+
+void EarthModel::beginBatch(qint64 originNs)
+{
+    const qint64 setNs = LatencyHistogram::nowNs();
+    m_batchOriginNs = originNs > 0 ? originNs : setNs;
+    m_batchSetNs = setNs;
+}
+
+void EarthModel::endBatch()
+{
+    m_batchApplyNs = LatencyHistogram::nowNs() - m_batchSetNs;
+    emit satellitesChanged();
+}
+
+void EarthModel::setActiveContacts(const QVariantList &contacts)
+{
+    m_activeContacts = contacts;
+    emit activeContactsChanged();
+}
+
+void EarthModel::setCompressedBackgrounds(const QStringList &fileNames)
+{
+    if (m_compressedBackgroundFiles == fileNames)
+        return;
+    m_compressedBackgroundFiles = fileNames;
+    m_compressedBackgrounds.clear();
+    for (const QString &fileName : fileNames) {
+        auto file = std::make_shared<KtxFile>();
+        if (file->open(fileName))
+            m_compressedBackgrounds.append(std::move(file));
+        else
+            qCWarning(lcBackground).noquote() << "Compressed background not loaded:" << file->errorString();
+    }
+    m_textures.clear(); // textures in use stay alive until their views let go
+    emit backgroundChanged();
+}
+
+void EarthModel::loadBackground()
+{
+    if (m_backgroundThread.joinable() || !m_backgroundImage.isNull() || m_backgroundFailed)
+        return;
+    // Decoding the PNG takes a noticeable part of startup on phones and WASM, so it happens off the GUI thread where
+    // there is one; views draw without a background until it arrives. Single-threaded builds (Qt for WebAssembly's
+    // default), where std::thread throws, decode it in place.
+#if QT_CONFIG(thread)
+    m_backgroundThread = std::thread([this]() { decodeBackground(); });
+#else
+    {
+        QMutexLocker locker(&m_backgroundMutex);
+        if (!m_decodedBackground.isNull())
+            return; // decoded, adopted with the next event loop pass
+    }
+    decodeBackground();
+#endif
+}
+
+void EarthModel::decodeBackground()
+{
+    // The resource is bundled by the QML module under /EarthView/.
+    const QString fileName = QStringLiteral(":/EarthView/assets/earth/earth-landmask-2048.png");
+    QImage image(fileName);
+    if (image.isNull()) {
+        qCWarning(lcBackground).noquote() << "Background image not decoded:" << fileName;
+        m_backgroundFailed = true;
+        return;
+    }
+    image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    {
+        QMutexLocker locker(&m_backgroundMutex);
+        m_decodedBackground = std::move(image);
+    }
+    QMetaObject::invokeMethod(this, [this]() { adoptBackground(); }, Qt::QueuedConnection);
+}
+
+void EarthModel::waitForBackground()
+{
+    loadBackground();
+    if (m_backgroundThread.joinable())
+        m_backgroundThread.join();
+    adoptBackground();
+}
+
+void EarthModel::adoptBackground()
+{
+    QMutexLocker locker(&m_backgroundMutex);
+    if (m_decodedBackground.isNull())
+        return;
+    m_backgroundImage = std::exchange(m_decodedBackground, QImage());
+    locker.unlock();
+    emit backgroundChanged();
+}
+
+QSharedPointer<QSGTexture> EarthModel::backgroundTexture(QQuickWindow *window)
+{
+    auto it = m_textures.find(window);
+    if (it != m_textures.end()) {
+        if (it->window == window) {
+            if (QSharedPointer<QSGTexture> texture = it->texture.toStrongRef())
+                return texture;
+        }
+        m_textures.erase(it);
+    }
+
+    // The first compressed background the GPU can sample, with its own mip chain; else the PNG, mipmapped on upload.
+    QSGTexture *texture = nullptr;
+    for (const auto &file : std::as_const(m_compressedBackgrounds)) {
+        texture = CompressedTexture::create(window->rhi(), file);
+        if (texture)
+            break;
+    }
+    if (!texture && !m_backgroundImage.isNull())
+        texture = window->createTextureFromImage(m_backgroundImage, QQuickWindow::TextureHasMipmaps);
+    if (!texture)
+        return {};
+    // Deleted on the render thread it belongs to, whichever thread drops the last reference.
+    QSharedPointer<QSGTexture> shared(texture, &QObject::deleteLater);
+    m_textures.insert(window, {window, shared});
+    return shared;
+}
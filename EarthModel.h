@@ -0,0 +1,138 @@
+#pragma once
+
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QObject>
+#include <QPointer>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QVariantList>
+#include <QVector>
+#include <QWeakPointer>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include <QtQml/qqmlregistration.h>
+
+#include "GeoTypes.h"
+#include "SatelliteStore.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+class KtxFile;
+class QQuickWindow;
+class QSGTexture;
+
+// The data EarthViews draw, parsed and indexed once for any number of views: satellite batches (SatelliteStore),
+// ground stations with their footprint bounds, active contacts and the background image. Views attach through
+// EarthView.model and keep only their own projection, render caches and scene graph; a view without one uses a
+// private model. Background textures are shared by the views of a window and released with the last of them.
+// GUI thread, except that views read it in updatePaintNode while the GUI thread is blocked.
+class EarthModel : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+public:
+    Q_PROPERTY(QVariantList groundStations READ groundStations WRITE setGroundStations NOTIFY groundStationsChanged)
+    Q_PROPERTY(QVariantList satellites READ satellites WRITE setSatellites NOTIFY satellitesChanged)
+    Q_PROPERTY(QVariantList activeContacts READ activeContacts WRITE setActiveContacts NOTIFY activeContactsChanged)
+    // See EarthView.compressedBackgrounds.
+    Q_PROPERTY(QStringList compressedBackgrounds READ compressedBackgrounds WRITE setCompressedBackgrounds NOTIFY
+                   backgroundChanged)
+
+    explicit EarthModel(QObject *parent = nullptr);
+    ~EarthModel() override;
+
+    QVariantList groundStations() const;
+    void setGroundStations(const QVariantList &stations);
+    // Typed input path for feeds; avoids the QVariant round trip. Pass by move.
+    void setGroundStationData(GroundStationList stations);
+    const GroundStationList &groundStationData() const { return m_groundStationData; }
+    // New for every station list, unique across models.
+    quint64 groundStationGeneration() const { return m_groundStationGeneration; }
+
+    // Per station: the mask's latitudes and its longitude extent about the station, to cull footprints unprojected.
+    struct FootprintBounds
+    {
+        double south;
+        double north;
+        double lonCentre;
+        double lonHalfSpan;
+    };
+    const QVector<FootprintBounds> &footprintBounds() const { return m_footprintBounds; }
+
+    QVariantList satellites() const;
+    void setSatellites(const QVariantList &sats);
+    // As above, with the batch's origin time (LatencyHistogram::nowNs clock) for end-to-end latency.
+    void setSatellites(const QVariantList &sats, qint64 originNs);
+    // Typed input path for feeds that produce columns: no QVariantMap per object; the list for the property is built
+    // only if it is read.
+    void setSatelliteStates(const CompactStates::Batch &states, qint64 originNs);
+    const SatelliteStore &satelliteData() const { return m_satelliteData; }
+    // The last batch: origin and arrival stamps, and how long parsing it took.
+    qint64 batchOriginNs() const { return m_batchOriginNs; }
+    qint64 batchSetNs() const { return m_batchSetNs; }
+    qint64 batchApplyNs() const { return m_batchApplyNs; }
+
+    QVariantList activeContacts() const { return m_activeContacts; }
+    void setActiveContacts(const QVariantList &contacts);
+
+    QStringList compressedBackgrounds() const { return m_compressedBackgroundFiles; }
+    void setCompressedBackgrounds(const QStringList &fileNames);
+
+    // Starts decoding the bundled PNG on a worker thread, once; backgroundChanged follows when it is ready. A decode
+    // failure is logged and views draw without the PNG from then on.
+    void loadBackground();
+    // Blocks until the PNG is decoded.
+    void waitForBackground();
+    // The background texture for `window`: the first compressed background the GPU supports, else the PNG (null
+    // until decoded). Created on first use and shared until the last holder drops it. Render thread, during sync.
+    QSharedPointer<QSGTexture> backgroundTexture(QQuickWindow *window);
+
+signals:
+    void groundStationsChanged();
+    void satellitesChanged();
+    void activeContactsChanged();
+    // The background image arrived or its sources changed; views pick up a new texture.
+    void backgroundChanged();
+
+private:
+    // Decodes the PNG into m_decodedBackground and queues adoptBackground(); on the background thread if there is one.
+    void decodeBackground();
+    void adoptBackground();
+    void beginBatch(qint64 originNs);
+    void endBatch();
+
+    mutable QVariantList m_satellites; // materialised from m_satelliteData on first read after a column batch
+    mutable bool m_satellitesVariantValid {true};
+    SatelliteStore m_satelliteData;
+    qint64 m_batchOriginNs {0};
+    qint64 m_batchSetNs {0};
+    qint64 m_batchApplyNs {0};
+
+    GroundStationList m_groundStationData;
+    mutable QVariantList m_groundStations; // materialised from m_groundStationData on first read
+    mutable bool m_groundStationsVariantValid {true};
+    quint64 m_groundStationGeneration {0};
+    QVector<FootprintBounds> m_footprintBounds;
+
+    QVariantList m_activeContacts;
+
+    QImage m_backgroundImage;
+    std::thread m_backgroundThread; // decodes the PNG once
+    QMutex m_backgroundMutex;
+    QImage m_decodedBackground; // guarded by m_backgroundMutex until adopted as m_backgroundImage
+    std::atomic<bool> m_backgroundFailed {false}; // the PNG did not decode; not retried
+    QStringList m_compressedBackgroundFiles;
+    QVector<std::shared_ptr<const KtxFile>> m_compressedBackgrounds; // opened; formats are checked per window
+    struct WindowTexture
+    {
+        QPointer<QQuickWindow> window; // guards against a new window at a freed address
+        QWeakPointer<QSGTexture> texture;
+    };
+    QHash<QQuickWindow *, WindowTexture> m_textures;
+};
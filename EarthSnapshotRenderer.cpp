@@ -0,0 +1,60 @@
+#include "EarthSnapshotRenderer.h"
+
+#include <QQuickItem>
+#include <QQuickWindow>
+#include <QSGRendererInterface>
+
+#include "EarthView.h"
+#include "OffscreenRenderer.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+EarthSnapshotRenderer::EarthSnapshotRenderer()
+    : m_renderer(std::make_unique<OffscreenRenderer>())
+{
+    m_view = new EarthView(m_renderer->window()->contentItem());
+    m_view->waitForBackground();
+    if (QQuickWindow::graphicsApi() == QSGRendererInterface::Software)
+        m_initError = QStringLiteral("Snapshot rendering needs an RHI backend; the software scene graph skips the layers");
+}
+
+EarthSnapshotRenderer::~EarthSnapshotRenderer() = default;
+
+bool EarthSnapshotRenderer::isValid() const
+{
+    return m_initError.isEmpty();
+}
+
+QImage EarthSnapshotRenderer::render(const Snapshot &snapshot, const Options &options)
+{
+    m_lastError.clear();
+    if (!isValid())
+        return {};
+    if (options.size.isEmpty()) {
+        m_lastError = QStringLiteral("Empty snapshot size");
+        return {};
+    }
+    if (!m_renderer->setSize(options.size)) {
+        m_lastError = m_renderer->errorString();
+        return {};
+    }
+
+    m_renderer->window()->setColor(options.background);
+    m_view->setSize(options.size);
+    m_view->setFitWorld(options.fitWorld);
+    m_view->setRotatePortrait(options.rotatePortrait);
+    m_view->setAccentColor(options.accentColor);
+    m_view->setCenterLongitude(options.centerLongitude);
+    m_view->setCenterLatitude(options.centerLatitude);
+    m_view->setZoom(options.zoom);
+    m_view->setSatellites(snapshot.satellites);
+    m_view->setGroundStationData(snapshot.groundStations);
+    m_view->setActiveContacts(snapshot.activeContacts);
+
+    if (!m_renderer->renderFrame(true)) {
+        m_lastError = m_renderer->errorString();
+        return {};
+    }
+    return m_renderer->image();
+}
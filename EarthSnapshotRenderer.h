@@ -0,0 +1,63 @@
+#pragma once
+
+#include <QColor>
+#include <QImage>
+#include <QSize>
+#include <QString>
+#include <QVariantList>
+#include <memory>
+
+#include "GeoTypes.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+class EarthView;
+class OffscreenRenderer;
+
+// Renders EarthView layers for a data snapshot into a QImage without an on-screen window, e.g. for report or chat
+// images on a headless server. One renderer keeps its render control, scene graph, background texture and geometry
+// nodes across calls, so consecutive snapshots only pay for the geometry rebuild and rasterisation.
+//
+// Renders through an RHI backend (see OffscreenRenderer; Mesa llvmpipe is enough on a server without a GPU), so the
+// overlay layers are drawn as on screen. GUI thread only.
+class EarthSnapshotRenderer
+{
+public:
+    // Inputs as for the EarthView properties of the same names.
+    struct Snapshot
+    {
+        QVariantList satellites;
+        GroundStationList groundStations;
+        QVariantList activeContacts;
+    };
+
+    struct Options
+    {
+        QSize size {1280, 640};
+        double centerLongitude {0.0};
+        double centerLatitude {0.0};
+        double zoom {1.0};
+        bool rotatePortrait {false};
+        bool fitWorld {true};
+        QColor accentColor {QColor(90, 210, 255)};
+        QColor background {Qt::black}; // outside the map rectangle
+    };
+
+    EarthSnapshotRenderer();
+    ~EarthSnapshotRenderer();
+
+    // False if the render control could not be initialised (see errorString()). A failed render() doesn't change it.
+    bool isValid() const;
+    // Why the renderer is invalid, else why the last render() failed (empty after a successful one).
+    QString errorString() const { return m_initError.isEmpty() ? m_lastError : m_initError; }
+
+    // Returns a null image on failure, else premultiplied RGBA read back from the GPU.
+    QImage render(const Snapshot &snapshot, const Options &options);
+
+private:
+    std::unique_ptr<OffscreenRenderer> m_renderer;
+    EarthView *m_view {nullptr};
+    QString m_initError;
+    QString m_lastError;
+};
@@ -1,4 +1,11 @@
 #include "EarthView.h"
+#include "BackgroundMaterial.h"
+#include "CompactLineMaterial.h"
+#include "EarthModel.h"
+#include "Projection.h"
+#include "SatelliteLayerNode.h"
+#include "TileLayerNode.h"
+#include "VertexArena.h"
 
 #include <QQuickWindow>
 #include <QSGSimpleTextureNode>
@@ -6,10 +13,18 @@
 #include <QVariantMap>
 #include <QSGGeometryNode>
 #include <QSGFlatColorMaterial>
+#include <QSGTextureMaterial>
+#include <QSGRendererInterface>
 #include <QHoverEvent>
 #include <QMouseEvent>
 #include <QTouchEvent>
+#include <QTimerEvent>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QMetaObject>
 #include <QHash>
+#include <QStringList>
+#include <array>
 #include <cmath>
 #include <algorithm>
 
@@ -23,8 +38,66 @@ EarthView::EarthView(QQuickItem *parent)
     setAcceptHoverEvents(true);
     setAcceptedMouseButtons(Qt::AllButtons);
     setAcceptTouchEvents(false);
-    // The resource is bundled by the QML module under /EarthView/.
-    m_backgroundImage = QImage(QStringLiteral(":/EarthView/assets/earth/earth-landmask-2048.png"));
+    m_ownModel = new EarthModel(this);
+    connectModel();
+}
+
+void EarthView::componentComplete()
+{
+    QQuickItem::componentComplete();
+    activeModel()->loadBackground(); // as early as the model is known
+}
+
+void EarthView::setModel(EarthModel *model)
+{
+    if (m_sharedModel == model)
+        return;
+    disconnect(activeModel(), nullptr, this, nullptr);
+    m_sharedModel = model;
+    connectModel();
+    if (isComponentComplete())
+        activeModel()->loadBackground();
+    m_textureStale = true;
+    emit modelChanged();
+    // Everything read through the view comes from the new model now.
+    emit satellitesChanged();
+    emit groundStationsChanged();
+    emit activeContactsChanged();
+    emit compressedBackgroundsChanged();
+    update();
+}
+
+void EarthView::connectModel()
+{
+    EarthModel *model = activeModel();
+    connect(model, &EarthModel::satellitesChanged, this, &EarthView::onModelSatellitesChanged);
+    connect(model, &EarthModel::groundStationsChanged, this, [this]() {
+        emit groundStationsChanged();
+        update();
+    });
+    connect(model, &EarthModel::activeContactsChanged, this, [this]() {
+        emit activeContactsChanged();
+        update();
+    });
+    connect(model, &EarthModel::backgroundChanged, this, [this]() {
+        m_textureStale = true;
+        emit compressedBackgroundsChanged();
+        update();
+    });
+    if (model != m_ownModel) {
+        // Back to the private model if the shared one goes away; m_sharedModel is already null by then.
+        connect(model, &QObject::destroyed, this, [this]() {
+            connectModel();
+            m_textureStale = true;
+            emit modelChanged();
+            update();
+        });
+    }
+}
+
+void EarthView::waitForBackground()
+{
+    activeModel()->waitForBackground();
 }
 
 void EarthView::ensureTexture()
@@ -33,17 +106,15 @@ void EarthView::ensureTexture()
         return;
     }
 
-    if (m_lastWindow != window()) {
-        // Window changed; drop the old texture to avoid using it with another scene graph.
-        if (m_texture) {
-            m_texture->deleteLater();
-        }
-        m_texture = nullptr;
+    if (m_lastWindow != window() || m_textureStale) {
+        // Window or background changed; let go of the old texture (deleted with its last holder).
+        m_texture.reset();
         m_lastWindow = window();
+        m_textureStale = false;
     }
-
-    if (!m_texture && !m_backgroundImage.isNull()) {
-        m_texture = window()->createTextureFromImage(m_backgroundImage);
+    if (!m_texture) {
+        activeModel()->loadBackground();
+        m_texture = activeModel()->backgroundTexture(window()); // null until the PNG is decoded
     }
 }
 
@@ -64,6 +135,30 @@ void EarthView::setCenterLongitude(double lon)
     update();
 }
 
+void EarthView::setZoom(double zoom)
+{
+    if (!std::isfinite(zoom))
+        return;
+    zoom = std::clamp(zoom, 1.0, MaxZoom);
+    if (zoom == m_zoom)
+        return;
+    m_zoom = zoom;
+    emit zoomChanged();
+    update();
+}
+
+void EarthView::setCenterLatitude(double lat)
+{
+    if (!std::isfinite(lat))
+        return;
+    lat = std::clamp(lat, -90.0, 90.0);
+    if (lat == m_centerLatitude)
+        return;
+    m_centerLatitude = lat;
+    emit centerLatitudeChanged();
+    update();
+}
+
 void EarthView::setFitWorld(bool fit)
 {
     if (m_fitWorld == fit) {
@@ -95,179 +190,174 @@ void EarthView::setAccentColor(const QColor &color)
     update();
 }
 
+void EarthView::setCompactVertices(bool compact)
+{
+    if (m_compactVertices == compact)
+        return;
+    m_compactVertices = compact;
+    emit compactVerticesChanged();
+    update();
+}
+
+void EarthView::setDeclutterLevel(int level)
+{
+    level = std::clamp(level, 0, MaxDeclutterLevel);
+    if (m_declutterLevel == level)
+        return;
+    m_declutterLevel = level;
+    emit declutterLevelChanged();
+    update();
+}
+
+void EarthView::setBackgroundTint(const QColor &color)
+{
+    if (!color.isValid() || m_backgroundTint == color)
+        return;
+    m_backgroundTint = color;
+    emit backgroundTintChanged();
+    update();
+}
+
+void EarthView::setBackgroundSaturation(double saturation)
+{
+    if (!std::isfinite(saturation))
+        return;
+    saturation = std::clamp(saturation, 0.0, 1.0);
+    if (m_backgroundSaturation == saturation)
+        return;
+    m_backgroundSaturation = saturation;
+    emit backgroundSaturationChanged();
+    update();
+}
+
+void EarthView::setBackgroundBrightness(double brightness)
+{
+    if (!std::isfinite(brightness))
+        return;
+    brightness = std::clamp(brightness, 0.0, 1.0);
+    if (m_backgroundBrightness == brightness)
+        return;
+    m_backgroundBrightness = brightness;
+    emit backgroundBrightnessChanged();
+    update();
+}
+
+void EarthView::setVertexMemoryLimit(qint64 bytes)
+{
+    bytes = std::max<qint64>(bytes, 0);
+    if (m_vertexMemoryLimit == bytes)
+        return;
+    m_vertexMemoryLimit = bytes;
+    emit vertexMemoryLimitChanged();
+    update();
+}
+
+QVariantList EarthView::groundStations() const
+{
+    return activeModel()->groundStations();
+}
+
 void EarthView::setGroundStations(const QVariantList &stations)
 {
-    m_groundStations = stations;
-    m_groundStationData.clear();
-
-    auto readField = [](const QVariantMap &m, const std::initializer_list<const char *> &keys, double &out) -> bool {
-        for (const char *k : keys) {
-            bool ok = false;
-            double val = m.value(QString::fromLatin1(k)).toDouble(&ok);
-            if (ok && std::isfinite(val)) {
-                out = val;
-                return true;
-            }
-        }
-        return false;
-    };
+    activeModel()->setGroundStations(stations);
+}
 
-    auto parsePoint = [&](const QVariant &v, GeoPoint &out) -> bool {
-        if (v.canConvert<QVariantMap>()) {
-            const QVariantMap m = v.toMap();
-            double lat = 0.0;
-            double lon = 0.0;
-            if (readField(m, {"lat", "Lat"}, lat) && readField(m, {"lon", "Lon"}, lon)) {
-                out.lat = lat;
-                out.lon = lon;
-                return true;
-            }
-        }
-        if (v.canConvert<QVariantList>()) {
-            const QVariantList arr = v.toList();
-            if (arr.size() >= 2) {
-                bool okLat = false;
-                bool okLon = false;
-                const double lat = arr.at(0).toDouble(&okLat);
-                const double lon = arr.at(1).toDouble(&okLon);
-                if (okLat && okLon && std::isfinite(lat) && std::isfinite(lon)) {
-                    out.lat = lat;
-                    out.lon = lon;
-                    return true;
-                }
-            }
-        }
-        return false;
-    };
+void EarthView::setGroundStationData(GroundStationList stations)
+{
+    activeModel()->setGroundStationData(std::move(stations));
+}
 
-    auto parseMask = [&](const QVariant &v) -> QVector<GeoPoint> {
-        QVector<GeoPoint> pts;
-        if (!v.isValid())
-            return pts;
-        const QVariantList list = v.toList();
-        pts.reserve(list.size());
-        for (const QVariant &pVar : list) {
-            GeoPoint p;
-            if (parsePoint(pVar, p))
-                pts.append(p);
-        }
-        return pts;
-    };
+namespace
+{
+constexpr int LatencyWindowMs = 5000;
 
-    for (const auto &v : stations) {
-        const QVariantMap m = v.toMap();
-        double lat = 0.0;
-        double lon = 0.0;
-        double radiusKm = std::numeric_limits<double>::quiet_NaN();
-        const bool latOk = readField(m, {"lat", "Lat"}, lat);
-        const bool lonOk = readField(m, {"lon", "Lon"}, lon);
-        readField(m, {"radius_km", "RadiusKm", "radiusKm", "radius", "Radius"}, radiusKm);
-        QVector<GeoPoint> mask = parseMask(m.value(QStringLiteral("mask")));
-        if (mask.isEmpty())
-            mask = parseMask(m.value(QStringLiteral("boundary")));
-        if (mask.isEmpty())
-            mask = parseMask(m.value(QStringLiteral("footprint")));
-        if (mask.isEmpty())
-            mask = parseMask(m.value(QStringLiteral("points")));
-
-        if ((!latOk || !lonOk) && !mask.isEmpty()) {
-            double sumLat = 0.0;
-            double sumLon = 0.0;
-            for (const auto &p : mask) {
-                sumLat += p.lat;
-                sumLon += p.lon;
-            }
-            lat = sumLat / mask.size();
-            lon = sumLon / mask.size();
-        }
+Q_LOGGING_CATEGORY(lcRender, "earthview.render", QtWarningMsg)
+Q_LOGGING_CATEGORY(lcTiles, "earthview.tiles")
 
-        if (!std::isfinite(lat) || !std::isfinite(lon))
-            continue;
-        if (lat < -90.0 || lat > 90.0)
-            continue;
-        GroundStation gs;
-        gs.lat = lat;
-        gs.lon = lon;
-        gs.mask = mask;
-        if (std::isfinite(radiusKm))
-            gs.radiusKm = radiusKm;
-        const QVariant idVar = m.value(QStringLiteral("id"), m.value(QStringLiteral("ID")));
-        if (idVar.isValid())
-            gs.id = idVar.toString();
-        gs.raw = m;
-        if (!gs.id.isEmpty())
-            gs.raw.insert(QStringLiteral("ID"), gs.id);
-        gs.raw.insert(QStringLiteral("Lat"), gs.lat);
-        gs.raw.insert(QStringLiteral("Lon"), gs.lon);
-        if (std::isfinite(gs.radiusKm))
-            gs.raw.insert(QStringLiteral("RadiusKm"), gs.radiusKm);
-        if (!gs.mask.isEmpty()) {
-            QVariantList maskVar;
-            maskVar.reserve(gs.mask.size());
-            for (const auto &p : gs.mask) {
-                QVariantMap point;
-                point.insert(QStringLiteral("Lat"), p.lat);
-                point.insert(QStringLiteral("Lon"), p.lon);
-                maskVar.append(point);
-            }
-            gs.raw.insert(QStringLiteral("Mask"), maskVar);
-        }
-        m_groundStationData.push_back(gs);
+const char *const RenderPhaseNames[] = {"nodeLookup", "texture", "footprints", "groundStations", "contacts", "tracks", "satellites", "upload"};
+const char *const RenderLayerNames[] = {"footprints", "groundStations", "contacts", "pastTracks", "futureTracks", "satellites"};
+
+static_assert(sizeof(GeoPoint) == 2 * sizeof(double), "GeoPoint arrays are projected as interleaved lat/lon");
+
+// Projects a point list into (x, y) pairs in `xy`.
+void projectPoints(const Projection::Mapping &mapping, const QVector<GeoPoint> &points, QVector<float> &xy)
+{
+    xy.resize(points.size() * 2);
+    if (!points.isEmpty())
+        Projection::projectWrapped(mapping, &points.constData()->lat, &points.constData()->lon, points.size(), 2, xy.data());
+}
+}
+
+void EarthView::setBackgroundTiles(const QString &fileName)
+{
+    if (m_backgroundTiles == fileName)
+        return;
+    m_backgroundTiles = fileName;
+    m_tileLoader.reset();
+    if (!fileName.isEmpty()) {
+        // Each decoded tile schedules a frame to upload it.
+        auto loader = std::make_unique<TileLoader>(
+            [this]() { QMetaObject::invokeMethod(this, [this]() { update(); }, Qt::QueuedConnection); });
+        if (loader->open(fileName))
+            m_tileLoader = std::move(loader);
+        else
+            qCWarning(lcTiles).noquote() << "Background tiles not loaded:" << loader->errorString();
     }
+    ++m_tilesGeneration;
+    emit backgroundTilesChanged();
+    update();
+}
 
-    emit groundStationsChanged();
+void EarthView::setCompressedBackgrounds(const QStringList &fileNames)
+{
+    activeModel()->setCompressedBackgrounds(fileNames);
+}
+
+void EarthView::setTileCacheSize(int tiles)
+{
+    tiles = std::max(tiles, 1);
+    if (m_tileCacheSize == tiles)
+        return;
+    m_tileCacheSize = tiles;
+    emit tileCacheSizeChanged();
     update();
 }
 
 void EarthView::setSatellites(const QVariantList &sats)
 {
-    m_satellites = sats;
-    m_satelliteData.clear();
-
-    auto readField = [](const QVariantMap &m, const char *key, double &out) -> bool {
-        const QVariant v = m.value(QString::fromLatin1(key));
-        bool ok = false;
-        double val = v.toDouble(&ok);
-        if (ok && std::isfinite(val)) {
-            out = val;
-            return true;
-        }
-        return false;
-    };
+    setSatellites(sats, 0);
+}
 
-    for (const auto &v : sats) {
-        QVariantMap m = v.toMap();
-        const QVariant idField = m.value(QStringLiteral("ID"), m.value(QStringLiteral("id")));
-        const double lat = m.value(QStringLiteral("Lat")).toDouble();
-        const double lon = m.value(QStringLiteral("Lon")).toDouble();
-        if (!std::isfinite(lat) || !std::isfinite(lon))
-            continue;
-        if (lat < -90.0 || lat > 90.0)
-            continue;
-        Satellite s;
-        s.lat = lat;
-        s.lon = lon;
-        readField(m, "LatPast", s.latPast);
-        readField(m, "LonPast", s.lonPast);
-        readField(m, "LatFuture", s.latFuture);
-        readField(m, "LonFuture", s.lonFuture);
-        if (idField.isValid())
-            s.id = idField.toString();
-        s.raw = m;
-        if (idField.isValid())
-            s.raw.insert(QStringLiteral("ID"), idField);
-        m_satelliteData.push_back(s);
-    }
+void EarthView::setSatellites(const QVariantList &sats, qint64 originNs)
+{
+    activeModel()->setSatellites(sats, originNs);
+}
+
+void EarthView::setSatelliteStates(const CompactStates::Batch &states, qint64 originNs)
+{
+    activeModel()->setSatelliteStates(states, originNs);
+}
 
+// Every view of a shared model times the batch to its own first frame.
+void EarthView::onModelSatellitesChanged()
+{
+    const EarthModel *model = activeModel();
+    if (m_batchPending)
+        ++m_droppedBatches; // the previous batch never reached the screen
+    m_batchOriginNs = model->batchOriginNs();
+    m_batchSetNs = model->batchSetNs();
+    m_batchPending = true;
+    if (!m_latencyTimer.isActive())
+        m_latencyTimer.start(LatencyWindowMs, this);
+
+    m_applyLatency.record(model->batchApplyNs());
     emit satellitesChanged();
     update();
 }
 
 void EarthView::setActiveContacts(const QVariantList &contacts)
 {
-    m_activeContacts = contacts;
-    emit activeContactsChanged();
-    update();
+    activeModel()->setActiveContacts(contacts);
 }
 
 QRectF EarthView::viewRect(bool &rotated) const
@@ -300,9 +390,42 @@ QRectF EarthView::viewRect(bool &rotated) const
     return rect;
 }
 
+// The whole map at the current zoom, placed so that (centerLongitude, centerLatitude) is at the centre of `view`.
+QRectF EarthView::mapRect(const QRectF &view) const
+{
+    const qreal w = view.width() * m_zoom;
+    const qreal h = view.height() * m_zoom;
+    const double limit = 90.0 - 90.0 / m_zoom; // half the visible latitude span from either pole
+    const double lat = std::clamp(m_centerLatitude, -limit, limit);
+    const QPointF c = view.center();
+    return QRectF(c.x() - w / 2, c.y() - (90.0 - lat) / 180.0 * h, w, h);
+}
+
 QSGNode *EarthView::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
 {
+    // Cheap per-phase timing: one monotonic read per phase boundary. Layers fill their vertex arenas directly; upload
+    // covers padding the unused tail and marking the geometry dirty.
+    QElapsedTimer frameTimer;
+    frameTimer.start();
+    RenderStats stats;
+    stats.frame = m_renderStats.frame + 1;
+    qint64 phaseStart = 0;
+    auto endPhase = [&](RenderPhase phase) {
+        const qint64 now = frameTimer.nsecsElapsed();
+        stats.phaseNs[phase] += now - phaseStart;
+        phaseStart = now;
+    };
+    auto recordLayer = [&](RenderLayer layer, const QSGGeometry *geom, int used, bool reduced, bool uploaded = true) {
+        stats.vertices[layer] = used;
+        stats.bytes[layer] = qint64(geom->vertexCount()) * geom->sizeOfVertex(); // arena capacity
+        stats.reduced[layer] = reduced;
+        if (uploaded)
+            stats.uploadBytes += stats.bytes[layer];
+    };
+
+    const EarthModel &model = *activeModel();
     ensureTexture();
+    endPhase(TexturePhase);
 
     // Root -> transform -> clip -> content nodes
     QSGNode *root = oldNode;
@@ -310,11 +433,11 @@ QSGNode *EarthView::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
     QSGClipNode *clipNode = nullptr;
     QSGNode *contentRoot = nullptr;
     QVector<QSGSimpleTextureNode *> textureNodes;
+    QSGGeometryNode *backgroundNode = nullptr;
     QSGGeometryNode *gsFootNode = nullptr;
     QSGGeometryNode *gsDotNode = nullptr;
-    QSGGeometryNode *satNode = nullptr;
-    QSGGeometryNode *satPastNode = nullptr;
-    QSGGeometryNode *satFutureNode = nullptr;
+    SatelliteLayerNode *satLayer = nullptr;
+    TileLayerNode *tileLayer = nullptr;
     QSGGeometryNode *contactNode = nullptr;
 
     if (!root) {
@@ -344,15 +467,16 @@ QSGNode *EarthView::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
         }
     }
 
-    if (m_texture) {
+    const QRectF bounds = boundingRect();
+    if (!bounds.isEmpty()) {
         const QColor satPastColor = QColor(180, 200, 220, 140);
         const QColor satFutureColor = QColor(m_accentColor.red(), m_accentColor.green(), m_accentColor.blue(), 220);
         const QColor satColor = QColor(satPastColor.red(), satPastColor.green(), satPastColor.blue(), 240); // dots match past-track hue
         const QColor gsColor = QColor(m_accentColor.red(), m_accentColor.green(), m_accentColor.blue(), 235);
         const QColor contactColor = QColor(m_accentColor.red(), m_accentColor.green(), m_accentColor.blue(), 255);
         bool doRotate = false;
-        const QRectF bounds = boundingRect();
-        const QRectF rect = viewRect(doRotate);
+        const QRectF rect = viewRect(doRotate); // visible map area, the clip
+        const QRectF world = mapRect(rect);       // the whole map at the current zoom
 
         // Set/update transform for optional portrait rotation
         if (!transformNode) {
@@ -391,7 +515,23 @@ QSGNode *EarthView::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
                 textureNodes.append(tex);
                 continue;
             }
+            if (auto *layer = dynamic_cast<SatelliteLayerNode *>(child)) {
+                satLayer = layer;
+                continue;
+            }
+            if (auto *layer = dynamic_cast<TileLayerNode *>(child)) {
+                tileLayer = layer;
+                continue;
+            }
             if (auto *geom = dynamic_cast<QSGGeometryNode *>(child)) {
+                if (!backgroundNode && dynamic_cast<BackgroundMaterial *>(geom->material())) {
+                    backgroundNode = geom;
+                    continue;
+                }
+                if (!gsFootNode && dynamic_cast<CompactLineMaterial *>(geom->material())) {
+                    gsFootNode = geom; // the only compact node at this level
+                    continue;
+                }
                 if (auto *mat = dynamic_cast<QSGFlatColorMaterial *>(geom->material())) {
                     const QColor c = mat->color();
                     const auto mode = geom->geometry() ? geom->geometry()->drawingMode() : QSGGeometry::DrawLines;
@@ -403,18 +543,6 @@ QSGNode *EarthView::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
                         gsDotNode = geom;
                         continue;
                     }
-                    if (!satNode && c == satColor) {
-                        satNode = geom;
-                        continue;
-                    }
-                    if (!satPastNode && c == satPastColor) {
-                        satPastNode = geom;
-                        continue;
-                    }
-                    if (!satFutureNode && c == satFutureColor) {
-                        satFutureNode = geom;
-                        continue;
-                    }
                     if (!contactNode && c == contactColor && mode == QSGGeometry::DrawTriangles) {
                         contactNode = geom;
                         continue;
@@ -422,54 +550,132 @@ QSGNode *EarthView::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
                 }
             }
         }
+        endPhase(NodeLookupPhase);
 
         // Offset in [0, width)
-        qreal offset = std::fmod((m_centerLongitude / 360.0) * rect.width(), rect.width());
+        qreal offset = std::fmod((m_centerLongitude / 360.0) * world.width(), world.width());
         if (offset < 0)
-            offset += rect.width();
-        const qreal baseX = rect.x() - offset;
-
-        // Ensure two texture nodes
-        while (textureNodes.size() < 2) {
+            offset += world.width();
+        const qreal baseX = world.x() - offset;
+
+        // The background comes first in the content tree, and is absent while it is still decoding. RHI backends draw
+        // it as one quad with a horizontally repeating texture, so a pan only changes the material's texture offset;
+        // the software backend draws two texture node copies.
+        const bool rhiBackend = QSGRendererInterface::isApiRhiBased(window()->rendererInterface()->graphicsApi());
+        const int copies = m_texture && !rhiBackend ? 2 : 0;
+        while (textureNodes.size() < copies) {
             auto *n = new QSGSimpleTextureNode();
             n->setOwnsTexture(false);
-            contentRoot->appendChildNode(n);
+            if (textureNodes.isEmpty())
+                contentRoot->prependChildNode(n);
+            else
+                contentRoot->insertChildNodeAfter(n, textureNodes.last());
             textureNodes.append(n);
         }
-        while (textureNodes.size() > 2) {
+        while (textureNodes.size() > copies) {
             QSGSimpleTextureNode *extra = textureNodes.takeLast();
             contentRoot->removeChildNode(extra);
             delete extra;
         }
         for (int i = 0; i < textureNodes.size(); ++i) {
             QSGSimpleTextureNode *n = textureNodes[i];
-            n->setTexture(m_texture);
-            const qreal x = baseX + i * rect.width();
-            n->setRect(QRectF(x, rect.y(), rect.width(), rect.height()));
+            if (n->texture() != m_texture.get()) {
+                n->setTexture(m_texture.get());
+                // The node has no mipmap setter; its materials do, and they apply it to the texture.
+                const QSGTexture::Filtering mipmap = m_texture->hasMipmaps() ? QSGTexture::Linear : QSGTexture::None;
+                static_cast<QSGOpaqueTextureMaterial *>(n->material())->setMipmapFiltering(mipmap);
+                static_cast<QSGOpaqueTextureMaterial *>(n->opaqueMaterial())->setMipmapFiltering(mipmap);
+            }
+            const QRectF copy(baseX + i * world.width(), world.y(), world.width(), world.height());
+            n->setRect(copy.intersects(rect) ? copy : QRectF()); // zoomed in, one copy is usually out of view
+        }
+        QSGNode *backgroundLast = textureNodes.isEmpty() ? nullptr : textureNodes.last();
+        if (m_texture && rhiBackend) {
+            if (!backgroundNode) {
+                backgroundNode = new QSGGeometryNode();
+                auto *geom = new QSGGeometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), 4);
+                geom->setDrawingMode(QSGGeometry::DrawTriangleStrip);
+                backgroundNode->setGeometry(geom);
+                backgroundNode->setFlag(QSGNode::OwnsGeometry);
+                backgroundNode->setMaterial(new BackgroundMaterial());
+                backgroundNode->setFlag(QSGNode::OwnsMaterial);
+                contentRoot->prependChildNode(backgroundNode);
+                m_backgroundQuad = QRectF();
+            }
+            // The visible part of the map, with map-fraction texture coordinates; only a resize, zoom or centre
+            // latitude moves it.
+            const QRectF quad = rect.intersected(world);
+            if (quad != m_backgroundQuad) {
+                const QRectF uv((quad.x() - world.x()) / world.width(), (quad.y() - world.y()) / world.height(),
+                                quad.width() / world.width(), quad.height() / world.height());
+                QSGGeometry::updateTexturedRectGeometry(backgroundNode->geometry(), quad, uv);
+                backgroundNode->markDirty(QSGNode::DirtyGeometry);
+                m_backgroundQuad = quad;
+            }
+            auto *mat = static_cast<BackgroundMaterial *>(backgroundNode->material());
+            const float uOffset = float(m_centerLongitude / 360.0);
+            if (mat->texture() != m_texture.get() || mat->uOffset() != uOffset || mat->tint() != m_backgroundTint
+                || mat->saturation() != float(m_backgroundSaturation) || mat->brightness() != float(m_backgroundBrightness)) {
+                mat->setTexture(m_texture.get());
+                mat->setUOffset(uOffset);
+                mat->setTint(m_backgroundTint);
+                mat->setSaturation(float(m_backgroundSaturation));
+                mat->setBrightness(float(m_backgroundBrightness));
+                backgroundNode->markDirty(QSGNode::DirtyMaterial);
+            }
+            backgroundLast = backgroundNode;
+        } else if (backgroundNode) {
+            contentRoot->removeChildNode(backgroundNode);
+            delete backgroundNode;
+            backgroundNode = nullptr;
         }
 
+        // Pyramid tiles over the base texture, which stays as the fallback for tiles not loaded yet.
+        if (m_tileLoader) {
+            if (!tileLayer) {
+                tileLayer = new TileLayerNode();
+                if (backgroundLast)
+                    contentRoot->insertChildNodeAfter(tileLayer, backgroundLast);
+                else
+                    contentRoot->prependChildNode(tileLayer);
+            }
+            TileLayerNode::Stats tileStats;
+            const bool morePending = tileLayer->update(window(), m_tileLoader.get(), m_tilesGeneration, world, baseX, rect,
+                                                       window()->effectiveDevicePixelRatio(), m_tileCacheSize, tileStats);
+            if (morePending)
+                QMetaObject::invokeMethod(this, [this]() { update(); }, Qt::QueuedConnection);
+            stats.tileLevel = tileStats.level;
+            stats.tilesVisible = tileStats.visible;
+            stats.tilesPending = tileStats.pending;
+            stats.tileTextures = tileStats.textures;
+        } else if (tileLayer) {
+            contentRoot->removeChildNode(tileLayer);
+            delete tileLayer; // frees its textures
+            tileLayer = nullptr;
+        }
+        endPhase(TexturePhase);
+
         // Terminator removed for now.
 
+        // Layers write straight into their geometry's vertex arena. Over the per-layer vertex limit they drop detail
+        // first (fewer dot segments, thinned tracks and footprints) and objects last. Objects outside the view are
+        // skipped before projection where they are tested one by one (stations, footprints) and before tessellation
+        // where a batch is projected anyway (satellites, tracks, contacts).
+        const Projection::Mapping mapping = Projection::Mapping::forView(world, m_centerLongitude);
         auto projectWrapped = [&](double latDeg, double lonDeg) -> QPointF {
-            qreal x = rect.x() + ((lonDeg + 180.0) / 360.0) * rect.width();
-            qreal y = rect.y() + ((90.0 - latDeg) / 180.0) * rect.height();
-            qreal localOffset = (m_centerLongitude / 360.0) * rect.width();
-            x -= localOffset;
-            while (x < rect.x()) x += rect.width();
-            while (x > rect.x() + rect.width()) x -= rect.width();
-            return QPointF(x, y);
-        };
-
-        auto projectUnwrapped = [&](double latDeg, double lonDeg) -> QPointF {
-            qreal x = rect.x() + ((lonDeg + 180.0) / 360.0) * rect.width();
-            qreal y = rect.y() + ((90.0 - latDeg) / 180.0) * rect.height();
-            qreal localOffset = (m_centerLongitude / 360.0) * rect.width();
-            x -= localOffset;
-            return QPointF(x, y);
+            return Projection::projectWrapped(mapping, latDeg, lonDeg);
         };
+        const int vertexLimit = VertexArena::vertexLimit(m_vertexMemoryLimit);
+        // Line layers in 16-bit map units; the custom material needs an RHI backend, and the units must resolve the
+        // map at this zoom (else the layers switch to float vertices until zoomed out again).
+        const bool compact = m_compactVertices && QSGRendererInterface::isApiRhiBased(window()->rendererInterface()->graphicsApi())
+            && CompactPoint2D::resolves(world.size(), window()->effectiveDevicePixelRatio());
+        const qreal w = world.width();
+        QVector<float> &projected = m_projectScratch;
+        QVector<float> &centres = m_centreScratch;
 
         // Ground station footprints
-        if (m_groundStationData.isEmpty()) {
+        if (model.groundStationData().isEmpty()) {
             if (gsFootNode) {
                 contentRoot->removeChildNode(gsFootNode);
                 delete gsFootNode;
@@ -481,21 +687,31 @@ QSGNode *EarthView::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
                 gsDotNode = nullptr;
             }
         } else {
-            // Footprint node (recreated each frame to avoid stale geometry)
-            // Footprint node (reuse like satellite geometry)
+            // Footprint node (reuse like satellite geometry); a node of the other vertex layout is replaced
+            if (gsFootNode && (dynamic_cast<CompactLineMaterial *>(gsFootNode->material()) != nullptr) != compact) {
+                contentRoot->removeChildNode(gsFootNode);
+                delete gsFootNode;
+                gsFootNode = nullptr;
+            }
             if (!gsFootNode) {
                 gsFootNode = new QSGGeometryNode();
-                auto *gsFootGeom = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+                auto *gsFootGeom = new QSGGeometry(compact ? CompactPoint2D::attributes() : QSGGeometry::defaultAttributes_Point2D(), 0);
                 gsFootGeom->setDrawingMode(QSGGeometry::DrawLines);
                 //gsFootGeom->setLineWidth(1.5f); // allow minimal line width
                 gsFootNode->setGeometry(gsFootGeom);
                 gsFootNode->setFlag(QSGNode::OwnsGeometry);
 
-                auto *gsFootMat = new QSGFlatColorMaterial();
-                gsFootMat->setColor(gsColor); // distinct outline
-                gsFootNode->setMaterial(gsFootMat);
+                if (compact) {
+                    gsFootGeom->setVertexDataPattern(QSGGeometry::DynamicPattern);
+                    gsFootNode->setMaterial(new CompactLineMaterial());
+                } else {
+                    auto *gsFootMat = new QSGFlatColorMaterial();
+                    gsFootMat->setColor(gsColor); // distinct outline
+                    gsFootNode->setMaterial(gsFootMat);
+                }
                 gsFootNode->setFlag(QSGNode::OwnsMaterial);
                 contentRoot->appendChildNode(gsFootNode);
+                m_footprintGeneration = 0;
             }
             if (!gsDotNode) {
                 gsDotNode = new QSGGeometryNode();
@@ -511,460 +727,340 @@ QSGNode *EarthView::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
                 contentRoot->appendChildNode(gsDotNode);
             }
 
-            const int footSegments = 36;
             const int dotSegments = 10;
             const qreal dotPxRadius = 4.0;
 
-            auto appendFan = [&](const QVector<QPointF> &ring, QVector<QPointF> &dest) {
-                if (ring.size() < 3)
-                    return;
-                const qreal w = rect.width();
-
-                qreal minX = std::numeric_limits<qreal>::max();
-                qreal maxX = -std::numeric_limits<qreal>::max();
-                QPointF centroid(0, 0);
-                for (const QPointF &p : ring) {
-                    centroid += p;
-                    minX = std::min(minX, p.x());
-                    maxX = std::max(maxX, p.x());
-                }
-                centroid /= ring.size();
-
-                const int shiftMin = static_cast<int>(std::floor((rect.x() - maxX) / w)) - 1;
-                const int shiftMax = static_cast<int>(std::ceil((rect.x() + w - minX) / w)) + 1;
-
-                for (int k = shiftMin; k <= shiftMax; ++k) {
-                    const qreal shift = k * w;
-                    QPointF shiftedCentroid = centroid + QPointF(shift, 0);
-                    if (shiftedCentroid.x() + w < rect.x() || shiftedCentroid.x() - w > rect.x() + w)
-                        continue;
-                    for (int i = 0; i < ring.size(); ++i) {
-                        const QPointF a = ring[i] + QPointF(shift, 0);
-                        const QPointF b = ring[(i + 1) % ring.size()] + QPointF(shift, 0);
-                        dest.append(shiftedCentroid);
-                        dest.append(a);
-                        dest.append(b);
-                    }
-                }
-            };
-
-            // Footprints: polyline per station (mask only), seam-aware
+            // Footprints: closed polyline per station (mask only), seam-aware. Compact footprints are in map units and
+            // rewritten only for new stations, a new centre or a new limit; a resize or zoom only updates the material,
+            // so they are not culled. Float footprints skip stations whose mask bounds miss the view.
             {
-                QVector<QPointF> segments;
-                const qreal w = rect.width();
-
-                auto addSegment = [&](QPointF a, QPointF b) {
-                    qreal dx = b.x() - a.x();
-                    if (dx > w / 2)
-                        b.rx() -= w;
-                    else if (dx < -w / 2)
-                        b.rx() += w;
-                    if (std::abs(b.x() - a.x()) > w)
-                        return;
-                    segments.append(a);
-                    segments.append(b);
-                };
-
-                for (const auto &gs : m_groundStationData) {
-                    if (gs.mask.isEmpty())
-                        continue;
-
-                    QVector<QPointF> ring;
-                    ring.reserve(gs.mask.size());
-                    for (const auto &p : gs.mask)
-                        ring.append(projectWrapped(p.lat, p.lon));
-
-                    if (ring.size() < 2)
-                        continue;
-
-                    ring.append(ring.first());
-
-                    for (int i = 1; i < ring.size(); ++i)
-                        addSegment(ring[i - 1], ring[i]);
+                if (auto *mat = dynamic_cast<CompactLineMaterial *>(gsFootNode->material());
+                    mat && (mat->color() != gsColor || mat->mapRect() != world)) {
+                    mat->setColor(gsColor);
+                    mat->setMapRect(world);
+                    gsFootNode->markDirty(QSGNode::DirtyMaterial);
                 }
-
+                const Projection::GeoWindow footWindow = Projection::GeoWindow::forView(mapping, rect, 1.0);
+                auto ringVisible = [&](qsizetype i) {
+                    const EarthModel::FootprintBounds &b = model.footprintBounds()[i];
+                    return model.groundStationData()[i].mask.size() >= 2
+                        && (compact || footWindow.intersects(b.south, b.north, b.lonCentre, b.lonHalfSpan));
+                };
                 QSGGeometry *geom = gsFootNode->geometry();
-                geom->setDrawingMode(QSGGeometry::DrawLines);
-                geom->allocate(segments.size());
-                QSGGeometry::Point2D *v = geom->vertexDataAsPoint2D();
-                for (int i = 0; i < segments.size(); ++i) {
-                    v[i].set(segments[i].x(), segments[i].y());
+                const bool unchanged = compact && m_footprintGeneration == model.groundStationGeneration()
+                    && m_footprintCenterLongitude == m_centerLongitude && m_footprintVertexLimit == vertexLimit;
+                if (!unchanged) {
+                    qint64 points = 0;
+                    int rings = 0;
+                    for (qsizetype i = 0; i < model.groundStationData().size(); ++i) {
+                        if (ringVisible(i)) {
+                            points += model.groundStationData()[i].mask.size();
+                            ++rings;
+                        }
+                    }
+                    const int step = VertexArena::lodStride(2 * points, vertexLimit);
+                    const int cap = int(std::min<qint64>(2 * (points / step + rings), vertexLimit));
+                    const Projection::Mapping footMapping = compact ? compactMapping(m_centerLongitude) : mapping;
+                    const QRectF footVisible = compact ? QRectF() : rect;
+                    auto writeRings = [&](auto *v) {
+                        int idx = 0;
+                        for (qsizetype i = 0; i < model.groundStationData().size(); ++i) {
+                            if (!ringVisible(i))
+                                continue;
+                            const QVector<GeoPoint> &mask = model.groundStationData()[i].mask;
+                            projectPoints(footMapping, mask, projected);
+                            projected.append(projected[0]); // close the ring
+                            projected.append(projected[1]);
+                            idx = VertexArena::writePolyline(v, idx, cap, projected.constData(), int(mask.size()) + 1, step,
+                                                             footMapping.width, footVisible);
+                        }
+                        return idx;
+                    };
+                    void *data = VertexArena::reserveData(geom, cap);
+                    m_footprintUsed = compact ? writeRings(static_cast<CompactPoint2D *>(data))
+                                              : writeRings(static_cast<QSGGeometry::Point2D *>(data));
+                    m_footprintReduced = step > 1;
+                    m_footprintGeneration = model.groundStationGeneration();
+                    m_footprintCenterLongitude = m_centerLongitude;
+                    m_footprintVertexLimit = vertexLimit;
+                    endPhase(FootprintPhase);
+                    VertexArena::finish(geom, m_footprintUsed);
+                    geom->markVertexDataDirty();
+                    gsFootNode->markDirty(QSGNode::DirtyGeometry);
                 }
-                gsFootNode->setGeometry(geom);
-                gsFootNode->markDirty(QSGNode::DirtyGeometry);
+                recordLayer(FootprintLayer, geom, m_footprintUsed, m_footprintReduced, !unchanged);
+                endPhase(UploadPhase);
             }
 
             // Dots: small circles in px space, duplicating across seam if needed
             {
-                const int vertsPerCircle = dotSegments * 3;
-                QVector<QPointF> centers;
-                centers.reserve(m_groundStationData.size() * 2);
-                for (const auto &gs : m_groundStationData) {
+                centres.clear();
+                const Projection::GeoWindow dotWindow = Projection::GeoWindow::forView(mapping, rect, dotPxRadius);
+                for (const auto &gs : model.groundStationData()) {
+                    if (!dotWindow.contains(gs.lat, gs.lon))
+                        continue;
                     const QPointF c = projectWrapped(gs.lat, gs.lon);
-                    centers.append(c);
-                    if (c.x() < rect.x() + dotPxRadius)
-                        centers.append(QPointF(c.x() + rect.width(), c.y()));
-                    if (c.x() > rect.x() + rect.width() - dotPxRadius)
-                        centers.append(QPointF(c.x() - rect.width(), c.y()));
+                    const float xy[2] = {float(c.x()), float(c.y())};
+                    VertexArena::appendDotCentres(xy, 1, world, dotPxRadius, centres);
                 }
-
+                const int count = int(centres.size() / 2);
+                const int segments = VertexArena::dotSegmentsFor(count, dotSegments, vertexLimit);
+                const int drawn = std::min(count, vertexLimit / (3 * segments));
                 QSGGeometry *geom = gsDotNode->geometry();
-                geom->allocate(centers.size() * vertsPerCircle);
-                geom->setDrawingMode(QSGGeometry::DrawTriangles);
-                QSGGeometry::Point2D *v = geom->vertexDataAsPoint2D();
-                int idx = 0;
-                for (const QPointF &c : centers) {
-                    for (int s = 0; s < dotSegments; ++s) {
-                        const qreal a0 = (2 * M_PI * s) / dotSegments;
-                        const qreal a1 = (2 * M_PI * (s + 1)) / dotSegments;
-                        const QPointF p0 = c + QPointF(std::cos(a0), std::sin(a0)) * dotPxRadius;
-                        const QPointF p1 = c + QPointF(std::cos(a1), std::sin(a1)) * dotPxRadius;
-                        v[idx++].set(c.x(), c.y());
-                        v[idx++].set(p0.x(), p0.y());
-                        v[idx++].set(p1.x(), p1.y());
-                    }
-                }
+                QSGGeometry::Point2D *v = VertexArena::reserve(geom, drawn * 3 * segments);
+                const int idx = VertexArena::writeDots(v, centres.constData(), drawn, segments, float(dotPxRadius));
+                endPhase(GroundStationPhase);
+                VertexArena::finish(geom, idx);
                 gsDotNode->markDirty(QSGNode::DirtyGeometry);
+                recordLayer(GroundStationLayer, geom, idx, segments < dotSegments || drawn < count);
+                endPhase(UploadPhase);
             }
         }
-
-    auto sampleArc = [&](double latA, double lonA, double latB, double lonB, int segments) -> QVector<QPointF> {
-        QVector<QPointF> pts;
-        if (segments < 2)
-            return pts;
-
-        const double aLat = latA * M_PI / 180.0;
-            const double aLon = lonA * M_PI / 180.0;
-            const double bLat = latB * M_PI / 180.0;
-            const double bLon = lonB * M_PI / 180.0;
-
-            auto toVec = [](double lat, double lon) {
-                return QVector3D(std::cos(lat) * std::cos(lon),
-                                 std::cos(lat) * std::sin(lon),
-                                 std::sin(lat));
-        };
-        QVector3D A = toVec(aLat, aLon).normalized();
-        QVector3D B = toVec(bLat, bLon).normalized();
-
-        const float dot = QVector3D::dotProduct(A, B);
-        double omega = std::acos(std::clamp(static_cast<double>(dot), -1.0, 1.0));
-        if (omega < 1e-6)
-            return pts;
-
-            for (int i = 0; i < segments; ++i) {
-                const double t = static_cast<double>(i) / (segments - 1);
-                const double sinOmega = std::sin(omega);
-                const double wA = std::sin((1 - t) * omega) / sinOmega;
-                const double wB = std::sin(t * omega) / sinOmega;
-                QVector3D P = A * wA + B * wB;
-                P.normalize();
-                const double lat = std::asin(std::clamp(static_cast<double>(P.z()), -1.0, 1.0)) * 180.0 / M_PI;
-                const double lon = std::atan2(P.y(), P.x()) * 180.0 / M_PI;
-                pts.append(projectWrapped(lat, lon));
+        endPhase(GroundStationPhase);
+
+        // Active contacts (GS <-> satellite)
+        if (model.activeContacts().isEmpty() || model.groundStationData().isEmpty() || model.satelliteData().isEmpty()) {
+            if (contactNode) {
+                contentRoot->removeChildNode(contactNode);
+                delete contactNode;
+                contactNode = nullptr;
             }
-        return pts;
-    };
-
-    // Active contacts (GS <-> satellite)
-    if (m_activeContacts.isEmpty() || m_groundStationData.isEmpty() || m_satelliteData.isEmpty()) {
-        if (contactNode) {
-            contentRoot->removeChildNode(contactNode);
-            delete contactNode;
-            contactNode = nullptr;
-        }
-    } else {
-        if (!contactNode) {
-            contactNode = new QSGGeometryNode();
-            auto *geom = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
-            geom->setDrawingMode(QSGGeometry::DrawTriangles);
-            contactNode->setGeometry(geom);
-            contactNode->setFlag(QSGNode::OwnsGeometry);
-
-            auto *mat = new QSGFlatColorMaterial();
-            mat->setColor(contactColor);
-            contactNode->setMaterial(mat);
-            contactNode->setFlag(QSGNode::OwnsMaterial);
-            contentRoot->appendChildNode(contactNode);
-        }
+        } else {
+            if (!contactNode) {
+                contactNode = new QSGGeometryNode();
+                auto *geom = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+                geom->setDrawingMode(QSGGeometry::DrawTriangles);
+                contactNode->setGeometry(geom);
+                contactNode->setFlag(QSGNode::OwnsGeometry);
 
-        QHash<QString, GeoPoint> satIndex;
-        satIndex.reserve(m_satelliteData.size());
-        for (const auto &sat : m_satelliteData) {
-            QString id = sat.id;
-            if (id.isEmpty()) {
-                const QVariant idVar = sat.raw.value(QStringLiteral("ID"), sat.raw.value(QStringLiteral("id")));
-                if (idVar.isValid())
-                    id = idVar.toString();
+                auto *mat = new QSGFlatColorMaterial();
+                mat->setColor(contactColor);
+                contactNode->setMaterial(mat);
+                contactNode->setFlag(QSGNode::OwnsMaterial);
+                contentRoot->appendChildNode(contactNode);
             }
-            if (id.isEmpty())
-                continue;
-            satIndex.insert(id, GeoPoint{sat.lat, sat.lon});
-        }
 
-        QHash<QString, GeoPoint> gsIndex;
-        gsIndex.reserve(m_groundStationData.size());
-        for (const auto &gs : m_groundStationData) {
-            QString id = gs.id;
-            if (id.isEmpty()) {
-                const QVariant idVar = gs.raw.value(QStringLiteral("id"), gs.raw.value(QStringLiteral("ID")));
-                if (idVar.isValid())
-                    id = idVar.toString();
+            QHash<QString, GeoPoint> gsIndex;
+            gsIndex.reserve(model.groundStationData().size());
+            for (const auto &gs : model.groundStationData()) {
+                if (gs.id.isEmpty())
+                    continue;
+                gsIndex.insert(gs.id, GeoPoint{gs.lat, gs.lon});
             }
-            if (id.isEmpty())
-                continue;
-            gsIndex.insert(id, GeoPoint{gs.lat, gs.lon});
-        }
-
-        QVector<QPointF> segments;
-        const qreal w = rect.width();
-        const qreal lineHalfWidth = 2.0;
-        auto addSegment = [&](QPointF a, QPointF b) {
-            qreal dx = b.x() - a.x();
-            if (dx > w / 2)
-                b.rx() -= w;
-            else if (dx < -w / 2)
-                b.rx() += w;
-            if (std::abs(b.x() - a.x()) > w)
-                return;
-            const qreal vx = b.x() - a.x();
-            const qreal vy = b.y() - a.y();
-            const qreal len = std::hypot(vx, vy);
-            if (len <= 0.01)
-                return;
-            const qreal nx = -vy / len;
-            const qreal ny = vx / len;
-            const QPointF offset(nx * lineHalfWidth, ny * lineHalfWidth);
-            const QPointF a1 = a + offset;
-            const QPointF a2 = a - offset;
-            const QPointF b1 = b + offset;
-            const QPointF b2 = b - offset;
-            segments.append(a1);
-            segments.append(a2);
-            segments.append(b1);
-            segments.append(b1);
-            segments.append(a2);
-            segments.append(b2);
-        };
 
-        for (const QVariant &entryVar : m_activeContacts) {
-            const QVariantMap entry = entryVar.toMap();
-            if (entry.isEmpty())
-                continue;
-            const QString gsId = entry.value(QStringLiteral("gs_id"), entry.value(QStringLiteral("gsId"))).toString();
-            const QString satId = entry.value(QStringLiteral("sat_id"), entry.value(QStringLiteral("satId"))).toString();
-            if (gsId.isEmpty() || satId.isEmpty())
-                continue;
-            if (!gsIndex.contains(gsId) || !satIndex.contains(satId))
-                continue;
-            const GeoPoint gs = gsIndex.value(gsId);
-            const GeoPoint sat = satIndex.value(satId);
-            const QPointF a = projectWrapped(gs.lat, gs.lon);
-            const QPointF b = projectWrapped(sat.lat, sat.lon);
-            addSegment(a, b);
-        }
-
-        QSGGeometry *geom = contactNode->geometry();
-        geom->allocate(segments.size());
-        geom->setDrawingMode(QSGGeometry::DrawTriangles);
-        QSGGeometry::Point2D *v = geom->vertexDataAsPoint2D();
-        for (int i = 0; i < segments.size(); ++i)
-            v[i].set(segments[i].x(), segments[i].y());
-        contactNode->markDirty(QSGNode::DirtyGeometry);
-    }
+            const int cap = int(std::min<qint64>(6 * qint64(model.activeContacts().size()), vertexLimit));
+            QSGGeometry *geom = contactNode->geometry();
+            QSGGeometry::Point2D *v = VertexArena::reserve(geom, cap);
+            int idx = 0;
+            const qreal lineHalfWidth = 2.0;
+            const QRectF contactVisible = rect.adjusted(-lineHalfWidth, -lineHalfWidth, lineHalfWidth, lineHalfWidth);
+            auto addSegment = [&](QPointF a, QPointF b) {
+                b.rx() = Projection::nearestCopy(a.x(), b.x(), w);
+                if (std::max(a.x(), b.x()) < contactVisible.left() || std::min(a.x(), b.x()) > contactVisible.right()
+                    || std::max(a.y(), b.y()) < contactVisible.top() || std::min(a.y(), b.y()) > contactVisible.bottom())
+                    return; // out of view
+                const qreal vx = b.x() - a.x();
+                const qreal vy = b.y() - a.y();
+                const qreal len = std::hypot(vx, vy);
+                if (len <= 0.01 || idx + 6 > cap)
+                    return;
+                const qreal nx = -vy / len;
+                const qreal ny = vx / len;
+                const QPointF offset(nx * lineHalfWidth, ny * lineHalfWidth);
+                const QPointF a1 = a + offset;
+                const QPointF a2 = a - offset;
+                const QPointF b1 = b + offset;
+                const QPointF b2 = b - offset;
+                v[idx++].set(a1.x(), a1.y());
+                v[idx++].set(a2.x(), a2.y());
+                v[idx++].set(b1.x(), b1.y());
+                v[idx++].set(b1.x(), b1.y());
+                v[idx++].set(a2.x(), a2.y());
+                v[idx++].set(b2.x(), b2.y());
+            };
 
-    auto findClosestSatellite = [&](const QPointF &pt) -> QVariantMap {
-        const qreal maxDistPx = 12.0;
-        QVariantMap best;
-        qreal bestDist2 = maxDistPx * maxDistPx;
-        for (const auto &sat : m_satelliteData) {
-            const QPointF c = projectWrapped(sat.lat, sat.lon);
-            const qreal dx = c.x() - pt.x();
-            const qreal dy = c.y() - pt.y();
-            const qreal d2 = dx * dx + dy * dy;
-            if (d2 < bestDist2) {
-                bestDist2 = d2;
-                best = sat.raw;
+            for (const QVariant &entryVar : model.activeContacts()) {
+                const QVariantMap entry = entryVar.toMap();
+                if (entry.isEmpty())
+                    continue;
+                const QString gsId = entry.value(QStringLiteral("gs_id"), entry.value(QStringLiteral("gsId"))).toString();
+                const QString satId = entry.value(QStringLiteral("sat_id"), entry.value(QStringLiteral("satId"))).toString();
+                if (gsId.isEmpty() || satId.isEmpty())
+                    continue;
+                const int satRow = model.satelliteData().rowOf(satId);
+                if (!gsIndex.contains(gsId) || satRow < 0)
+                    continue;
+                const GeoPoint gs = gsIndex.value(gsId);
+                const QPointF a = projectWrapped(gs.lat, gs.lon);
+                const QPointF b = projectWrapped(model.satelliteData().lat()[satRow], model.satelliteData().lon()[satRow]);
+                addSegment(a, b);
             }
-        }
-        return best;
-    };
 
-        // Satellites (small dots) and direction lines
-        if (m_satelliteData.isEmpty()) {
-            if (satNode) {
-                contentRoot->removeChildNode(satNode);
-                delete satNode;
-                satNode = nullptr;
-            }
-            if (satPastNode) {
-                contentRoot->removeChildNode(satPastNode);
-                delete satPastNode;
-                satPastNode = nullptr;
-            }
-            if (satFutureNode) {
-                contentRoot->removeChildNode(satFutureNode);
-                delete satFutureNode;
-                satFutureNode = nullptr;
+            endPhase(ContactPhase);
+            VertexArena::finish(geom, idx);
+            contactNode->markDirty(QSGNode::DirtyGeometry);
+            recordLayer(ContactLayer, geom, idx, cap < 6 * model.activeContacts().size());
+            endPhase(UploadPhase);
+        }
+        endPhase(ContactPhase);
+
+        // Satellites (small dots) and direction lines, in stable-slot chunks that are rewritten only where objects moved
+        if (model.satelliteData().isEmpty()) {
+            if (satLayer) {
+                contentRoot->removeChildNode(satLayer);
+                delete satLayer;
+                satLayer = nullptr;
             }
         } else {
-            if (!satPastNode) {
-                satPastNode = new QSGGeometryNode();
-                auto *geom = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
-                geom->setDrawingMode(QSGGeometry::DrawLines);
-                geom->setLineWidth(0.5f);
-                satPastNode->setGeometry(geom);
-                satPastNode->setFlag(QSGNode::OwnsGeometry);
-                auto *mat = new QSGFlatColorMaterial();
-                mat->setColor(satPastColor);
-                satPastNode->setMaterial(mat);
-                satPastNode->setFlag(QSGNode::OwnsMaterial);
-                contentRoot->appendChildNode(satPastNode);
+            if (!satLayer) {
+                satLayer = new SatelliteLayerNode(window());
+                contentRoot->appendChildNode(satLayer);
             }
-            if (!satFutureNode) {
-                satFutureNode = new QSGGeometryNode();
-                auto *geom = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
-                geom->setDrawingMode(QSGGeometry::DrawLines);
-                geom->setLineWidth(0.5f);
-                satFutureNode->setGeometry(geom);
-                satFutureNode->setFlag(QSGNode::OwnsGeometry);
-                auto *mat = new QSGFlatColorMaterial();
-                mat->setColor(satFutureColor);
-                satFutureNode->setMaterial(mat);
-                satFutureNode->setFlag(QSGNode::OwnsMaterial);
-                contentRoot->appendChildNode(satFutureNode);
-            }
-            if (!satNode) {
-                satNode = new QSGGeometryNode();
-                auto *geom = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
-                geom->setDrawingMode(QSGGeometry::DrawTriangles);
-                satNode->setGeometry(geom);
-                satNode->setFlag(QSGNode::OwnsGeometry);
-
-                auto *mat = new QSGFlatColorMaterial();
-                mat->setColor(satColor); // slightly darker for light backgrounds
-                satNode->setMaterial(mat);
-                satNode->setFlag(QSGNode::OwnsMaterial);
-                contentRoot->appendChildNode(satNode);
-            }
-
-            // Lines (past -> future only if both exist)
-            {
-                QVector<QPointF> segmentsPast;
-                QVector<QPointF> segmentsFuture;
-                segmentsPast.reserve(m_satelliteData.size() * 4);
-                segmentsFuture.reserve(m_satelliteData.size() * 4);
-                const int arcSamples = 4;
-                const qreal w = rect.width();
-
-                for (const auto &sat : m_satelliteData) {
-                    if (std::isfinite(sat.latPast) && std::isfinite(sat.lonPast)) {
-                        auto pts = sampleArc(sat.latPast, sat.lonPast, sat.lat, sat.lon, arcSamples);
-                        for (int i = 0; i + 1 < pts.size(); ++i) {
-                            const QPointF a = pts[i];
-                            QPointF b = pts[i + 1];
-                            qreal dx = b.x() - a.x();
-                            if (dx > w / 2) b.rx() -= w;
-                            else if (dx < -w / 2) b.rx() += w;
-                            if (std::abs(b.x() - a.x()) > w)
-                                continue;
-                            segmentsPast.append(a);
-                            segmentsPast.append(b);
-                        }
-                    }
-                    if (std::isfinite(sat.latFuture) && std::isfinite(sat.lonFuture)) {
-                        auto pts = sampleArc(sat.lat, sat.lon, sat.latFuture, sat.lonFuture, arcSamples);
-                        for (int i = 0; i + 1 < pts.size(); ++i) {
-                            const QPointF a = pts[i];
-                            QPointF b = pts[i + 1];
-                            qreal dx = b.x() - a.x();
-                            if (dx > w / 2) b.rx() -= w;
-                            else if (dx < -w / 2) b.rx() += w;
-                            if (std::abs(b.x() - a.x()) > w)
-                                continue;
-                            segmentsFuture.append(a);
-                            segmentsFuture.append(b);
-                        }
-                    }
-                }
-                // Past segments
-                QSGGeometry *geomPast = satPastNode->geometry();
-                geomPast->allocate(segmentsPast.size());
-                geomPast->setDrawingMode(QSGGeometry::DrawLines);
-                QSGGeometry::Point2D *vPast = geomPast->vertexDataAsPoint2D();
-                for (int i = 0; i < segmentsPast.size(); ++i) {
-                    const QPointF a = segmentsPast[i];
-                    vPast[i].set(a.x(), a.y());
-                }
-                satPastNode->markDirty(QSGNode::DirtyGeometry);
-
-                // Future segments
-                QSGGeometry *geomFuture = satFutureNode->geometry();
-                geomFuture->allocate(segmentsFuture.size());
-                geomFuture->setDrawingMode(QSGGeometry::DrawLines);
-                QSGGeometry::Point2D *vFuture = geomFuture->vertexDataAsPoint2D();
-                for (int i = 0; i < segmentsFuture.size(); ++i) {
-                    vFuture[i].set(segmentsFuture[i].x(), segmentsFuture[i].y());
-                }
-                satFutureNode->markDirty(QSGNode::DirtyGeometry);
-            }
-
-            // Dots
-            {
-                const int dotSegments = 8;
-                const qreal dotPxRadius = 3.0;
-                const int vertsPerCircle = dotSegments * 3;
-                QVector<QPointF> centers;
-                centers.reserve(m_satelliteData.size() * 2);
-                for (const auto &sat : m_satelliteData) {
-                    const QPointF c = projectWrapped(sat.lat, sat.lon);
-                    centers.append(c);
-                    if (c.x() < rect.x() + dotPxRadius)
-                        centers.append(QPointF(c.x() + rect.width(), c.y()));
-                    if (c.x() > rect.x() + rect.width() - dotPxRadius)
-                        centers.append(QPointF(c.x() - rect.width(), c.y()));
-                }
-
-                QSGGeometry *geom = satNode->geometry();
-                geom->allocate(centers.size() * vertsPerCircle);
-                geom->setDrawingMode(QSGGeometry::DrawTriangles);
-                QSGGeometry::Point2D *v = geom->vertexDataAsPoint2D();
-                int idx = 0;
-                for (const QPointF &c : centers) {
-                    for (int s = 0; s < dotSegments; ++s) {
-                        const qreal a0 = (2 * M_PI * s) / dotSegments;
-                        const qreal a1 = (2 * M_PI * (s + 1)) / dotSegments;
-                        const QPointF p0 = c + QPointF(std::cos(a0), std::sin(a0)) * dotPxRadius;
-                        const QPointF p1 = c + QPointF(std::cos(a1), std::sin(a1)) * dotPxRadius;
-                        v[idx++].set(c.x(), c.y());
-                        v[idx++].set(p0.x(), p0.y());
-                        v[idx++].set(p1.x(), p1.y());
-                    }
-                }
-                satNode->markDirty(QSGNode::DirtyGeometry);
+            SatelliteLayerNode::Style style;
+            style.pastColor = satPastColor;
+            style.futureColor = satFutureColor;
+            style.dotColor = satColor;
+            style.dotRadius = 3.0;
+            style.dotSegments = 8;
+            style.arcSamples = 4;
+            style.compactTracks = compact;
+            style.declutterCell = m_declutterLevel > 0 ? 16 << (m_declutterLevel - 1) : 0;
+            style.declutterThreshold = DeclutterThreshold;
+            SatelliteLayerNode::Stats layerStats;
+            satLayer->prepare(model.satelliteData(), mapping, world, rect, style, vertexLimit);
+            endPhase(SatellitePhase);
+            satLayer->updateTracks(model.satelliteData(), layerStats);
+            endPhase(TrackPhase);
+            satLayer->updateDots(model.satelliteData(), layerStats);
+            endPhase(SatellitePhase);
+
+            const RenderLayer layers[] = {PastTrackLayer, FutureTrackLayer, SatelliteLayer};
+            for (int i = 0; i < SatelliteLayerNode::LayerCount; ++i) {
+                stats.vertices[layers[i]] = layerStats.vertices[i];
+                stats.bytes[layers[i]] = layerStats.bytes[i];
+                stats.reduced[layers[i]] = layerStats.reduced[i];
             }
+            stats.satelliteChunks = layerStats.chunks;
+            stats.dirtyChunks = layerStats.dirtyChunks;
+            stats.clusters = layerStats.clusters;
+            stats.clusteredSatellites = layerStats.clusteredObjects;
+            stats.uploadBytes += layerStats.uploadBytes;
         }
+        endPhase(SatellitePhase);
+        stats.nodes = contentRoot->childCount() - (satLayer ? 1 : 0) + stats.satelliteChunks
+            + (tileLayer ? tileLayer->childCount() - 1 : 0);
     } else {
-        // No texture yet; clear children
+        // Nothing to draw; clear children
         if (transformNode) {
             root->removeAllChildNodes();
             delete transformNode;
         }
     }
 
+    if (m_batchPending) {
+        const qint64 drawnNs = LatencyHistogram::nowNs();
+        m_renderLatency.record(drawnNs - m_batchSetNs);
+        m_endToEndLatency.record(drawnNs - m_batchOriginNs);
+        m_batchPending = false;
+    }
+
+    stats.totalNs = frameTimer.nsecsElapsed();
+    m_renderStats = stats;
+    if (lcRender().isDebugEnabled()) {
+        QStringList phases;
+        for (int i = 0; i < RenderPhaseCount; ++i)
+            phases.append(QStringLiteral("%1 %2").arg(QLatin1String(RenderPhaseNames[i])).arg(stats.phaseNs[i] / 1e6, 0, 'f', 3));
+        qint64 bytes = 0;
+        for (qint64 b : stats.bytes)
+            bytes += b;
+        qCDebug(lcRender).noquote() << QStringLiteral("frame %1: %2 ms (%3), %4 vertex bytes, %5 uploaded")
+                                           .arg(stats.frame)
+                                           .arg(stats.totalNs / 1e6, 0, 'f', 3)
+                                           .arg(phases.join(QStringLiteral(", ")))
+                                           .arg(bytes)
+                                           .arg(stats.uploadBytes);
+    }
+    if (!m_renderStatsNotifyQueued.exchange(true)) {
+        QMetaObject::invokeMethod(
+            this,
+            [this]() {
+                m_renderStatsNotifyQueued = false;
+                emit renderStatsChanged();
+            },
+            Qt::QueuedConnection);
+    }
     return root;
 }
 
+QVariantMap EarthView::renderStats() const
+{
+    const RenderStats stats = m_renderStats;
+    QVariantMap phases;
+    for (int i = 0; i < RenderPhaseCount; ++i)
+        phases.insert(QLatin1String(RenderPhaseNames[i]), stats.phaseNs[i] / 1e6);
+    QVariantMap vertices;
+    QVariantMap bytes;
+    QStringList reduced;
+    qint64 totalBytes = 0;
+    for (int i = 0; i < RenderLayerCount; ++i) {
+        vertices.insert(QLatin1String(RenderLayerNames[i]), stats.vertices[i]);
+        bytes.insert(QLatin1String(RenderLayerNames[i]), stats.bytes[i]);
+        totalBytes += stats.bytes[i];
+        if (stats.reduced[i])
+            reduced.append(QLatin1String(RenderLayerNames[i]));
+    }
+    return {
+        {QStringLiteral("frame"), stats.frame},
+        {QStringLiteral("totalMs"), stats.totalNs / 1e6},
+        {QStringLiteral("nodes"), stats.nodes},
+        {QStringLiteral("phasesMs"), phases},
+        {QStringLiteral("vertices"), vertices},
+        {QStringLiteral("bytes"), bytes},
+        {QStringLiteral("totalBytes"), totalBytes},
+        {QStringLiteral("reducedLayers"), reduced},
+        {QStringLiteral("uploadBytes"), stats.uploadBytes},
+        {QStringLiteral("satelliteChunks"), stats.satelliteChunks},
+        {QStringLiteral("dirtyChunks"), stats.dirtyChunks},
+        {QStringLiteral("clusters"), stats.clusters},
+        {QStringLiteral("clusteredSatellites"), stats.clusteredSatellites},
+        {QStringLiteral("tileLevel"), stats.tileLevel},
+        {QStringLiteral("tilesVisible"), stats.tilesVisible},
+        {QStringLiteral("tilesPending"), stats.tilesPending},
+        {QStringLiteral("tileTextures"), stats.tileTextures},
+    };
+}
+
 void EarthView::timerEvent(QTimerEvent *event)
 {
+    if (event->timerId() == m_latencyTimer.timerId()) {
+        refreshLatencyStats();
+        return;
+    }
     QQuickItem::timerEvent(event);
 }
 
-void EarthView::releaseResources()
+void EarthView::refreshLatencyStats()
 {
-    if (m_texture) {
-        m_texture->deleteLater();
-        m_texture = nullptr;
+    QVariantMap stats;
+    const auto summarise = [&stats](const QString &stage, LatencyHistogram &histogram) {
+        const LatencyHistogram::Summary summary = histogram.take();
+        if (summary.count > 0)
+            stats.insert(stage, summary.toVariantMap());
+    };
+    summarise(QStringLiteral("apply"), m_applyLatency);
+    summarise(QStringLiteral("render"), m_renderLatency);
+    summarise(QStringLiteral("endToEnd"), m_endToEndLatency);
+    if (stats.isEmpty() && m_latencyStats.isEmpty()) {
+        m_latencyTimer.stop(); // no batches lately; setSatellites restarts it
+        return;
     }
+    m_latencyStats = stats;
+    emit latencyStatsChanged();
+}
+
+void EarthView::releaseResources()
+{
+    m_texture.reset();
 }
 
 void EarthView::hoverMoveEvent(QHoverEvent *event)
@@ -1081,23 +1177,16 @@ QVariantMap EarthView::groundStationAtPoint(qreal x, qreal y) const
 
 QVariantMap EarthView::satelliteAt(const QPointF &pt) const
 {
+    const SatelliteStore &satellites = activeModel()->satelliteData();
     const qreal maxDistPx = 12.0;
-    QVariantMap best;
     qreal bestDist2 = maxDistPx * maxDistPx;
 
     bool rotated = false;
     const QRectF rect = viewRect(rotated);
     const QRectF bounds = boundingRect();
+    const QRectF world = mapRect(rect);
 
-    auto project = [&](double latDeg, double lonDeg) -> QPointF {
-        qreal x = rect.x() + ((lonDeg + 180.0) / 360.0) * rect.width();
-        qreal y = rect.y() + ((90.0 - latDeg) / 180.0) * rect.height();
-        qreal localOffset = (m_centerLongitude / 360.0) * rect.width();
-        x -= localOffset;
-        while (x < rect.x()) x += rect.width();
-        while (x > rect.x() + rect.width()) x -= rect.width();
-        return QPointF(x, y);
-    };
+    const Projection::Mapping mapping = Projection::Mapping::forView(world, m_centerLongitude);
 
     auto inverseRotateIfNeeded = [&](const QPointF &p) -> QPointF {
         if (!rotated)
@@ -1109,41 +1198,38 @@ QVariantMap EarthView::satelliteAt(const QPointF &pt) const
         return QPointF(c.x() - dy, c.y() + dx);
     };
     const QPointF queryPt = inverseRotateIfNeeded(pt);
-
-    for (const auto &sat : m_satelliteData) {
-        const QPointF c = project(sat.lat, sat.lon);
-        const qreal dx = c.x() - queryPt.x();
-        const qreal dy = c.y() - queryPt.y();
+    if (!rect.contains(queryPt))
+        return {}; // outside the clip nothing is drawn
+
+    // Only the nearest row's attributes are materialised.
+    int bestRow = -1;
+    m_hitScratch.resize(satellites.size() * 2);
+    Projection::projectWrapped(mapping, satellites.lat(), satellites.lon(), satellites.size(), 1, m_hitScratch.data());
+    const float *xy = m_hitScratch.constData();
+    for (int i = 0; i < satellites.size(); ++i) {
+        const qreal dx = Projection::nearestCopy(queryPt.x(), xy[2 * i], world.width()) - queryPt.x(); // seam copies
+        const qreal dy = xy[2 * i + 1] - queryPt.y();
         const qreal d2 = dx * dx + dy * dy;
         if (d2 < bestDist2) {
             bestDist2 = d2;
-            best = sat.raw;
-            if (!sat.id.isEmpty())
-                best.insert(QStringLiteral("ID"), sat.id);
+            bestRow = i;
         }
     }
-    return best;
+    return bestRow >= 0 ? satellites.attributes(bestRow) : QVariantMap();
 }
 
 QVariantMap EarthView::groundStationAt(const QPointF &pt) const
 {
+    const GroundStationList &stations = activeModel()->groundStationData();
     const qreal maxDistPx = 12.0;
-    QVariantMap best;
     qreal bestDist2 = maxDistPx * maxDistPx;
 
     bool rotated = false;
     const QRectF rect = viewRect(rotated);
     const QRectF bounds = boundingRect();
+    const QRectF world = mapRect(rect);
 
-    auto project = [&](double latDeg, double lonDeg) -> QPointF {
-        qreal x = rect.x() + ((lonDeg + 180.0) / 360.0) * rect.width();
-        qreal y = rect.y() + ((90.0 - latDeg) / 180.0) * rect.height();
-        qreal localOffset = (m_centerLongitude / 360.0) * rect.width();
-        x -= localOffset;
-        while (x < rect.x()) x += rect.width();
-        while (x > rect.x() + rect.width()) x -= rect.width();
-        return QPointF(x, y);
-    };
+    const Projection::Mapping mapping = Projection::Mapping::forView(world, m_centerLongitude);
 
     auto inverseRotateIfNeeded = [&](const QPointF &p) -> QPointF {
         if (!rotated)
@@ -1154,18 +1240,20 @@ QVariantMap EarthView::groundStationAt(const QPointF &pt) const
         return QPointF(c.x() - dy, c.y() + dx);
     };
     const QPointF queryPt = inverseRotateIfNeeded(pt);
+    if (!rect.contains(queryPt))
+        return {};
 
-    for (const auto &gs : m_groundStationData) {
-        const QPointF c = project(gs.lat, gs.lon);
-        const qreal dx = c.x() - queryPt.x();
+    const GroundStation *best = nullptr;
+    for (const auto &gs : stations) {
+        const QPointF c = Projection::projectWrapped(mapping, gs.lat, gs.lon);
+        const qreal dx = Projection::nearestCopy(queryPt.x(), c.x(), world.width()) - queryPt.x();
         const qreal dy = c.y() - queryPt.y();
         const qreal d2 = dx * dx + dy * dy;
         if (d2 < bestDist2) {
             bestDist2 = d2;
-            best = gs.raw;
-            if (!gs.id.isEmpty())
-                best.insert(QStringLiteral("ID"), gs.id);
+            best = &gs;
         }
     }
-    return best;
+    // Only the hit station is materialised for QML.
+    return best ? best->toVariantMap() : QVariantMap();
 }
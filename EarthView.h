@@ -1,17 +1,26 @@
 #pragma once
 
-#include <QImage>
+#include <QBasicTimer>
 #include <QPointer>
 #include <QQuickItem>
 #include <QSGTexture>
+#include <QSharedPointer>
 #include <QVariantList>
 #include <QVector>
 #include <QString>
+#include <QStringList>
 #include <QColor>
-#include <limits>
+#include <array>
+#include <atomic>
+#include <memory>
 
 #include <QtQml/qqmlregistration.h>
 
+#include "EarthModel.h"
+#include "GeoTypes.h"
+#include "LatencyHistogram.h"
+#include "TileLoader.h"
+
 // Copyright (c) 2026 Andy Armitage
 // This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
 
@@ -22,18 +31,74 @@ class EarthView : public QQuickItem
 
 public:
     Q_PROPERTY(double centerLongitude READ centerLongitude WRITE setCenterLongitude NOTIFY centerLongitudeChanged)
+    // Map scale relative to the fitted (or filled) world, 1 to MaxZoom. Above 1 the view shows the region around
+    // (centerLongitude, centerLatitude) and layers only tessellate what is in it.
+    Q_PROPERTY(double zoom READ zoom WRITE setZoom NOTIFY zoomChanged)
+    // Latitude at the centre of the view; held where the map still covers the view, so it has no effect at zoom 1.
+    Q_PROPERTY(double centerLatitude READ centerLatitude WRITE setCenterLatitude NOTIFY centerLatitudeChanged)
     Q_PROPERTY(bool fitWorld READ fitWorld WRITE setFitWorld NOTIFY fitWorldChanged)
     Q_PROPERTY(bool rotatePortrait READ rotatePortrait WRITE setRotatePortrait NOTIFY rotatePortraitChanged)
     Q_PROPERTY(QColor accentColor READ accentColor WRITE setAccentColor NOTIFY accentColorChanged)
+    // Shared data for several views (null: a private model). The data properties below read and write the model.
+    Q_PROPERTY(EarthModel *model READ model WRITE setModel NOTIFY modelChanged)
     Q_PROPERTY(QVariantList groundStations READ groundStations WRITE setGroundStations NOTIFY groundStationsChanged)
     Q_PROPERTY(QVariantList satellites READ satellites WRITE setSatellites NOTIFY satellitesChanged)
     Q_PROPERTY(QVariantList activeContacts READ activeContacts WRITE setActiveContacts NOTIFY activeContactsChanged)
+    // Satellite batch latency over the last few seconds: {apply, render, endToEnd} -> {count, p50Ms, p99Ms, maxMs}.
+    Q_PROPERTY(QVariantMap latencyStats READ latencyStats NOTIFY latencyStatsChanged)
+    // Satellite batches replaced by a newer one before they were drawn.
+    Q_PROPERTY(qint64 droppedBatches READ droppedBatches NOTIFY latencyStatsChanged)
+    // Profile of the last updatePaintNode: {frame, totalMs, nodes, phasesMs: {phase: ms}, vertices: {layer: n},
+    // bytes: {layer: n}, totalBytes, reducedLayers, uploadBytes, satelliteChunks, dirtyChunks, clusters,
+    // clusteredSatellites, tileLevel, tilesVisible, tilesPending, tileTextures}. Bytes are vertex arena capacity;
+    // reducedLayers lists layers drawn at lower detail because of vertexMemoryLimit; uploadBytes counts the geometry
+    // marked for upload (satellite track chunks and dot slots only when their objects changed); clusters are
+    // declutter markers; the tile entries describe backgroundTiles (level -1 without). Per-frame lines are also logged
+    // under the `earthview.render` category.
+    Q_PROPERTY(QVariantMap renderStats READ renderStats NOTIFY renderStatsChanged)
+    // Cap on each overlay layer's vertex memory in bytes (0: unlimited). Over it a layer drops detail (fewer dot
+    // segments, thinned tracks and footprints) and then objects.
+    Q_PROPERTY(qint64 vertexMemoryLimit READ vertexMemoryLimit WRITE setVertexMemoryLimit NOTIFY vertexMemoryLimitChanged)
+    // Footprint and track lines as 16-bit map coordinates placed by a vertex shader: half the vertex memory and
+    // upload, and no rebuild on resize. Ignored (float pixels) on the software backend, and while the zoom is too
+    // deep for 16 bits to place lines within half a device pixel (CompactPoint2D::resolves).
+    Q_PROPERTY(bool compactVertices READ compactVertices WRITE setCompactVertices NOTIFY compactVerticesChanged)
+    // 0 draws every satellite dot. Levels 1 to 3 group dots into 16, 32 or 64 px grid cells; a cell holding
+    // DeclutterThreshold or more is drawn as one marker sized by its count.
+    Q_PROPERTY(int declutterLevel READ declutterLevel WRITE setDeclutterLevel NOTIFY declutterLevelChanged)
+    // Theme for the bundled background, applied in its shader: a colour multiplied in (white: none), saturation and
+    // brightness, each 0 to 1 (1: as drawn). RHI backends only; tiles from backgroundTiles are drawn as stored.
+    Q_PROPERTY(QColor backgroundTint READ backgroundTint WRITE setBackgroundTint NOTIFY backgroundTintChanged)
+    Q_PROPERTY(double backgroundSaturation READ backgroundSaturation WRITE setBackgroundSaturation NOTIFY backgroundSaturationChanged)
+    Q_PROPERTY(double backgroundBrightness READ backgroundBrightness WRITE setBackgroundBrightness NOTIFY backgroundBrightnessChanged)
+    // Pre-baked KTX (version 1) copies of the background in GPU block-compressed formats (ETC2, ASTC, BCn), each with
+    // its mip chain. The first one the GPU supports replaces the bundled PNG; none suits the software backend.
+    Q_PROPERTY(QStringList compressedBackgrounds READ compressedBackgrounds WRITE setCompressedBackgrounds NOTIFY
+                   compressedBackgroundsChanged)
+    // Tile pyramid file (TilePyramid.h, built with earth-view-tile-pyramid) drawn over the bundled background at the
+    // level that suits the zoom. Tiles are decoded on a worker thread as they come into view; empty: bundled image only.
+    Q_PROPERTY(QString backgroundTiles READ backgroundTiles WRITE setBackgroundTiles NOTIFY backgroundTilesChanged)
+    // Tile textures kept on the GPU (least recently drawn evicted first); tiles in view are always kept.
+    Q_PROPERTY(int tileCacheSize READ tileCacheSize WRITE setTileCacheSize NOTIFY tileCacheSizeChanged)
 
     explicit EarthView(QQuickItem *parent = nullptr);
 
+    // Blocks until the bundled PNG background is decoded, for offscreen renderers whose first frame must include it.
+    void waitForBackground();
+
+    EarthModel *model() const { return m_sharedModel; }
+    void setModel(EarthModel *model);
+
     double centerLongitude() const { return m_centerLongitude; }
     void setCenterLongitude(double lon);
 
+    static constexpr double MaxZoom = 64.0;
+    double zoom() const { return m_zoom; }
+    void setZoom(double zoom);
+
+    double centerLatitude() const { return m_centerLatitude; }
+    void setCenterLatitude(double lat);
+
     bool fitWorld() const { return m_fitWorld; }
     void setFitWorld(bool fit);
 
@@ -43,20 +108,60 @@ public:
     QColor accentColor() const { return m_accentColor; }
     void setAccentColor(const QColor &color);
 
-    QVariantList groundStations() const { return m_groundStations; }
+    QVariantList groundStations() const;
     void setGroundStations(const QVariantList &stations);
+    // Typed input path for feeds; avoids the QVariant round trip. Pass by move.
+    void setGroundStationData(GroundStationList stations);
 
-    QVariantList satellites() const { return m_satellites; }
+    QVariantList satellites() const { return activeModel()->satellites(); }
     void setSatellites(const QVariantList &sats);
+    // As above, with the batch's origin time (LatencyHistogram::nowNs clock) for end-to-end latency.
+    void setSatellites(const QVariantList &sats, qint64 originNs);
+    // Typed input path for feeds that produce columns (see EarthModel::setSatelliteStates).
+    void setSatelliteStates(const CompactStates::Batch &states, qint64 originNs);
 
-    QVariantList activeContacts() const { return m_activeContacts; }
+    QVariantList activeContacts() const { return activeModel()->activeContacts(); }
     void setActiveContacts(const QVariantList &contacts);
 
+    QVariantMap latencyStats() const { return m_latencyStats; }
+    qint64 droppedBatches() const { return m_droppedBatches; }
+    QVariantMap renderStats() const;
+
+    qint64 vertexMemoryLimit() const { return m_vertexMemoryLimit; }
+    void setVertexMemoryLimit(qint64 bytes);
+
+    bool compactVertices() const { return m_compactVertices; }
+    void setCompactVertices(bool compact);
+
+    static constexpr int MaxDeclutterLevel = 3;
+    static constexpr int DeclutterThreshold = 4;
+    int declutterLevel() const { return m_declutterLevel; }
+    void setDeclutterLevel(int level);
+
+    QColor backgroundTint() const { return m_backgroundTint; }
+    void setBackgroundTint(const QColor &color);
+
+    double backgroundSaturation() const { return m_backgroundSaturation; }
+    void setBackgroundSaturation(double saturation);
+
+    double backgroundBrightness() const { return m_backgroundBrightness; }
+    void setBackgroundBrightness(double brightness);
+
+    QStringList compressedBackgrounds() const { return activeModel()->compressedBackgrounds(); }
+    void setCompressedBackgrounds(const QStringList &fileNames);
+
+    QString backgroundTiles() const { return m_backgroundTiles; }
+    void setBackgroundTiles(const QString &fileName);
+
+    int tileCacheSize() const { return m_tileCacheSize; }
+    void setTileCacheSize(int tiles);
+
     Q_INVOKABLE QVariantMap satelliteAtPoint(qreal x, qreal y) const;
     Q_INVOKABLE QVariantMap groundStationAtPoint(qreal x, qreal y) const;
 
 
 protected:
+    void componentComplete() override;
     QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override;
     void releaseResources() override;
     void timerEvent(QTimerEvent *event) override;
@@ -68,60 +173,128 @@ protected:
     void touchEvent(QTouchEvent *event) override;
 
 signals:
+    void modelChanged();
     void centerLongitudeChanged();
+    void zoomChanged();
+    void centerLatitudeChanged();
     void fitWorldChanged();
     void rotatePortraitChanged();
     void accentColorChanged();
     void groundStationsChanged();
     void satellitesChanged();
     void activeContactsChanged();
+    void latencyStatsChanged();
+    void renderStatsChanged();
+    void vertexMemoryLimitChanged();
+    void compactVerticesChanged();
+    void declutterLevelChanged();
+    void backgroundTintChanged();
+    void backgroundSaturationChanged();
+    void backgroundBrightnessChanged();
+    void compressedBackgroundsChanged();
+    void backgroundTilesChanged();
+    void tileCacheSizeChanged();
     void satelliteHovered(const QVariantMap &satelliteInfo);
     void groundStationHovered(const QVariantMap &groundStationInfo);
     void itemTapped(const QVariantMap &satelliteInfo, const QVariantMap &groundStationInfo);
 
 private:
+    EarthModel *activeModel() const { return m_sharedModel ? m_sharedModel.data() : m_ownModel; }
+    void connectModel();
+    void onModelSatellitesChanged();
     void ensureTexture();
     QVariantMap satelliteAt(const QPointF &pt) const;
     QVariantMap groundStationAt(const QPointF &pt) const;
     QRectF viewRect(bool &rotated) const;
+    QRectF mapRect(const QRectF &view) const;
+    void refreshLatencyStats();
 
-    QImage m_backgroundImage;
-    QPointer<QSGTexture> m_texture;
+    EarthModel *m_ownModel {nullptr}; // child; used while no shared model is set
+    QPointer<EarthModel> m_sharedModel;
+    QSharedPointer<QSGTexture> m_texture; // shared with the model's other views in this window
     QPointer<QQuickWindow> m_lastWindow;
+    bool m_textureStale {false}; // the background source changed; recreate m_texture
+    QColor m_backgroundTint {Qt::white};
+    double m_backgroundSaturation {1.0};
+    double m_backgroundBrightness {1.0};
+    QRectF m_backgroundQuad; // render thread: what the background geometry was last written for
     double m_centerLongitude {0.0};
+    double m_zoom {1.0};
+    double m_centerLatitude {0.0};
     bool m_fitWorld {true};
     bool m_rotatePortrait {false};
     QColor m_accentColor {QColor(90, 210, 255)}; // default pale/electric blue
-    QVariantList m_groundStations;
-    QVariantList m_satellites;
-    QVariantList m_activeContacts;
 
-    struct GeoPoint {
-        double lat {0.0};
-        double lon {0.0};
-    };
+    mutable QVector<float> m_hitScratch; // projected positions for satelliteAt
+    // Batch latency; the pending stamps are written when the model takes a batch and read in updatePaintNode (GUI thread blocked).
+    qint64 m_batchOriginNs {0};
+    qint64 m_batchSetNs {0};
+    bool m_batchPending {false};
+    qint64 m_droppedBatches {0};
+    LatencyHistogram m_applyLatency;    // setSatellites duration
+    LatencyHistogram m_renderLatency;   // setSatellites -> first updatePaintNode that draws the batch
+    LatencyHistogram m_endToEndLatency; // origin -> first draw
+    QVariantMap m_latencyStats;
+    QBasicTimer m_latencyTimer;
 
-    struct GroundStation {
-        double lat {0.0};
-        double lon {0.0};
-        double radiusKm {0.0};
-        QString id;
-        QVector<GeoPoint> mask;
-        QVariantMap raw;
+    enum RenderPhase {
+        NodeLookupPhase,
+        TexturePhase,
+        FootprintPhase,
+        GroundStationPhase,
+        ContactPhase,
+        TrackPhase,
+        SatellitePhase,
+        UploadPhase, // filling vertex buffers, all layers
+        RenderPhaseCount
+    };
+    enum RenderLayer {
+        FootprintLayer,
+        GroundStationLayer,
+        ContactLayer,
+        PastTrackLayer,
+        FutureTrackLayer,
+        SatelliteLayer,
+        RenderLayerCount
     };
-    QVector<GroundStation> m_groundStationData;
-
-    struct Satellite {
-        double lat {0.0};
-        double lon {0.0};
-        double latPast {std::numeric_limits<double>::quiet_NaN()};
-        double lonPast {std::numeric_limits<double>::quiet_NaN()};
-        double latFuture {std::numeric_limits<double>::quiet_NaN()};
-        double lonFuture {std::numeric_limits<double>::quiet_NaN()};
-        QString id;
-        QVariantMap raw;
+    struct RenderStats
+    {
+        quint64 frame {0};
+        qint64 totalNs {0};
+        int nodes {0}; // texture and geometry nodes in the content tree
+        std::array<qint64, RenderPhaseCount> phaseNs {};
+        std::array<int, RenderLayerCount> vertices {};
+        std::array<qint64, RenderLayerCount> bytes {};
+        std::array<bool, RenderLayerCount> reduced {};
+        qint64 uploadBytes {0};
+        int satelliteChunks {0}; // satellite track chunk nodes, the dot buffer and the seam and cluster nodes
+        int dirtyChunks {0};     // track chunks and dot buffer ranges marked for upload
+        int clusters {0};
+        int clusteredSatellites {0};
+        int tileLevel {-1};
+        int tilesVisible {0};
+        int tilesPending {0};
+        int tileTextures {0};
     };
-    QVector<Satellite> m_satelliteData;
+    // Written on the render thread while the GUI thread is blocked in sync; read on the GUI thread.
+    RenderStats m_renderStats;
+    std::atomic<bool> m_renderStatsNotifyQueued {false};
+    qint64 m_vertexMemoryLimit {qint64(32) * 1024 * 1024};
+    bool m_compactVertices {false};
+    int m_declutterLevel {0};
+    QString m_backgroundTiles;
+    std::unique_ptr<TileLoader> m_tileLoader; // replaced on the GUI thread, used in updatePaintNode
+    quint64 m_tilesGeneration {0};            // bumped with every loader so the tile node drops its cache
+    int m_tileCacheSize {64};
+    // What the compact footprint geometry was last written for (render thread).
+    quint64 m_footprintGeneration {0};
+    double m_footprintCenterLongitude {0.0};
+    int m_footprintVertexLimit {0};
+    int m_footprintUsed {0};
+    bool m_footprintReduced {false};
+    // Render-thread scratch for projected positions and dot centres, kept across frames.
+    QVector<float> m_projectScratch;
+    QVector<float> m_centreScratch;
     bool m_lastHoverHadSat {false};
     bool m_lastHoverHadGroundStation {false};
 
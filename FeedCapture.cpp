@@ -0,0 +1,373 @@
+#include "FeedCapture.h"
+
+#include <QMutexLocker>
+#include <QtEndian>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+using namespace FeedCapture;
+
+static_assert(sizeof(IndexEntry) == 16, "index entries are read in place from the mapping");
+
+qint64 FeedCapture::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+FeedCaptureWriter::~FeedCaptureWriter()
+{
+    close();
+}
+
+bool FeedCaptureWriter::open(const QString &fileName)
+{
+    close();
+
+    QMutexLocker locker(&m_mutex);
+    m_file.setFileName(fileName);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    uchar header[FileHeaderSize] = {};
+    std::memcpy(header, Magic, sizeof(Magic));
+    qToLittleEndian<quint32>(Version, header + 8);
+    if (m_file.write(reinterpret_cast<const char *>(header), sizeof(header)) != qint64(sizeof(header))) {
+        m_file.close();
+        return false;
+    }
+
+    m_offset = FileHeaderSize;
+    m_recordCount = 0;
+    m_lastIndexedNs = 0;
+    m_sinceLastIndex = 0;
+    m_index.clear();
+    m_lastKvNs = 0;
+    m_kvIndex.clear();
+    m_open.store(true, std::memory_order_release);
+    return true;
+}
+
+void FeedCaptureWriter::close()
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_open.load(std::memory_order_relaxed))
+        return;
+    m_open.store(false, std::memory_order_release);
+
+    // Pad so the index can be read in place from the mapping.
+    static const char zeros[8] = {};
+    const qint64 pad = (8 - (m_offset % 8)) % 8;
+    m_file.write(zeros, pad);
+    const quint64 indexOffset = quint64(m_offset + pad);
+
+    // The seek index, then the KV index; both stay 8-byte aligned.
+    const auto writeIndex = [this](const char (&magic)[8], const QVector<IndexEntry> &index) {
+        uchar indexHeader[IndexHeaderSize];
+        std::memcpy(indexHeader, magic, sizeof(magic));
+        qToLittleEndian<quint64>(quint64(index.size()), indexHeader + 8);
+        m_file.write(reinterpret_cast<const char *>(indexHeader), sizeof(indexHeader));
+        for (const IndexEntry &e : index) {
+            uchar entry[16];
+            qToLittleEndian<quint64>(e.timestampNs, entry);
+            qToLittleEndian<quint64>(e.offset, entry + 8);
+            m_file.write(reinterpret_cast<const char *>(entry), sizeof(entry));
+        }
+    };
+    writeIndex(IndexMagic, m_index);
+    writeIndex(KvIndexMagic, m_kvIndex);
+
+    uchar trailer[16];
+    qToLittleEndian<quint64>(indexOffset, trailer);
+    qToLittleEndian<quint64>(m_recordCount, trailer + 8);
+    m_file.seek(16);
+    m_file.write(reinterpret_cast<const char *>(trailer), sizeof(trailer));
+    m_file.close();
+    m_index.clear();
+    m_kvIndex.clear();
+}
+
+QString FeedCaptureWriter::errorString() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_file.errorString();
+}
+
+bool FeedCaptureWriter::append(qint64 timestampNs, RecordKind kind, QByteArrayView subject, QByteArrayView payload)
+{
+    if (subject.size() > 0xffff || payload.size() > 0x7fffffff)
+        return false;
+
+    uchar header[RecordHeaderSize];
+    qToLittleEndian<quint64>(quint64(timestampNs), header);
+    header[8] = uchar(kind);
+    header[9] = 0;
+    qToLittleEndian<quint16>(quint16(subject.size()), header + 10);
+    qToLittleEndian<quint32>(quint32(payload.size()), header + 12);
+
+    QMutexLocker locker(&m_mutex);
+    if (!m_open.load(std::memory_order_relaxed))
+        return false;
+
+    if (m_file.write(reinterpret_cast<const char *>(header), sizeof(header)) != qint64(sizeof(header))
+        || m_file.write(subject.data(), subject.size()) != subject.size()
+        || m_file.write(payload.data(), payload.size()) != payload.size()) {
+        // Drop whatever part of the record made it out, so the next one starts at m_offset again.
+        if (m_file.seek(m_offset))
+            m_file.resize(m_offset);
+        return false;
+    }
+
+    // Indexed only once the record is complete. Producers race on timestamps by a few microseconds; keep the index
+    // monotonic.
+    const qint64 indexNs = std::max(timestampNs, m_lastIndexedNs);
+    if (m_recordCount == 0 || indexNs - m_lastIndexedNs >= IndexTimeIntervalNs || m_sinceLastIndex >= IndexRecordInterval) {
+        m_index.append(IndexEntry{quint64(indexNs), quint64(m_offset)});
+        m_lastIndexedNs = indexNs;
+        m_sinceLastIndex = 0;
+    }
+    if (kind != RecordKind::Message) {
+        m_lastKvNs = std::max(timestampNs, m_lastKvNs);
+        m_kvIndex.append(IndexEntry{quint64(m_lastKvNs), quint64(m_offset)});
+    }
+    m_offset += RecordHeaderSize + subject.size() + payload.size();
+    ++m_recordCount;
+    ++m_sinceLastIndex;
+    return true;
+}
+
+FeedCaptureReader::~FeedCaptureReader()
+{
+    close();
+}
+
+bool FeedCaptureReader::open(const QString &fileName)
+{
+    close();
+    m_file.setFileName(fileName);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_error = m_file.errorString();
+        return false;
+    }
+    const qint64 size = m_file.size();
+    if (size < FileHeaderSize) {
+        m_error = QStringLiteral("not a feed capture file");
+        close();
+        return false;
+    }
+    m_data = m_file.map(0, size);
+    if (!m_data) {
+        m_error = m_file.errorString();
+        close();
+        return false;
+    }
+    const quint32 version = qFromLittleEndian<quint32>(m_data + 8);
+    if (std::memcmp(m_data, Magic, sizeof(Magic)) != 0 || version < MinVersion || version > Version) {
+        m_error = QStringLiteral("not a feed capture file");
+        close();
+        return false;
+    }
+
+    const quint64 indexOffset = qFromLittleEndian<quint64>(m_data + 16);
+    if (indexOffset >= quint64(FileHeaderSize) && indexOffset <= quint64(size)
+        && readIndexAt(indexOffset, IndexMagic, m_index, m_indexCount, m_rebuiltIndex)) {
+        m_dataEnd = qint64(indexOffset);
+        const quint64 kvIndexOffset = indexOffset + IndexHeaderSize + quint64(m_indexCount) * sizeof(IndexEntry);
+        if (version < 3 || !readIndexAt(kvIndexOffset, KvIndexMagic, m_kvIndex, m_kvIndexCount, m_rebuiltKvIndex))
+            rebuildKvIndex(); // a version 2 file: scanned once here rather than on every replay pass
+    } else {
+        m_dataEnd = size;
+        rebuildIndex();
+    }
+
+    if (m_indexCount > 0) {
+        m_firstNs = qint64(m_index[0].timestampNs);
+        // The last record's timestamp: start from the last entry and walk the short tail.
+        RecordView rec;
+        qint64 pos = qint64(m_index[m_indexCount - 1].offset);
+        qint64 nextPos = pos;
+        m_lastNs = m_firstNs;
+        while (readRecordAt(pos, rec, nextPos)) {
+            m_lastNs = std::max(m_lastNs, rec.timestampNs);
+            pos = nextPos;
+        }
+    }
+    m_pos = FileHeaderSize;
+    m_error.clear();
+    return true;
+}
+
+void FeedCaptureReader::close()
+{
+    if (m_data) {
+        m_file.unmap(const_cast<uchar *>(m_data));
+        m_data = nullptr;
+    }
+    if (m_file.isOpen())
+        m_file.close();
+    m_index = nullptr;
+    m_indexCount = 0;
+    m_rebuiltIndex.clear();
+    m_kvIndex = nullptr;
+    m_kvIndexCount = 0;
+    m_rebuiltKvIndex.clear();
+    m_dataEnd = 0;
+    m_pos = 0;
+    m_firstNs = 0;
+    m_lastNs = 0;
+    m_recovered = false;
+}
+
+bool FeedCaptureReader::readIndexAt(quint64 offset, const char (&magic)[8], const IndexEntry *&entries, qint64 &count,
+                                    QVector<IndexEntry> &converted) const
+{
+    // Sizes are compared by subtraction so that values read from a corrupt file cannot wrap.
+    const quint64 size = quint64(m_file.size());
+    if (offset % 8 != 0 || offset > size || size - offset < quint64(IndexHeaderSize)
+        || std::memcmp(m_data + offset, magic, sizeof(magic)) != 0)
+        return false;
+    const quint64 n = qFromLittleEndian<quint64>(m_data + offset + 8);
+    if (n > (size - offset - IndexHeaderSize) / sizeof(IndexEntry))
+        return false;
+    const uchar *data = m_data + offset + IndexHeaderSize;
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    Q_UNUSED(converted);
+    entries = reinterpret_cast<const IndexEntry *>(data);
+#else
+    converted.resize(qsizetype(n));
+    for (quint64 i = 0; i < n; ++i) {
+        converted[i].timestampNs = qFromLittleEndian<quint64>(data + i * 16);
+        converted[i].offset = qFromLittleEndian<quint64>(data + i * 16 + 8);
+    }
+    entries = converted.constData();
+#endif
+    count = qint64(n);
+    return true;
+}
+
+bool FeedCaptureReader::readRecordAt(qint64 offset, RecordView &record, qint64 &nextOffset) const
+{
+    if (!m_data || offset + RecordHeaderSize > m_dataEnd)
+        return false;
+    const uchar *p = m_data + offset;
+    const quint16 subjectLen = qFromLittleEndian<quint16>(p + 10);
+    const quint32 payloadLen = qFromLittleEndian<quint32>(p + 12);
+    const qint64 end = offset + RecordHeaderSize + subjectLen + qint64(payloadLen);
+    if (end > m_dataEnd)
+        return false;
+
+    record.timestampNs = qint64(qFromLittleEndian<quint64>(p));
+    record.kind = RecordKind(p[8]);
+    record.subject = QByteArrayView(p + RecordHeaderSize, subjectLen);
+    record.payload = QByteArrayView(p + RecordHeaderSize + subjectLen, qsizetype(payloadLen));
+    nextOffset = end;
+    return true;
+}
+
+void FeedCaptureReader::rebuildIndex()
+{
+    m_rebuiltIndex.clear();
+    m_rebuiltKvIndex.clear();
+    RecordView rec;
+    qint64 pos = FileHeaderSize;
+    qint64 nextPos = pos;
+    qint64 lastIndexedNs = 0;
+    qint64 lastKvNs = 0;
+    int sinceLastIndex = 0;
+    while (readRecordAt(pos, rec, nextPos)) {
+        const qint64 indexNs = std::max(rec.timestampNs, lastIndexedNs);
+        if (m_rebuiltIndex.isEmpty() || indexNs - lastIndexedNs >= IndexTimeIntervalNs || sinceLastIndex >= IndexRecordInterval) {
+            m_rebuiltIndex.append(IndexEntry{quint64(indexNs), quint64(pos)});
+            lastIndexedNs = indexNs;
+            sinceLastIndex = 0;
+        }
+        if (rec.kind != RecordKind::Message) {
+            lastKvNs = std::max(rec.timestampNs, lastKvNs);
+            m_rebuiltKvIndex.append(IndexEntry{quint64(lastKvNs), quint64(pos)});
+        }
+        ++sinceLastIndex;
+        pos = nextPos;
+    }
+    m_dataEnd = pos; // drop a torn final record
+    m_index = m_rebuiltIndex.constData();
+    m_indexCount = m_rebuiltIndex.size();
+    m_kvIndex = m_rebuiltKvIndex.constData();
+    m_kvIndexCount = m_rebuiltKvIndex.size();
+    m_recovered = true;
+}
+
+void FeedCaptureReader::rebuildKvIndex()
+{
+    m_rebuiltKvIndex.clear();
+    RecordView rec;
+    qint64 pos = FileHeaderSize;
+    qint64 nextPos = pos;
+    qint64 lastKvNs = 0;
+    while (readRecordAt(pos, rec, nextPos)) {
+        if (rec.kind != RecordKind::Message) {
+            lastKvNs = std::max(rec.timestampNs, lastKvNs);
+            m_rebuiltKvIndex.append(IndexEntry{quint64(lastKvNs), quint64(pos)});
+        }
+        pos = nextPos;
+    }
+    m_kvIndex = m_rebuiltKvIndex.constData();
+    m_kvIndexCount = m_rebuiltKvIndex.size();
+}
+
+bool FeedCaptureReader::next(RecordView &record)
+{
+    qint64 nextPos = m_pos;
+    if (!readRecordAt(m_pos, record, nextPos))
+        return false;
+    m_pos = nextPos;
+    return true;
+}
+
+void FeedCaptureReader::rewind()
+{
+    m_pos = FileHeaderSize;
+}
+
+void FeedCaptureReader::seek(qint64 timestampNs)
+{
+    if (m_indexCount == 0) {
+        m_pos = FileHeaderSize;
+        return;
+    }
+    const IndexEntry *begin = m_index;
+    const IndexEntry *end = m_index + m_indexCount;
+    const IndexEntry *it = std::upper_bound(begin, end, quint64(std::max<qint64>(timestampNs, 0)),
+                                            [](quint64 ts, const IndexEntry &e) { return ts < e.timestampNs; });
+    if (it != begin)
+        --it;
+
+    // At most one index interval of records to skip.
+    qint64 pos = qint64(it->offset);
+    RecordView rec;
+    qint64 nextPos = pos;
+    while (readRecordAt(pos, rec, nextPos) && rec.timestampNs < timestampNs)
+        pos = nextPos;
+    m_pos = pos;
+}
+
+QVector<RecordView> FeedCaptureReader::kvRecordsBefore(qint64 timestampNs) const
+{
+    // KV index timestamps are kept monotonic, so the records before the start point are a prefix of it.
+    const IndexEntry *begin = m_kvIndex;
+    const IndexEntry *end = m_kvIndex + m_kvIndexCount;
+    const IndexEntry *last = std::partition_point(begin, end, [timestampNs](const IndexEntry &e) {
+        return qint64(e.timestampNs) < timestampNs;
+    });
+    QVector<RecordView> records;
+    records.reserve(last - begin);
+    RecordView rec;
+    qint64 nextPos = 0;
+    for (const IndexEntry *it = begin; it != last; ++it) {
+        if (readRecordAt(qint64(it->offset), rec, nextPos) && rec.kind != RecordKind::Message)
+            records.append(rec);
+    }
+    return records;
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QFile>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <atomic>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Recorded feed traffic, append-only with a trailing seek index. All integers little endian.
+//
+//   header  (32 bytes): magic[8], u32 version, u32 reserved, u64 index offset (0 until closed), u64 record count
+//   records (16-byte header + data): u64 timestamp ns, u8 kind, u8 reserved, u16 subject length, u32 payload length,
+//                                    subject bytes, payload bytes
+//   index   (at index offset): magic[8], u64 entry count, then entries of {u64 timestamp ns, u64 file offset}
+//   kv index (right after it, version 3): magic[8], u64 entry count, then one entry per KV record, same layout
+//
+// Index entries are written at least once per second of capture time and every IndexRecordInterval records, in
+// timestamp order. The KV index lists every KV put and delete, so a replay restores the KV state at its start point
+// without reading the messages before it. A file whose writer died has a zero index offset; readers rebuild both
+// indexes by scanning it, as they do the KV index of a version 2 file. For KV records the subject is the KV key (e.g.
+// `m.gs.<id>.mask`).
+namespace FeedCapture
+{
+enum class RecordKind : quint8 {
+    Message = 0,
+    KvPut = 1,
+    KvDelete = 2,
+};
+
+// Points into the reader's mapping; valid until the reader is closed.
+struct RecordView
+{
+    qint64 timestampNs {0};
+    RecordKind kind {RecordKind::Message};
+    QByteArrayView subject;
+    QByteArrayView payload;
+};
+
+struct IndexEntry
+{
+    quint64 timestampNs;
+    quint64 offset;
+};
+
+inline constexpr char Magic[8] = {'E', 'V', 'F', 'E', 'E', 'D', '\0', '\2'};
+inline constexpr char IndexMagic[8] = {'E', 'V', 'I', 'D', 'X', '\0', '\0', '\2'};
+inline constexpr char KvIndexMagic[8] = {'E', 'V', 'K', 'V', 'X', '\0', '\0', '\3'};
+inline constexpr quint32 Version = 3;
+inline constexpr quint32 MinVersion = 2; // no KV index
+inline constexpr int FileHeaderSize = 32;
+inline constexpr int RecordHeaderSize = 16;
+inline constexpr int IndexHeaderSize = 16;
+inline constexpr qint64 IndexTimeIntervalNs = 1000000000;
+inline constexpr int IndexRecordInterval = 4096;
+
+// Wall-clock timestamp used for recorded records.
+qint64 nowNs();
+}
+
+class FeedCaptureWriter
+{
+public:
+    ~FeedCaptureWriter();
+
+    bool open(const QString &fileName);
+    // Writes the seek index and finalises the header.
+    void close();
+    // Lock-free; lets hot paths skip recording without touching the mutex.
+    bool isOpen() const { return m_open.load(std::memory_order_acquire); }
+    QString errorString() const;
+
+    // Thread-safe; NATS callbacks and the KV watcher append concurrently.
+    bool append(qint64 timestampNs, FeedCapture::RecordKind kind, QByteArrayView subject, QByteArrayView payload);
+
+private:
+    mutable QMutex m_mutex;
+    QFile m_file;
+    std::atomic<bool> m_open {false};
+    qint64 m_offset {0};
+    quint64 m_recordCount {0};
+    qint64 m_lastIndexedNs {0};
+    int m_sinceLastIndex {0};
+    QVector<FeedCapture::IndexEntry> m_index;
+    qint64 m_lastKvNs {0};
+    QVector<FeedCapture::IndexEntry> m_kvIndex;
+};
+
+// Memory-maps a capture; opening reads only the header and the index, so size does not matter.
+class FeedCaptureReader
+{
+public:
+    ~FeedCaptureReader();
+
+    bool open(const QString &fileName);
+    void close();
+    QString errorString() const { return m_error; }
+
+    qint64 firstTimestampNs() const { return m_firstNs; }
+    qint64 lastTimestampNs() const { return m_lastNs; }
+    // True when the index was rebuilt by scanning (file not closed cleanly).
+    bool recovered() const { return m_recovered; }
+
+    // Reads the next record without copying; false at the end of the data.
+    bool next(FeedCapture::RecordView &record);
+    void rewind();
+    // Positions at the first record with timestamp >= timestampNs.
+    void seek(qint64 timestampNs);
+    // The KV records before timestampNs, in file order. Found through the KV index; no message is read.
+    QVector<FeedCapture::RecordView> kvRecordsBefore(qint64 timestampNs) const;
+
+private:
+    bool readRecordAt(qint64 offset, FeedCapture::RecordView &record, qint64 &nextOffset) const;
+    bool readIndexAt(quint64 offset, const char (&magic)[8], const FeedCapture::IndexEntry *&entries, qint64 &count,
+                     QVector<FeedCapture::IndexEntry> &converted) const;
+    void rebuildIndex();
+    void rebuildKvIndex();
+
+    QFile m_file;
+    const uchar *m_data {nullptr};
+    qint64 m_dataEnd {0};
+    qint64 m_pos {0};
+    qint64 m_firstNs {0};
+    qint64 m_lastNs {0};
+    bool m_recovered {false};
+    const FeedCapture::IndexEntry *m_index {nullptr}; // into the mapping, or m_rebuiltIndex
+    qint64 m_indexCount {0};
+    QVector<FeedCapture::IndexEntry> m_rebuiltIndex;
+    const FeedCapture::IndexEntry *m_kvIndex {nullptr}; // into the mapping, or m_rebuiltKvIndex
+    qint64 m_kvIndexCount {0};
+    QVector<FeedCapture::IndexEntry> m_rebuiltKvIndex;
+    QString m_error;
+};
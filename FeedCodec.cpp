@@ -0,0 +1,357 @@
+#include "FeedCodec.h"
+
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborParserError>
+#include <QCborValue>
+#include <QDate>
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimeZone>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "PayloadCompression.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+namespace
+{
+QCborValue pick(const QCborMap &m, const std::initializer_list<QCborValue> &keys)
+{
+    for (const auto &k : keys) {
+        auto it = m.constFind(k);
+        if (it != m.constEnd())
+            return it.value();
+    }
+    return QCborValue();
+}
+
+// TLE fields are fixed-column; `len` characters from `pos` (0-based).
+double tleField(QByteArrayView line, int pos, int len, bool &ok)
+{
+    if (line.size() < pos + len) {
+        ok = false;
+        return 0.0;
+    }
+    bool fieldOk = false;
+    const double v = line.mid(pos, len).trimmed().toDouble(&fieldOk);
+    ok = ok && fieldOk;
+    return v;
+}
+
+// Decimal-point-assumed exponential field, e.g. " 28098-4" -> 0.28098e-4.
+double tleExpField(QByteArrayView line, int pos, int len, bool &ok)
+{
+    if (line.size() < pos + len) {
+        ok = false;
+        return 0.0;
+    }
+    QByteArray f = line.mid(pos, len).trimmed().toByteArray();
+    if (f.isEmpty())
+        return 0.0;
+    const bool negative = f.startsWith('-');
+    if (f.startsWith('-') || f.startsWith('+'))
+        f.remove(0, 1);
+    const qsizetype expAt = std::max(f.lastIndexOf('-'), f.lastIndexOf('+'));
+    if (expAt <= 0) {
+        ok = false;
+        return 0.0;
+    }
+    bool mantissaOk = false;
+    bool expOk = false;
+    const double mantissa = QByteArray("0." + f.left(expAt)).toDouble(&mantissaOk);
+    const int exponent = f.mid(expAt).toInt(&expOk);
+    ok = ok && mantissaOk && expOk;
+    return (negative ? -mantissa : mantissa) * std::pow(10.0, exponent);
+}
+
+bool decodeTle(const QByteArray &payload, Sgp4Elements &el)
+{
+    QByteArrayView line1;
+    QByteArrayView line2;
+    for (const QByteArray &raw : payload.split('\n')) {
+        const QByteArrayView line = QByteArrayView(raw).trimmed();
+        if (line.startsWith("1 ") && line.size() >= 64)
+            line1 = line;
+        else if (line.startsWith("2 ") && line.size() >= 63)
+            line2 = line;
+    }
+    if (line1.isEmpty() || line2.isEmpty())
+        return false;
+
+    bool ok = true;
+    const int year2 = int(tleField(line1, 18, 2, ok));
+    const double day = tleField(line1, 20, 12, ok);
+    el.bstar = tleExpField(line1, 53, 8, ok);
+    el.inclinationDeg = tleField(line2, 8, 8, ok);
+    el.raanDeg = tleField(line2, 17, 8, ok);
+    bool eccOk = false;
+    el.eccentricity = QByteArray("0." + line2.mid(26, 7).trimmed().toByteArray()).toDouble(&eccOk);
+    ok = ok && eccOk;
+    el.argPerigeeDeg = tleField(line2, 34, 8, ok);
+    el.meanAnomalyDeg = tleField(line2, 43, 8, ok);
+    el.meanMotionRevDay = tleField(line2, 52, 11, ok);
+    if (!ok)
+        return false;
+
+    // Two-digit years: 57-99 -> 1957-1999, 00-56 -> 2000-2056.
+    const int year = year2 < 57 ? 2000 + year2 : 1900 + year2;
+    el.epochJd = double(QDate(year, 1, 1).toJulianDay()) - 0.5 + (day - 1.0);
+    return true;
+}
+
+bool decodeOmm(const QVariantMap &m, Sgp4Elements &el)
+{
+    auto number = [&](const char *key, double &out) {
+        bool ok = false;
+        out = m.value(QString::fromLatin1(key)).toDouble(&ok);
+        return ok && std::isfinite(out);
+    };
+
+    QDateTime epoch = QDateTime::fromString(m.value(QStringLiteral("EPOCH")).toString(), Qt::ISODateWithMs);
+    if (!epoch.isValid())
+        return false;
+    epoch.setTimeZone(QTimeZone::UTC); // OMM epochs are UTC without a designator
+    el.epochJd = Sgp4Propagator::julianDateFromUnix(epoch.toMSecsSinceEpoch() / 1000.0);
+
+    if (!number("BSTAR", el.bstar))
+        el.bstar = 0.0;
+    return number("MEAN_MOTION", el.meanMotionRevDay) && number("ECCENTRICITY", el.eccentricity)
+        && number("INCLINATION", el.inclinationDeg) && number("RA_OF_ASC_NODE", el.raanDeg)
+        && number("ARG_OF_PERICENTER", el.argPerigeeDeg) && number("MEAN_ANOMALY", el.meanAnomalyDeg);
+}
+}
+
+namespace FeedCodec
+{
+
+static bool decodeCborStates(const QByteArray &payload, QVariantList &sats)
+{
+    sats.clear();
+    QCborParserError err;
+    QCborValue val = QCborValue::fromCbor(payload, &err);
+    if (err.error != QCborError::NoError || !val.isMap())
+        return false;
+    const QCborMap map = val.toMap();
+
+    QCborValue statesVal = pick(map, {QCborValue(1), QCborValue(QStringLiteral("1")), QCborValue(QStringLiteral("States"))});
+    if (!statesVal.isArray())
+        return false;
+
+    for (const QCborValue &entry : statesVal.toArray()) {
+        if (!entry.isMap())
+            continue;
+        const QCborMap m = entry.toMap();
+        auto get = [&](const std::initializer_list<QCborValue> &keys) -> QCborValue {
+            return pick(m, keys);
+        };
+        const QCborValue idVal = get({QCborValue(QStringLiteral("ID")), QCborValue(QStringLiteral("id"))});
+        const double lat = get({QCborValue(QStringLiteral("Lat")), QCborValue(QStringLiteral("lat"))}).toDouble(std::numeric_limits<double>::quiet_NaN());
+        const double lon = get({QCborValue(QStringLiteral("Lon")), QCborValue(QStringLiteral("lon"))}).toDouble(std::numeric_limits<double>::quiet_NaN());
+        const double alt = get({QCborValue(QStringLiteral("Alt")), QCborValue(QStringLiteral("alt"))}).toDouble(std::numeric_limits<double>::quiet_NaN());
+        const double latPast = get({QCborValue(QStringLiteral("LatPast"))}).toDouble(std::numeric_limits<double>::quiet_NaN());
+        const double lonPast = get({QCborValue(QStringLiteral("LonPast"))}).toDouble(std::numeric_limits<double>::quiet_NaN());
+        const double latFuture = get({QCborValue(QStringLiteral("LatFuture"))}).toDouble(std::numeric_limits<double>::quiet_NaN());
+        const double lonFuture = get({QCborValue(QStringLiteral("LonFuture"))}).toDouble(std::numeric_limits<double>::quiet_NaN());
+        if (!std::isfinite(lat) || !std::isfinite(lon))
+            continue;
+        QVariantMap sat;
+        if (!idVal.isUndefined() && !idVal.isNull()) {
+            QVariant idVar = idVal.toVariant();
+            if (idVar.isValid())
+                sat.insert(QStringLiteral("ID"), idVar);
+        }
+        sat.insert(QStringLiteral("Lat"), lat);
+        sat.insert(QStringLiteral("Lon"), lon);
+        if (std::isfinite(alt))
+            sat.insert(QStringLiteral("Alt"), alt);
+        if (std::isfinite(latPast) && std::isfinite(lonPast)) {
+            sat.insert(QStringLiteral("LatPast"), latPast);
+            sat.insert(QStringLiteral("LonPast"), lonPast);
+        }
+        if (std::isfinite(latFuture) && std::isfinite(lonFuture)) {
+            sat.insert(QStringLiteral("LatFuture"), latFuture);
+            sat.insert(QStringLiteral("LonFuture"), lonFuture);
+        }
+        sats.append(sat);
+    }
+
+    return true;
+}
+
+QVariantList decodeStates(const QByteArray &payload)
+{
+    QVariantList sats;
+    decodeCborStates(PayloadCompression::decompressed(payload), sats);
+    return sats;
+}
+
+bool StatesDecoder::decode(const QByteArray &payload, States &states)
+{
+    states.list.clear();
+    states.isColumns = false;
+    if (payload.isEmpty())
+        return true;
+    const QByteArray data = PayloadCompression::decompressed(payload);
+    if (data.isEmpty())
+        return false; // unsupported codec or corrupt compressed frame
+    if (!CompactStates::isCompact(data))
+        return decodeCborStates(data, states.list);
+    states.isColumns = true;
+    return m_compact.decode(data, states.columns);
+}
+
+GroundStation decodeGroundStation(const QByteArray &payload)
+{
+    QCborParserError err;
+    QCborValue val = QCborValue::fromCbor(PayloadCompression::decompressed(payload), &err);
+    if (err.error != QCborError::NoError)
+        return {};
+
+    auto readNumber = [](const QCborMap &m, const std::initializer_list<QCborValue> &keys, double &out) -> bool {
+        for (const auto &k : keys) {
+            auto it = m.constFind(k);
+            if (it != m.constEnd()) {
+                const double v = it->toDouble(std::numeric_limits<double>::quiet_NaN());
+                if (std::isfinite(v)) {
+                    out = v;
+                    return true;
+                }
+            }
+        }
+        return false;
+    };
+
+    auto parsePoint = [&](const QCborValue &v, double &lat, double &lon) -> bool {
+        if (v.isMap()) {
+            const QCborMap m = v.toMap();
+            return readNumber(m, {QCborValue(QStringLiteral("Lat")), QCborValue(QStringLiteral("lat"))}, lat)
+                && readNumber(m, {QCborValue(QStringLiteral("Lon")), QCborValue(QStringLiteral("lon"))}, lon);
+        }
+        if (v.isArray()) {
+            const QCborArray arr = v.toArray();
+            if (arr.size() >= 2) {
+                const double la = arr.at(0).toDouble(std::numeric_limits<double>::quiet_NaN());
+                const double lo = arr.at(1).toDouble(std::numeric_limits<double>::quiet_NaN());
+                if (std::isfinite(la) && std::isfinite(lo)) {
+                    lat = la;
+                    lon = lo;
+                    return true;
+                }
+            }
+        }
+        return false;
+    };
+
+    auto parsePointsArray = [&](const QCborArray &arr) -> QVector<GeoPoint> {
+        QVector<GeoPoint> pts;
+        pts.reserve(arr.size());
+        for (const QCborValue &item : arr) {
+            GeoPoint p;
+            if (parsePoint(item, p.lat, p.lon))
+                pts.append(p);
+        }
+        return pts;
+    };
+
+    GroundStation out;
+    QVector<GeoPoint> &mask = out.mask;
+    double &lat = out.lat;
+    double &lon = out.lon;
+    double &radiusKm = out.radiusKm;
+
+    if (val.isMap()) {
+        const QCborMap m = val.toMap();
+        readNumber(m, {QCborValue(QStringLiteral("Lat")), QCborValue(QStringLiteral("lat"))}, lat);
+        readNumber(m, {QCborValue(QStringLiteral("Lon")), QCborValue(QStringLiteral("lon"))}, lon);
+        readNumber(m, {QCborValue(QStringLiteral("radius_km")), QCborValue(QStringLiteral("RadiusKm")), QCborValue(QStringLiteral("radiusKm")), QCborValue(QStringLiteral("radius"))}, radiusKm);
+
+        auto pick = [&](const std::initializer_list<QCborValue> &keys) -> QCborValue {
+            for (const auto &k : keys) {
+                auto it = m.constFind(k);
+                if (it != m.constEnd())
+                    return it.value();
+            }
+            return QCborValue();
+        };
+
+        auto tryParseMask = [&](const QCborValue &candidate) {
+            if (!candidate.isArray())
+                return;
+            QVector<GeoPoint> pts = parsePointsArray(candidate.toArray());
+            if (!pts.isEmpty())
+                mask = std::move(pts);
+        };
+
+        tryParseMask(pick({QCborValue(QStringLiteral("mask")), QCborValue(QStringLiteral("Mask"))}));
+        if (mask.isEmpty())
+            tryParseMask(pick({QCborValue(QStringLiteral("boundary")), QCborValue(QStringLiteral("Boundary"))}));
+        if (mask.isEmpty())
+            tryParseMask(pick({QCborValue(QStringLiteral("footprint")), QCborValue(QStringLiteral("Footprint"))}));
+        if (mask.isEmpty())
+            tryParseMask(pick({QCborValue(QStringLiteral("points")), QCborValue(QStringLiteral("Points"))}));
+        if (mask.isEmpty() && val.isArray())
+            mask = parsePointsArray(val.toArray());
+    } else if (val.isArray()) {
+        mask = parsePointsArray(val.toArray());
+    }
+
+    out.applyMaskCentroid();
+    return out;
+}
+
+bool groundStationIdFromKey(QStringView key, QString &id)
+{
+    const QStringView prefix = u"m.gs.";
+    const QStringView suffix = u".mask";
+    if (!key.startsWith(prefix) || !key.endsWith(suffix))
+        return false;
+    const QStringView mid = key.mid(prefix.size(), key.size() - prefix.size() - suffix.size());
+    if (mid.isEmpty())
+        return false;
+    id = mid.toString();
+    return true;
+}
+
+bool decodeElements(const QByteArray &rawPayload, Sgp4Elements &elements)
+{
+    const QByteArray payload = PayloadCompression::decompressed(rawPayload);
+    const QByteArrayView text = QByteArrayView(payload).trimmed();
+    if (text.isEmpty())
+        return false;
+
+    Sgp4Elements el;
+    bool ok = false;
+    if (text.front() == '{' || text.front() == '[') {
+        const QJsonDocument doc = QJsonDocument::fromJson(payload);
+        // CelesTrak serves OMM as a one-element JSON array.
+        const QJsonObject obj = doc.isArray() ? doc.array().first().toObject() : doc.object();
+        ok = decodeOmm(obj.toVariantMap(), el);
+    } else if (text.startsWith("1 ") || text.contains("\n1 ")) {
+        ok = decodeTle(payload, el);
+    } else {
+        QCborParserError err;
+        const QCborValue val = QCborValue::fromCbor(payload, &err);
+        ok = err.error == QCborError::NoError && val.isMap() && decodeOmm(val.toMap().toVariantMap(), el);
+    }
+    if (!ok)
+        return false;
+    elements = el;
+    return true;
+}
+
+bool elementIdFromKey(QStringView key, QString &id)
+{
+    const QStringView prefix = u"m.el.";
+    if (!key.startsWith(prefix) || key.size() == prefix.size())
+        return false;
+    id = key.mid(prefix.size()).toString();
+    return true;
+}
+
+} // namespace FeedCodec
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QStringView>
+#include <QVariantList>
+
+#include "CompactStates.h"
+#include "GeoTypes.h"
+#include "Sgp4.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Wire decoding shared by all feed sources, so NATS, replayed and in-process data take the same path. Every decoder
+// accepts zstd/LZ4-compressed payloads transparently (see PayloadCompression.h).
+namespace FeedCodec
+{
+// Decodes an `m.orbit.*` CBOR payload into the satellite list shape EarthView::setSatellites expects.
+QVariantList decodeStates(const QByteArray &payload);
+
+// A decoded state batch: columns for compact frames, which go to the view without a map per object
+// (FeedSource::publishSatelliteStates); the list for CBOR.
+struct States
+{
+    bool isColumns {false};
+    CompactStates::Batch columns;
+    QVariantList list;
+
+    // The list shape either way, for consumers that work on maps (the track history).
+    QVariantList toVariantList() const { return isColumns ? CompactStates::toVariantList(columns) : list; }
+};
+
+// Per-stream state decoder: compact frames (CompactStates.h) are detected by their magic, anything else is decoded
+// as CBOR. Keep one per subject, since compact deltas refer to the stream's previous frame. Not thread-safe.
+class StatesDecoder
+{
+public:
+    // Returns false if the payload cannot be decompressed or parsed, or is a compact delta whose base frame was missed.
+    // A well-formed batch with no objects (and an empty payload) decodes to an empty list and returns true.
+    bool decode(const QByteArray &payload, States &states);
+
+private:
+    CompactStates::Decoder m_compact;
+};
+
+// Decodes a ground-station KV value (CBOR map or bare point array). Invalid payloads yield an invalid station.
+GroundStation decodeGroundStation(const QByteArray &payload);
+
+// Extracts the station ID from a KV key of the form `m.gs.<id>.mask`.
+bool groundStationIdFromKey(QStringView key, QString &id);
+
+// Decodes an element-set KV value: two- or three-line TLE text, or OMM mean elements as a CBOR or JSON map
+// (EPOCH, MEAN_MOTION, ECCENTRICITY, INCLINATION, RA_OF_ASC_NODE, ARG_OF_PERICENTER, MEAN_ANOMALY, BSTAR).
+bool decodeElements(const QByteArray &payload, Sgp4Elements &elements);
+
+// Extracts the object ID from a KV key of the form `m.el.<id>`.
+bool elementIdFromKey(QStringView key, QString &id);
+}
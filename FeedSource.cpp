@@ -0,0 +1,344 @@
+#include "FeedSource.h"
+
+#include <QMetaObject>
+#include <QMutexLocker>
+#include <QStringList>
+#include <algorithm>
+#include <chrono>
+
+#include "FeedCodec.h"
+#include "PayloadCompression.h"
+#include "PropagationWorker.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+namespace
+{
+// Propagated batches are dropped rather than queued when the owner thread falls behind.
+constexpr int MaxPendingPropagatedBatches = 2;
+constexpr int DefaultLatencyWindowMs = 5000;
+
+qint64 steadyNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
+FeedSource::FeedSource(QObject *parent)
+    : QObject(parent)
+{
+    m_latencyTimer.setInterval(DefaultLatencyWindowMs);
+    connect(&m_latencyTimer, &QTimer::timeout, this, &FeedSource::refreshLatencyStats);
+    m_latencyTimer.start();
+}
+
+FeedSource::~FeedSource()
+{
+    clearElements();
+}
+
+void FeedSource::setPropagationRateHz(double hz)
+{
+    if (hz > 0.0)
+        m_propagationRateHz = hz;
+}
+
+void FeedSource::setPropagationTrack(double spanSeconds, double stepSeconds)
+{
+    if (spanSeconds >= 0.0 && stepSeconds > 0.0) {
+        m_trackSpanSeconds = spanSeconds;
+        m_trackStepSeconds = stepSeconds;
+    }
+}
+
+void FeedSource::setTrackHistory(double windowSeconds, double spacingSeconds)
+{
+    m_history.setWindow(qint64(windowSeconds * 1e9), qint64(spacingSeconds * 1e9));
+}
+
+void FeedSource::setLatencyReport(double windowSeconds, bool postStatus)
+{
+    if (windowSeconds > 0.0)
+        m_latencyTimer.setInterval(int(windowSeconds * 1000.0));
+    m_postLatencyStatus = postStatus;
+}
+
+void FeedSource::recordReceipt(const BatchTiming &timing)
+{
+    if (timing.originNs > 0 && timing.receivedNs > 0)
+        m_networkLatency.record(timing.receivedNs - timing.originNs);
+    if (timing.receivedNs > 0 && timing.decodedNs > 0)
+        m_decodeLatency.record(timing.decodedNs - timing.receivedNs);
+}
+
+void FeedSource::publishSatellites(QVariantList satellites, qint64 timestampNs, const BatchTiming &timing)
+{
+    recordReceipt(timing);
+    if (m_history.isEnabled()) {
+        m_history.add(timestampNs > 0 ? timestampNs : LatencyHistogram::nowNs(), satellites);
+        m_history.attach(satellites);
+    }
+    {
+        QMutexLocker locker(&m_propagationMutex);
+        if (m_propagation) {
+            m_propagation->setStreamedStates(std::move(satellites));
+            return;
+        }
+    }
+    queueSatellites(std::move(satellites), timing);
+}
+
+void FeedSource::addHistory(qint64 timestampNs, const QVariantList &satellites)
+{
+    m_history.add(timestampNs, satellites);
+}
+
+void FeedSource::publishSatelliteStates(CompactStates::Batch states, qint64 timestampNs, const BatchTiming &timing)
+{
+    bool asList = m_history.isEnabled();
+    if (!asList) {
+        QMutexLocker locker(&m_propagationMutex);
+        asList = m_propagation != nullptr;
+    }
+    if (asList) {
+        publishSatellites(CompactStates::toVariantList(states), timestampNs, timing);
+        return;
+    }
+    recordReceipt(timing);
+    queueSatelliteStates(std::move(states), timing);
+}
+
+void FeedSource::publishStates(FeedCodec::States states, qint64 timestampNs, const BatchTiming &timing)
+{
+    if (states.isColumns)
+        publishSatelliteStates(std::move(states.columns), timestampNs, timing);
+    else
+        publishSatellites(std::move(states.list), timestampNs, timing);
+}
+
+void FeedSource::completeTiming(BatchTiming &timing)
+{
+    if (timing.decodedNs <= 0)
+        timing.decodedNs = LatencyHistogram::nowNs();
+    if (timing.originNs <= 0)
+        timing.originNs = timing.receivedNs > 0 ? timing.receivedNs : timing.decodedNs;
+}
+
+void FeedSource::recordEmitted(const BatchTiming &timing)
+{
+    m_pendingBatches.fetch_sub(1, std::memory_order_relaxed);
+    const qint64 now = LatencyHistogram::nowNs();
+    m_handoffLatency.record(now - timing.decodedNs);
+    m_feedLatency.record(now - timing.originNs);
+}
+
+void FeedSource::queueSatellites(QVariantList satellites, BatchTiming timing)
+{
+    if (satellites.isEmpty())
+        return;
+    completeTiming(timing);
+    m_pendingBatches.fetch_add(1, std::memory_order_relaxed);
+    QMetaObject::invokeMethod(
+        this,
+        [this, sats = std::move(satellites), timing]() {
+            recordEmitted(timing);
+            emit satellitesUpdated(sats, timing.originNs);
+        },
+        Qt::QueuedConnection);
+}
+
+void FeedSource::queueSatelliteStates(CompactStates::Batch states, BatchTiming timing)
+{
+    if (states.count() == 0)
+        return;
+    completeTiming(timing);
+    m_pendingBatches.fetch_add(1, std::memory_order_relaxed);
+    QMetaObject::invokeMethod(
+        this,
+        [this, states = std::move(states), timing]() {
+            recordEmitted(timing);
+            emit satelliteStatesUpdated(states, timing.originNs);
+        },
+        Qt::QueuedConnection);
+}
+
+void FeedSource::refreshLatencyStats()
+{
+    QVariantMap stats;
+    QStringList parts;
+    const auto summarise = [&](const QString &stage, LatencyHistogram &histogram) {
+        const LatencyHistogram::Summary summary = histogram.take();
+        if (summary.count == 0)
+            return;
+        stats.insert(stage, summary.toVariantMap());
+        parts.append(QStringLiteral("%1 %2").arg(stage, summary.toString()));
+    };
+    summarise(QStringLiteral("network"), m_networkLatency);
+    summarise(QStringLiteral("decode"), m_decodeLatency);
+    summarise(QStringLiteral("handoff"), m_handoffLatency);
+    summarise(QStringLiteral("feed"), m_feedLatency);
+
+    if (stats.isEmpty() && m_latencyStats.isEmpty())
+        return; // idle
+    m_latencyStats = stats;
+    emit latencyStatsChanged();
+    if (m_postLatencyStatus && !parts.isEmpty())
+        emit statusMessage(QStringLiteral("Feed latency: %1; %2 batches dropped").arg(parts.join(QStringLiteral("; "))).arg(droppedBatches()));
+}
+
+void FeedSource::applyKvPut(const QString &key, const QByteArray &payload)
+{
+    warnIfCodecUnavailable(payload);
+    QString id;
+    if (FeedCodec::groundStationIdFromKey(key, id))
+        applyGroundStationPayload(id, payload);
+    else if (FeedCodec::elementIdFromKey(key, id))
+        applyElementPayload(id, payload);
+}
+
+void FeedSource::applyKvDelete(const QString &key)
+{
+    QString id;
+    if (FeedCodec::groundStationIdFromKey(key, id))
+        removeGroundStation(id);
+    else if (FeedCodec::elementIdFromKey(key, id))
+        removeElements(id);
+}
+
+void FeedSource::applyElementPayload(const QString &id, const QByteArray &payload)
+{
+    Sgp4Elements elements;
+    if (!FeedCodec::decodeElements(payload, elements)) {
+        postStatus(QStringLiteral("Unreadable element set for %1").arg(id));
+        return;
+    }
+
+    QMutexLocker locker(&m_propagationMutex);
+    if (!m_propagation) {
+        m_propagation = std::make_unique<PropagationWorker>(
+            [this](QVariantList sats) {
+                if (pendingBatches() < MaxPendingPropagatedBatches)
+                    queueSatellites(std::move(sats), {});
+                else
+                    countDroppedBatch();
+            },
+            [this](const QString &msg) { postStatus(msg); }, [this]() { return feedTimeNs(); });
+        m_propagation->setRateHz(m_propagationRateHz);
+        m_propagation->setTrack(m_trackSpanSeconds, m_trackStepSeconds, std::max(m_trackStepSeconds / 2.0, 1.0));
+    }
+    m_propagation->setElements(id, elements);
+    m_propagation->start();
+}
+
+void FeedSource::removeElements(const QString &id)
+{
+    QMutexLocker locker(&m_propagationMutex);
+    if (m_propagation)
+        m_propagation->removeElements(id);
+}
+
+void FeedSource::clearElements()
+{
+    std::unique_ptr<PropagationWorker> worker;
+    {
+        QMutexLocker locker(&m_propagationMutex);
+        worker = std::move(m_propagation);
+    }
+    if (worker)
+        worker->stop();
+}
+
+void FeedSource::setFeedClock(qint64 timeNs, double rate)
+{
+    QMutexLocker locker(&m_clockMutex);
+    m_hasFeedClock = true;
+    m_feedClockNs = timeNs;
+    m_feedClockSetAt = steadyNs();
+    m_feedClockRate = std::max(rate, 0.0);
+}
+
+qint64 FeedSource::feedTimeNs() const
+{
+    QMutexLocker locker(&m_clockMutex);
+    if (!m_hasFeedClock)
+        return LatencyHistogram::nowNs();
+    return m_feedClockNs + qint64(double(steadyNs() - m_feedClockSetAt) * m_feedClockRate);
+}
+
+void FeedSource::applyGroundStationPayload(const QString &id, const QByteArray &payload)
+{
+    GroundStation station = FeedCodec::decodeGroundStation(payload);
+    if (!station.isValid())
+        return;
+    station.id = id;
+
+    {
+        QMutexLocker locker(&m_groundStationMutex);
+        m_groundStations.insert(id, std::move(station));
+    }
+    publishGroundStations();
+}
+
+void FeedSource::removeGroundStation(const QString &id)
+{
+    {
+        QMutexLocker locker(&m_groundStationMutex);
+        m_groundStations.remove(id);
+    }
+    publishGroundStations();
+}
+
+void FeedSource::clearGroundStations()
+{
+    {
+        QMutexLocker locker(&m_groundStationMutex);
+        m_groundStations.clear();
+    }
+    publishGroundStations();
+}
+
+void FeedSource::replaceGroundStations(const GroundStationList &stations)
+{
+    {
+        QMutexLocker locker(&m_groundStationMutex);
+        m_groundStations.clear();
+        for (const auto &gs : stations) {
+            if (gs.isValid())
+                m_groundStations.insert(gs.id, gs);
+        }
+    }
+    publishGroundStations();
+}
+
+void FeedSource::publishGroundStations()
+{
+    GroundStationList stations;
+    {
+        QMutexLocker locker(&m_groundStationMutex);
+        stations.reserve(m_groundStations.size());
+        for (auto it = m_groundStations.constBegin(); it != m_groundStations.constEnd(); ++it)
+            stations.append(it.value()); // shares the mask arrays, no deep copy
+    }
+
+    QMetaObject::invokeMethod(
+        this,
+        [this, stations = std::move(stations)]() { emit groundStationsUpdated(stations); },
+        Qt::QueuedConnection);
+}
+
+void FeedSource::postStatus(const QString &msg)
+{
+    QMetaObject::invokeMethod(
+        this,
+        [this, msg]() { emit statusMessage(msg); },
+        Qt::QueuedConnection);
+}
+
+void FeedSource::warnIfCodecUnavailable(QByteArrayView payload)
+{
+    const PayloadCompression::Codec codec = PayloadCompression::detect(payload);
+    if (PayloadCompression::isAvailable(codec) || m_warnedUnavailableCodec.exchange(true))
+        return;
+    postStatus(QStringLiteral("Dropping compressed payloads: this build has no %1 support").arg(PayloadCompression::name(codec)));
+}
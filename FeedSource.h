@@ -0,0 +1,149 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QVariantList>
+#include <QVariantMap>
+#include <atomic>
+#include <memory>
+
+#include "CompactStates.h"
+#include "FeedCodec.h"
+#include "GeoTypes.h"
+#include "LatencyHistogram.h"
+#include "TrackHistory.h"
+
+class PropagationWorker;
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Base for everything that feeds satellite and ground-station batches to the view. Sources may produce data on any
+// thread; the publish helpers hand batches to the thread this object lives on, where the signals are emitted.
+class FeedSource : public QObject
+{
+    Q_OBJECT
+    // Per-stage latency over the last window: {network, decode, handoff, feed} -> {count, p50Ms, p99Ms, maxMs}.
+    // Stages without samples in the window are absent.
+    Q_PROPERTY(QVariantMap latencyStats READ latencyStats NOTIFY latencyStatsChanged)
+    // Batches dropped since start: undecodable payloads and propagated batches shed under backlog.
+    Q_PROPERTY(qint64 droppedBatches READ droppedBatches NOTIFY latencyStatsChanged)
+public:
+    // Wall-clock stage timestamps (LatencyHistogram::nowNs) of one streamed batch; zero if unknown.
+    struct BatchTiming
+    {
+        qint64 originNs {0};   // publisher's message time
+        qint64 receivedNs {0}; // arrival at this process
+        qint64 decodedNs {0};
+    };
+
+    explicit FeedSource(QObject *parent = nullptr);
+    ~FeedSource() override;
+
+    virtual void start() = 0;
+    virtual void stop() = 0;
+
+    // Batches handed off but not yet emitted on the owner thread.
+    int pendingBatches() const { return m_pendingBatches.load(std::memory_order_relaxed); }
+
+    // Local SGP4 propagation of objects that arrive as element sets (`m.el.<id>` KV entries). Takes effect the next
+    // time propagation starts, i.e. when the first element set arrives.
+    void setPropagationRateHz(double hz);
+    void setPropagationTrack(double spanSeconds, double stepSeconds);
+
+    // Keeps recent streamed positions per satellite and attaches them as `TrackPast` (0 disables).
+    void setTrackHistory(double windowSeconds, double spacingSeconds);
+
+    QVariantMap latencyStats() const { return m_latencyStats; }
+    qint64 droppedBatches() const { return m_droppedBatches.load(std::memory_order_relaxed); }
+    // Length of the latency window (default 5 s); with `postStatus`, also posts a statusMessage per window.
+    void setLatencyReport(double windowSeconds, bool postStatus);
+
+signals:
+    // `originNs` is the batch's origin time (publisher time if known, else arrival) for end-to-end latency.
+    void satellitesUpdated(const QVariantList &satellites, qint64 originNs);
+    // The same for batches published as columns (publishSatelliteStates); connect both.
+    void satelliteStatesUpdated(const CompactStates::Batch &states, qint64 originNs);
+    void groundStationsUpdated(const GroundStationList &groundStations);
+    void statusMessage(const QString &msg);
+    void latencyStatsChanged();
+
+protected:
+    // Streamed states; merged into the propagated batches while element sets are present. `timestampNs` is the
+    // batch's wall-clock time for the track history (0: now); `timing` feeds the latency stats.
+    void publishSatellites(QVariantList satellites, qint64 timestampNs = 0, const BatchTiming &timing = {});
+    // Columns, handed to the view without a QVariantMap per object. Goes through publishSatellites instead while
+    // element sets are propagated or the track history is on, since both work on the list.
+    void publishSatelliteStates(CompactStates::Batch states, qint64 timestampNs = 0, const BatchTiming &timing = {});
+    // A decoded batch by whichever of the two its encoding produced.
+    void publishStates(FeedCodec::States states, qint64 timestampNs = 0, const BatchTiming &timing = {});
+    void countDroppedBatch() { m_droppedBatches.fetch_add(1, std::memory_order_relaxed); }
+    // Records states in the track history without publishing them (backfill).
+    void addHistory(qint64 timestampNs, const QVariantList &satellites);
+    bool hasTrackHistory() const { return m_history.isEnabled(); }
+
+    // KV bucket entries: `m.gs.<id>.mask` ground-station masks and `m.el.<id>` element sets. Other keys are ignored.
+    void applyKvPut(const QString &key, const QByteArray &payload);
+    void applyKvDelete(const QString &key);
+
+    void applyElementPayload(const QString &id, const QByteArray &payload);
+    void removeElements(const QString &id);
+    // Drops all element sets and stops local propagation.
+    void clearElements();
+    // The time element sets are propagated to: `timeNs` (since the Unix epoch) as of now, then advancing at `rate`
+    // times real time (0 holds it). Replays set it from the recording; until then it is the wall clock.
+    void setFeedClock(qint64 timeNs, double rate);
+    qint64 feedTimeNs() const;
+
+    // KV-style ground-station bookkeeping shared by all sources: each put/delete republishes the full table.
+    void applyGroundStationPayload(const QString &id, const QByteArray &payload);
+    void removeGroundStation(const QString &id);
+    void clearGroundStations();
+    void replaceGroundStations(const GroundStationList &stations);
+    void publishGroundStations();
+
+    // Posts statusMessage from any thread.
+    void postStatus(const QString &msg);
+    // Posts a status message, once per source, if `payload` is compressed with a codec this build lacks. Feed messages
+    // and KV values both call it before decoding, so a missing codec is reported the same way for either.
+    void warnIfCodecUnavailable(QByteArrayView payload);
+
+private:
+    void recordReceipt(const BatchTiming &timing);
+    void queueSatellites(QVariantList satellites, BatchTiming timing);
+    void queueSatelliteStates(CompactStates::Batch states, BatchTiming timing);
+    // Fills in missing stamps before a batch is queued; records the handoff once it is emitted.
+    static void completeTiming(BatchTiming &timing);
+    void recordEmitted(const BatchTiming &timing);
+    void refreshLatencyStats();
+
+    std::atomic<int> m_pendingBatches {0};
+    mutable QMutex m_groundStationMutex;
+    QHash<QString, GroundStation> m_groundStations;
+
+    double m_propagationRateHz {10.0};
+    double m_trackSpanSeconds {2700.0};
+    double m_trackStepSeconds {60.0};
+    mutable QMutex m_propagationMutex;
+    std::unique_ptr<PropagationWorker> m_propagation; // created with the first element set
+    mutable QMutex m_clockMutex;
+    bool m_hasFeedClock {false}; // guarded by m_clockMutex, as are the next three
+    qint64 m_feedClockNs {0};
+    qint64 m_feedClockSetAt {0}; // steady clock, ns
+    double m_feedClockRate {1.0};
+    TrackHistory m_history;
+
+    LatencyHistogram m_networkLatency; // origin -> received
+    LatencyHistogram m_decodeLatency;  // received -> decoded
+    LatencyHistogram m_handoffLatency; // decoded -> emitted on the owner thread
+    LatencyHistogram m_feedLatency;    // origin -> emitted
+    std::atomic<qint64> m_droppedBatches {0};
+    std::atomic<bool> m_warnedUnavailableCodec {false};
+    QVariantMap m_latencyStats;
+    QTimer m_latencyTimer;
+    bool m_postLatencyStatus {false};
+};
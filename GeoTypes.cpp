@@ -0,0 +1,142 @@
+#include "GeoTypes.h"
+
+#include <QVariantList>
+#include <cmath>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+bool GroundStation::isValid() const
+{
+    return std::isfinite(lat) && std::isfinite(lon) && lat >= -90.0 && lat <= 90.0;
+}
+
+void GroundStation::applyMaskCentroid()
+{
+    if ((std::isfinite(lat) && std::isfinite(lon)) || mask.isEmpty())
+        return;
+    double sumLat = 0.0;
+    double sumLon = 0.0;
+    for (const auto &p : mask) {
+        sumLat += p.lat;
+        sumLon += p.lon;
+    }
+    lat = sumLat / mask.size();
+    lon = sumLon / mask.size();
+}
+
+QVariantMap GroundStation::toVariantMap() const
+{
+    QVariantMap out = extra;
+    if (!id.isEmpty()) {
+        out.insert(QStringLiteral("id"), id);
+        out.insert(QStringLiteral("ID"), id);
+    }
+    out.insert(QStringLiteral("Lat"), lat);
+    out.insert(QStringLiteral("Lon"), lon);
+    if (std::isfinite(radiusKm))
+        out.insert(QStringLiteral("RadiusKm"), radiusKm);
+    if (!mask.isEmpty()) {
+        QVariantList maskVar;
+        maskVar.reserve(mask.size());
+        for (const auto &p : mask) {
+            QVariantMap point;
+            point.insert(QStringLiteral("Lat"), p.lat);
+            point.insert(QStringLiteral("Lon"), p.lon);
+            maskVar.append(point);
+        }
+        out.insert(QStringLiteral("Mask"), maskVar);
+    }
+    return out;
+}
+
+namespace
+{
+bool readField(const QVariantMap &map, const std::initializer_list<const char *> &keys, double &out)
+{
+    for (const char *k : keys) {
+        bool ok = false;
+        double val = map.value(QString::fromLatin1(k)).toDouble(&ok);
+        if (ok && std::isfinite(val)) {
+            out = val;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parsePoint(const QVariant &v, GeoPoint &out)
+{
+    if (v.canConvert<QVariantMap>()) {
+        const QVariantMap pm = v.toMap();
+        double lat = 0.0;
+        double lon = 0.0;
+        if (readField(pm, {"lat", "Lat"}, lat) && readField(pm, {"lon", "Lon"}, lon)) {
+            out.lat = lat;
+            out.lon = lon;
+            return true;
+        }
+    }
+    if (v.canConvert<QVariantList>()) {
+        const QVariantList arr = v.toList();
+        if (arr.size() >= 2) {
+            bool okLat = false;
+            bool okLon = false;
+            const double lat = arr.at(0).toDouble(&okLat);
+            const double lon = arr.at(1).toDouble(&okLon);
+            if (okLat && okLon && std::isfinite(lat) && std::isfinite(lon)) {
+                out.lat = lat;
+                out.lon = lon;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+}
+
+QVector<GeoPoint> geoPointsFromVariant(const QVariant &v)
+{
+    if (!v.isValid())
+        return {};
+    if (v.metaType() == QMetaType::fromType<QVector<GeoPoint>>())
+        return v.value<QVector<GeoPoint>>();
+
+    QVector<GeoPoint> pts;
+    const QVariantList list = v.toList();
+    pts.reserve(list.size());
+    for (const QVariant &pVar : list) {
+        GeoPoint p;
+        if (parsePoint(pVar, p))
+            pts.append(p);
+    }
+    return pts;
+}
+
+GroundStation GroundStation::fromVariantMap(const QVariantMap &m)
+{
+    GroundStation gs;
+    readField(m, {"lat", "Lat"}, gs.lat);
+    readField(m, {"lon", "Lon"}, gs.lon);
+    readField(m, {"radius_km", "RadiusKm", "radiusKm", "radius", "Radius"}, gs.radiusKm);
+    gs.mask = geoPointsFromVariant(m.value(QStringLiteral("mask"), m.value(QStringLiteral("Mask"))));
+    if (gs.mask.isEmpty())
+        gs.mask = geoPointsFromVariant(m.value(QStringLiteral("boundary")));
+    if (gs.mask.isEmpty())
+        gs.mask = geoPointsFromVariant(m.value(QStringLiteral("footprint")));
+    if (gs.mask.isEmpty())
+        gs.mask = geoPointsFromVariant(m.value(QStringLiteral("points")));
+    gs.applyMaskCentroid();
+
+    const QVariant idVar = m.value(QStringLiteral("id"), m.value(QStringLiteral("ID")));
+    if (idVar.isValid())
+        gs.id = idVar.toString();
+
+    // Keep only the attributes the typed fields don't already carry.
+    static const char *const consumed[] = {"lat", "Lat", "lon", "Lon", "radius_km", "RadiusKm", "radiusKm", "radius",
+                                           "Radius", "mask", "Mask", "boundary", "footprint", "points", "id", "ID"};
+    gs.extra = m;
+    for (const char *k : consumed)
+        gs.extra.remove(QString::fromLatin1(k));
+    return gs;
+}
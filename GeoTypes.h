@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QMetaType>
+#include <QString>
+#include <QVariant>
+#include <QVariantMap>
+#include <QVector>
+#include <limits>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+struct GeoPoint
+{
+    double lat {0.0};
+    double lon {0.0};
+};
+
+// Point list from a QVariant holding QVector<GeoPoint>, or a list of [lat, lon] pairs / {Lat, Lon} maps.
+QVector<GeoPoint> geoPointsFromVariant(const QVariant &v);
+
+// Plain ground-station record shared by feeds and EarthView. Feeds fill it directly from their wire format and hand
+// it over by value; QVariant maps are only built when QML asks for details of a single station.
+struct GroundStation
+{
+    QString id;
+    double lat {std::numeric_limits<double>::quiet_NaN()};
+    double lon {std::numeric_limits<double>::quiet_NaN()};
+    double radiusKm {std::numeric_limits<double>::quiet_NaN()};
+    QVector<GeoPoint> mask;
+    QVariantMap extra; // attributes not covered above (only populated by the QVariant input path)
+
+    bool isValid() const;
+    // If no position was given, use the centroid of the mask.
+    void applyMaskCentroid();
+    QVariantMap toVariantMap() const;
+
+    static GroundStation fromVariantMap(const QVariantMap &m);
+};
+
+using GroundStationList = QVector<GroundStation>;
+
+Q_DECLARE_METATYPE(GeoPoint)
+Q_DECLARE_METATYPE(GroundStation)
+Q_DECLARE_METATYPE(GroundStationList)
@@ -0,0 +1,66 @@
+#include "InProcessFeedSource.h"
+
+#include <QMutexLocker>
+
+#include "FeedCodec.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+InProcessFeedSource::InProcessFeedSource(QObject *parent)
+    : FeedSource(parent)
+{
+}
+
+void InProcessFeedSource::start()
+{
+    m_running = true;
+}
+
+void InProcessFeedSource::stop()
+{
+    m_running = false;
+    clearGroundStations();
+    clearElements();
+}
+
+void InProcessFeedSource::pushMessage(const QByteArray &payload)
+{
+    if (!m_running)
+        return;
+    warnIfCodecUnavailable(payload);
+    FeedCodec::States states;
+    bool decoded = false;
+    {
+        QMutexLocker locker(&m_decoderMutex);
+        decoded = m_decoder.decode(payload, states);
+    }
+    if (decoded)
+        publishStates(std::move(states));
+    else
+        countDroppedBatch();
+}
+
+void InProcessFeedSource::pushKvEntry(const QString &key, const QByteArray &payload)
+{
+    if (m_running)
+        applyKvPut(key, payload);
+}
+
+void InProcessFeedSource::pushKvDelete(const QString &key)
+{
+    if (m_running)
+        applyKvDelete(key);
+}
+
+void InProcessFeedSource::pushSatellites(QVariantList satellites)
+{
+    if (m_running)
+        publishSatellites(std::move(satellites));
+}
+
+void InProcessFeedSource::pushGroundStations(GroundStationList stations)
+{
+    if (m_running)
+        replaceGroundStations(stations);
+}
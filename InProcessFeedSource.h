@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QByteArray>
+#include <QMutex>
+#include <QString>
+#include <atomic>
+
+#include "FeedCodec.h"
+#include "FeedSource.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Source fed directly by code in the same process (load generators, tests). All push methods are thread-safe and
+// are ignored while the source is stopped.
+class InProcessFeedSource : public FeedSource
+{
+    Q_OBJECT
+public:
+    explicit InProcessFeedSource(QObject *parent = nullptr);
+
+    void start() override;
+    void stop() override;
+
+    // Raw wire payloads go through the same decoders as the NATS feed.
+    void pushMessage(const QByteArray &payload);
+    // KV entries by key: `m.gs.<id>.mask` masks or `m.el.<id>` element sets.
+    void pushKvEntry(const QString &key, const QByteArray &payload);
+    void pushKvDelete(const QString &key);
+
+    // Pre-decoded batches skip the wire format entirely.
+    void pushSatellites(QVariantList satellites);
+    void pushGroundStations(GroundStationList stations);
+
+private:
+    std::atomic<bool> m_running {false};
+    QMutex m_decoderMutex;
+    FeedCodec::StatesDecoder m_decoder; // pushMessage payloads form one stream
+};
@@ -0,0 +1,92 @@
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+namespace
+{
+// Upper bound of a bucket in nanoseconds.
+double bucketLimitNs(int bucket)
+{
+    return 1000.0 * std::exp2(double(bucket) / 4.0);
+}
+}
+
+QVariantMap LatencyHistogram::Summary::toVariantMap() const
+{
+    return {
+        {QStringLiteral("count"), count},
+        {QStringLiteral("p50Ms"), p50Ms},
+        {QStringLiteral("p99Ms"), p99Ms},
+        {QStringLiteral("maxMs"), maxMs},
+    };
+}
+
+LatencyHistogram::Summary LatencyHistogram::Summary::fromVariantMap(const QVariantMap &map)
+{
+    Summary s;
+    s.count = map.value(QStringLiteral("count")).toLongLong();
+    s.p50Ms = map.value(QStringLiteral("p50Ms")).toDouble();
+    s.p99Ms = map.value(QStringLiteral("p99Ms")).toDouble();
+    s.maxMs = map.value(QStringLiteral("maxMs")).toDouble();
+    return s;
+}
+
+QString LatencyHistogram::Summary::toString() const
+{
+    return QStringLiteral("p50 %1 / p99 %2 / max %3 ms (n=%4)")
+        .arg(p50Ms, 0, 'f', 2)
+        .arg(p99Ms, 0, 'f', 2)
+        .arg(maxMs, 0, 'f', 2)
+        .arg(count);
+}
+
+void LatencyHistogram::record(qint64 ns)
+{
+    ns = std::max<qint64>(ns, 0);
+    int bucket = 0;
+    if (ns >= 1000)
+        bucket = std::min(int(std::log2(double(ns) / 1000.0) * BucketsPerOctave) + 1, BucketCount - 1);
+    m_buckets[size_t(bucket)].fetch_add(1, std::memory_order_relaxed);
+
+    qint64 max = m_maxNs.load(std::memory_order_relaxed);
+    while (ns > max && !m_maxNs.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+    }
+}
+
+LatencyHistogram::Summary LatencyHistogram::take()
+{
+    std::array<quint32, BucketCount> counts;
+    Summary s;
+    for (int i = 0; i < BucketCount; ++i) {
+        counts[size_t(i)] = m_buckets[size_t(i)].exchange(0, std::memory_order_relaxed);
+        s.count += counts[size_t(i)];
+    }
+    const double maxMs = double(m_maxNs.exchange(0, std::memory_order_relaxed)) / 1e6;
+    if (s.count == 0)
+        return s;
+
+    const auto percentile = [&](double fraction) {
+        const qint64 rank = std::max<qint64>(qint64(std::ceil(fraction * double(s.count))), 1);
+        qint64 seen = 0;
+        for (int i = 0; i < BucketCount; ++i) {
+            seen += counts[size_t(i)];
+            if (seen >= rank)
+                return std::min(bucketLimitNs(i) / 1e6, maxMs);
+        }
+        return maxMs;
+    };
+    s.p50Ms = percentile(0.50);
+    s.p99Ms = percentile(0.99);
+    s.maxMs = maxMs;
+    return s;
+}
+
+qint64 LatencyHistogram::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QString>
+#include <QVariantMap>
+#include <QtGlobal>
+#include <array>
+#include <atomic>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Latency histogram for hot paths: log-spaced buckets (four per octave, 1 us to about 70 s), recorded with relaxed
+// atomics from any thread. `take()` summarises and resets, so each summary covers one reporting window. Percentiles
+// are bucket upper bounds, i.e. accurate to about 19%.
+class LatencyHistogram
+{
+public:
+    struct Summary
+    {
+        qint64 count {0};
+        double p50Ms {0.0};
+        double p99Ms {0.0};
+        double maxMs {0.0};
+
+        // {count, p50Ms, p99Ms, maxMs}
+        QVariantMap toVariantMap() const;
+        static Summary fromVariantMap(const QVariantMap &map);
+        // "p50 1.20 / p99 4.76 / max 9.01 ms (n=120)"
+        QString toString() const;
+    };
+
+    // Negative latencies (clock skew between hosts) count as zero.
+    void record(qint64 ns);
+    Summary take();
+
+    // Wall-clock nanoseconds since the epoch: the clock every stage timestamp is taken on.
+    static qint64 nowNs();
+
+private:
+    static constexpr int BucketsPerOctave = 4;
+    static constexpr int BucketCount = 26 * BucketsPerOctave + 2; // [0, 1 us), log buckets, overflow
+
+    std::array<std::atomic<quint32>, BucketCount> m_buckets {};
+    std::atomic<qint64> m_maxNs {0};
+};
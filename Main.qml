@@ -144,6 +144,29 @@ ApplicationWindow {
                 }
             }
 
+            Label {
+                text: "Zoom"
+            }
+
+            Slider {
+                id: zoomSlider
+                from: 1
+                to: 16
+                value: earth.zoom
+                onValueChanged: earth.zoom = value
+                Layout.preferredWidth: 120
+            }
+
+            Slider {
+                id: latSlider
+                from: -90
+                to: 90
+                value: earth.centerLatitude
+                enabled: earth.zoom > 1
+                onValueChanged: earth.centerLatitude = value
+                Layout.preferredWidth: 80
+            }
+
             CheckBox {
                 id: fitWorld
                 text: "Fit"
@@ -0,0 +1,101 @@
+#include "OffscreenRenderer.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QQuickItem>
+#include <QQuickRenderControl>
+#include <QQuickRenderTarget>
+#include <QQuickWindow>
+#include <QSGRendererInterface>
+#include <rhi/qrhi.h>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+OffscreenRenderer::OffscreenRenderer()
+    : m_control(std::make_unique<QQuickRenderControl>())
+    , m_window(std::make_unique<QQuickWindow>(m_control.get()))
+{
+}
+
+OffscreenRenderer::~OffscreenRenderer()
+{
+    // Items and their nodes go with the window; textures they released with deleteLater, then the render target,
+    // must go while the render control's QRhi still exists.
+    m_window.reset();
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    m_texture.reset();
+    m_control.reset();
+}
+
+bool OffscreenRenderer::setSize(const QSize &size)
+{
+    if (m_texture && m_texture->pixelSize() == size)
+        return true;
+    if (size.isEmpty()) {
+        m_error = QStringLiteral("Empty render target size");
+        return false;
+    }
+    if (!m_initialized) {
+        if (QQuickWindow::graphicsApi() == QSGRendererInterface::Software) {
+            m_error = QStringLiteral("Offscreen rendering needs an RHI backend; the software scene graph does not draw "
+                                     "EarthView's layers");
+            return false;
+        }
+        if (!m_control->initialize()) {
+            m_error = QStringLiteral("Render control initialisation failed");
+            return false;
+        }
+        m_initialized = true;
+    }
+
+    m_window->setGeometry(QRect(QPoint(0, 0), size));
+    m_window->contentItem()->setSize(size);
+    m_window->setRenderTarget(QQuickRenderTarget()); // drop the old texture before it is deleted
+    m_texture.reset(m_control->rhi()->newTexture(QRhiTexture::RGBA8, size, 1,
+                                                 QRhiTexture::RenderTarget | QRhiTexture::UsedAsTransferSource));
+    if (!m_texture->create()) {
+        m_texture.reset();
+        m_error = QStringLiteral("Cannot create a %1x%2 render target").arg(size.width()).arg(size.height());
+        return false;
+    }
+    // The depth-stencil buffer is created and managed by the window.
+    m_window->setRenderTarget(QQuickRenderTarget::fromRhiTexture(m_texture.get()));
+    return true;
+}
+
+bool OffscreenRenderer::renderFrame(bool readback, FrameTimes *times)
+{
+    if (!m_texture) {
+        if (m_error.isEmpty())
+            m_error = QStringLiteral("No render target; call setSize() first");
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    m_control->polishItems();
+    m_control->beginFrame();
+    m_control->sync();
+    const qint64 syncNs = timer.nsecsElapsed();
+    m_control->render();
+    QRhiReadbackResult result; // filled when endFrame() completes the frame
+    if (readback) {
+        QRhiResourceUpdateBatch *batch = m_control->rhi()->nextResourceUpdateBatch();
+        batch->readBackTexture(m_texture.get(), &result);
+        m_control->commandBuffer()->resourceUpdate(batch);
+    }
+    m_control->endFrame(); // offscreen frames are waited for
+    if (times) {
+        times->syncNs = syncNs;
+        times->renderNs = timer.nsecsElapsed() - syncNs;
+    }
+
+    if (readback) {
+        const QImage wrapper(reinterpret_cast<const uchar *>(result.data.constData()), result.pixelSize.width(),
+                             result.pixelSize.height(), QImage::Format_RGBA8888_Premultiplied);
+        m_image = m_control->rhi()->isYUpInFramebuffer() ? wrapper.mirrored() : wrapper.copy();
+    }
+    return true;
+}
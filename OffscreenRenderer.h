@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QImage>
+#include <QSize>
+#include <QString>
+#include <QtGlobal>
+#include <memory>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+class QQuickRenderControl;
+class QQuickWindow;
+class QRhiTexture;
+
+// A QQuickWindow rendered through QQuickRenderControl into an RHI texture, read back into a QImage on request; the
+// shared offscreen path of EarthSnapshotRenderer, the render harness and the benchmarks. Uses the default RHI backend
+// (on a headless Linux server: QT_QPA_PLATFORM=offscreen and OpenGL through Mesa llvmpipe; QSG_RHI_BACKEND picks
+// another). The software scene graph is rejected, since it skips the geometry nodes EarthView draws its layers with.
+// GUI thread only.
+class OffscreenRenderer
+{
+public:
+    OffscreenRenderer();
+    ~OffscreenRenderer();
+
+    // Put items under window()->contentItem().
+    QQuickWindow *window() const { return m_window.get(); }
+    QString errorString() const { return m_error; }
+
+    // Resizes the window and its render target, initialising the render control on first use. False on failure.
+    bool setSize(const QSize &size);
+
+    struct FrameTimes
+    {
+        qint64 syncNs {0};   // polish and sync (updatePaintNode)
+        qint64 renderNs {0}; // recording, submission and the wait for the GPU
+    };
+    // Renders one frame and waits for it to complete; with `readback` the result is copied into image() as well.
+    bool renderFrame(bool readback, FrameTimes *times = nullptr);
+    // The last frame read back, premultiplied RGBA, top row first.
+    const QImage &image() const { return m_image; }
+
+private:
+    std::unique_ptr<QQuickRenderControl> m_control;
+    std::unique_ptr<QQuickWindow> m_window;
+    std::unique_ptr<QRhiTexture> m_texture;
+    QImage m_image;
+    QString m_error;
+    bool m_initialized {false};
+};
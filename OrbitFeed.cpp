@@ -1,20 +1,36 @@
 #include "OrbitFeed.h"
 
-#include <QCborValue>
-#include <QCborMap>
-#include <QCborArray>
-#include <QCborParserError>
 #include <QByteArray>
-#include <QMetaObject>
 #include <QMutexLocker>
-#include <cmath>
-#include <limits>
+#include <algorithm>
+#include <chrono>
+
+#include "FeedCodec.h"
 
 // Copyright (c) 2026 Andy Armitage
 // This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
 
+namespace
+{
+constexpr int BackfillBatchSize = 1024;
+constexpr int BackfillFetchTimeoutMs = 2000;
+constexpr qint64 BackfillInactiveThresholdNs = 30000000000;
+// Optional message header with the publisher's send time (decimal wall-clock ns), for end-to-end latency.
+constexpr char SentTimeHeader[] = "Ev-Sent-Ns";
+
+qint64 publisherTimeNs(natsMsg *msg)
+{
+    const char *value = nullptr;
+    if (natsMsgHeader_Get(msg, SentTimeHeader, &value) != NATS_OK || !value)
+        return 0;
+    bool ok = false;
+    const qint64 ns = QByteArray(value).toLongLong(&ok);
+    return ok && ns > 0 ? ns : 0;
+}
+}
+
 OrbitFeed::OrbitFeed(QObject *parent)
-    : QObject(parent)
+    : FeedSource(parent)
 {
 }
 
@@ -23,19 +39,40 @@ OrbitFeed::~OrbitFeed()
     stop();
 }
 
+void OrbitFeed::setUrl(const QString &url)
+{
+    m_url = url;
+}
+
 void OrbitFeed::setSubject(const QString &subject)
 {
     m_subject = subject;
 }
 
+void OrbitFeed::setKvBucket(const QString &bucket)
+{
+    m_kvBucket = bucket;
+}
+
+void OrbitFeed::setBackfillMinutes(double minutes)
+{
+    m_backfillMinutes = std::max(minutes, 0.0);
+}
+
+void OrbitFeed::setBackfillStream(const QString &stream)
+{
+    m_backfillStream = stream;
+}
+
 void OrbitFeed::start()
 {
     if (m_conn)
         return;
 
+    const QByteArray urlUtf8 = m_url.isEmpty() ? QByteArrayLiteral("nats://127.0.0.1:4222") : m_url.toUtf8();
     const QByteArray subjUtf8 = m_subject.isEmpty() ? QByteArrayLiteral("m.orbit.*") : m_subject.toUtf8();
 
-    natsStatus s = natsConnection_ConnectTo(&m_conn, "nats://127.0.0.1:4222");
+    natsStatus s = natsConnection_ConnectTo(&m_conn, urlUtf8.constData());
     if (s != NATS_OK) {
         emit statusMessage(QStringLiteral("NATS connect failed: %1").arg(QString::fromLatin1(natsStatus_GetText(s))));
         disconnect();
@@ -49,7 +86,8 @@ void OrbitFeed::start()
         return;
     }
 
-    startGroundStationWatcher();
+    startKvWatcher();
+    startBackfill();
 
     emit statusMessage(QStringLiteral("Subscribed to %1").arg(QString::fromUtf8(subjUtf8)));
 }
@@ -57,15 +95,33 @@ void OrbitFeed::start()
 void OrbitFeed::stop()
 {
     disconnect();
+    stopRecording();
+}
+
+bool OrbitFeed::startRecording(const QString &fileName)
+{
+    if (!m_recorder.open(fileName)) {
+        emit statusMessage(QStringLiteral("Recording to %1 failed: %2").arg(fileName, m_recorder.errorString()));
+        return false;
+    }
+    emit statusMessage(QStringLiteral("Recording to %1").arg(fileName));
+    return true;
+}
+
+void OrbitFeed::stopRecording()
+{
+    m_recorder.close();
 }
 
 void OrbitFeed::disconnect()
 {
-    stopGroundStationWatcher();
+    stopBackfill();
+    stopKvWatcher();
     if (m_sub) {
         natsSubscription_Destroy(m_sub);
         m_sub = nullptr;
     }
+    m_decoders.clear();
     if (m_js) {
         jsCtx_Destroy(m_js);
         m_js = nullptr;
@@ -74,7 +130,7 @@ void OrbitFeed::disconnect()
         kvStore_Destroy(m_kv);
         m_kv = nullptr;
     }
-    // Watcher is destroyed by stopGroundStationWatcher.
+    // Watcher is destroyed by stopKvWatcher.
     if (m_conn) {
         natsConnection_Destroy(m_conn);
         m_conn = nullptr;
@@ -95,80 +151,169 @@ void OrbitFeed::handleMessage(natsMsg *msg)
     if (!msg)
         return;
 
-    QByteArray payload(reinterpret_cast<const char *>(natsMsg_GetData(msg)), natsMsg_GetDataLength(msg));
-    QCborParserError err;
-    QCborValue val = QCborValue::fromCbor(payload, &err);
-    if (err.error != QCborError::NoError || !val.isMap()) {
-        natsMsg_Destroy(msg);
+    BatchTiming timing;
+    timing.receivedNs = LatencyHistogram::nowNs();
+    timing.originNs = publisherTimeNs(msg);
+    const QByteArray payload = QByteArray::fromRawData(natsMsg_GetData(msg), natsMsg_GetDataLength(msg));
+    if (m_recorder.isOpen())
+        m_recorder.append(timing.receivedNs, FeedCapture::RecordKind::Message, natsMsg_GetSubject(msg), payload);
+    warnIfCodecUnavailable(payload);
+    FeedCodec::States states;
+    const bool decoded = decoderFor(natsMsg_GetSubject(msg)).decode(payload, states);
+    timing.decodedNs = LatencyHistogram::nowNs();
+    if (!decoded) {
+        countDroppedBatch();
+    } else {
+        QMutexLocker locker(&m_publishMutex);
+        ++m_livePublished;
+        publishStates(std::move(states), timing.originNs, timing);
+    }
+    natsMsg_Destroy(msg);
+}
+
+FeedCodec::StatesDecoder &OrbitFeed::decoderFor(const char *subject)
+{
+    const QByteArray key = QByteArray::fromRawData(subject, qsizetype(qstrlen(subject)));
+    auto it = m_decoders.find(key);
+    if (it == m_decoders.end())
+        it = m_decoders.insert(QByteArray(subject), FeedCodec::StatesDecoder());
+    return it.value();
+}
+
+void OrbitFeed::startBackfill()
+{
+    if (!m_conn || m_backfillMinutes <= 0.0 || m_backfillThread.joinable())
         return;
+    if (!hasTrackHistory())
+        setTrackHistory(m_backfillMinutes * 60.0, 10.0);
+    {
+        QMutexLocker locker(&m_publishMutex);
+        m_livePublished = 0;
     }
-    const QCborMap map = val.toMap();
+    m_backfillRunning = true;
+    const qint64 liveStartNs = FeedCapture::nowNs();
+    m_backfillThread = std::thread([this, liveStartNs]() { runBackfill(liveStartNs); });
+}
 
-    auto pick = [&](const QCborMap &m, const std::initializer_list<QCborValue> &keys) -> QCborValue {
-        for (const auto &k : keys) {
-            auto it = m.constFind(k);
-            if (it != m.constEnd())
-                return it.value();
-        }
-        return QCborValue();
-    };
+void OrbitFeed::stopBackfill()
+{
+    m_backfillRunning = false;
+    if (m_backfillThread.joinable())
+        m_backfillThread.join();
+}
+
+void OrbitFeed::runBackfill(qint64 liveStartNs)
+{
+    const auto started = std::chrono::steady_clock::now();
+    const QByteArray subjUtf8 = m_subject.isEmpty() ? QByteArrayLiteral("m.orbit.*") : m_subject.toUtf8();
+    const QByteArray streamUtf8 = m_backfillStream.toUtf8();
 
-    QCborValue statesVal = pick(map, {QCborValue(1), QCborValue(QStringLiteral("1")), QCborValue(QStringLiteral("States"))});
-    if (!statesVal.isArray()) {
-        natsMsg_Destroy(msg);
+    jsCtx *js = nullptr;
+    jsOptions jsOpts;
+    jsOptions_Init(&jsOpts);
+    natsStatus s = natsConnection_JetStream(&js, m_conn, &jsOpts);
+    if (s != NATS_OK) {
+        postStatus(QStringLiteral("Backfill: JetStream init failed: %1").arg(QString::fromLatin1(natsStatus_GetText(s))));
+        m_backfillRunning = false;
         return;
     }
 
-    QVariantList sats;
-    for (const QCborValue &entry : statesVal.toArray()) {
-        if (!entry.isMap())
-            continue;
-        const QCborMap m = entry.toMap();
-        auto get = [&](const std::initializer_list<QCborValue> &keys) -> QCborValue {
-            return pick(m, keys);
-        };
-        const QCborValue idVal = get({QCborValue(QStringLiteral("ID")), QCborValue(QStringLiteral("id"))});
-        const double lat = get({QCborValue(QStringLiteral("Lat")), QCborValue(QStringLiteral("lat"))}).toDouble(std::numeric_limits<double>::quiet_NaN());
-        const double lon = get({QCborValue(QStringLiteral("Lon")), QCborValue(QStringLiteral("lon"))}).toDouble(std::numeric_limits<double>::quiet_NaN());
-        const double alt = get({QCborValue(QStringLiteral("Alt")), QCborValue(QStringLiteral("alt"))}).toDouble(std::numeric_limits<double>::quiet_NaN());
-        const double latPast = get({QCborValue(QStringLiteral("LatPast"))}).toDouble(std::numeric_limits<double>::quiet_NaN());
-        const double lonPast = get({QCborValue(QStringLiteral("LonPast"))}).toDouble(std::numeric_limits<double>::quiet_NaN());
-        const double latFuture = get({QCborValue(QStringLiteral("LatFuture"))}).toDouble(std::numeric_limits<double>::quiet_NaN());
-        const double lonFuture = get({QCborValue(QStringLiteral("LonFuture"))}).toDouble(std::numeric_limits<double>::quiet_NaN());
-        if (!std::isfinite(lat) || !std::isfinite(lon))
-            continue;
-        QVariantMap sat;
-        if (!idVal.isUndefined() && !idVal.isNull()) {
-            QVariant idVar = idVal.toVariant();
-            if (idVar.isValid())
-                sat.insert(QStringLiteral("ID"), idVar);
-        }
-        sat.insert(QStringLiteral("Lat"), lat);
-        sat.insert(QStringLiteral("Lon"), lon);
-        if (std::isfinite(alt))
-            sat.insert(QStringLiteral("Alt"), alt);
-        if (std::isfinite(latPast) && std::isfinite(lonPast)) {
-            sat.insert(QStringLiteral("LatPast"), latPast);
-            sat.insert(QStringLiteral("LonPast"), lonPast);
+    // Ephemeral pull consumer starting at the beginning of the window; the server drops it when we go away.
+    jsSubOptions so;
+    jsSubOptions_Init(&so);
+    if (!streamUtf8.isEmpty())
+        so.Stream = streamUtf8.constData();
+    so.Config.DeliverPolicy = js_DeliverByStartTime;
+    so.Config.OptStartTime = liveStartNs - qint64(m_backfillMinutes * 60.0 * 1e9);
+    so.Config.AckPolicy = js_AckNone;
+    so.Config.InactiveThreshold = BackfillInactiveThresholdNs;
+
+    natsSubscription *sub = nullptr;
+    jsErrCode jerr = jsErrCode(0);
+    s = js_PullSubscribe(&sub, js, subjUtf8.constData(), nullptr, &jsOpts, &so, &jerr);
+    if (s != NATS_OK) {
+        postStatus(QStringLiteral("Backfill: pull subscribe failed: %1").arg(QString::fromLatin1(natsStatus_GetText(s))));
+        jsCtx_Destroy(js);
+        m_backfillRunning = false;
+        return;
+    }
+
+    // Backfilled batches are their own streams as far as compact deltas are concerned.
+    QHash<QByteArray, FeedCodec::StatesDecoder> decoders;
+    QVariantList latest;
+    qint64 latestNs = 0;
+    qint64 messages = 0;
+    qint64 states = 0;
+    qint64 unstamped = 0;
+    bool done = false;
+    while (!done && m_backfillRunning) {
+        natsMsgList list {};
+        s = natsSubscription_Fetch(&list, sub, BackfillBatchSize, BackfillFetchTimeoutMs, &jerr);
+        if (s == NATS_TIMEOUT)
+            break; // nothing (more) in the window
+        if (s != NATS_OK) {
+            postStatus(QStringLiteral("Backfill: fetch failed: %1").arg(QString::fromLatin1(natsStatus_GetText(s))));
+            break;
         }
-        if (std::isfinite(latFuture) && std::isfinite(lonFuture)) {
-            sat.insert(QStringLiteral("LatFuture"), latFuture);
-            sat.insert(QStringLiteral("LonFuture"), lonFuture);
+        for (int i = 0; i < list.Count && !done; ++i) {
+            natsMsg *msg = list.Msgs[i];
+            // Without metadata there is no stream timestamp to place the batch in the history; skip it.
+            jsMsgMetaData *meta = nullptr;
+            if (natsMsg_GetMetaData(&meta, msg) != NATS_OK) {
+                ++unstamped;
+                continue;
+            }
+            const qint64 ts = meta->Timestamp;
+            const quint64 pending = meta->NumPending;
+            jsMsgMetaData_Destroy(meta);
+            if (ts >= liveStartNs) {
+                done = true; // the live subscription has it from here on
+                break;
+            }
+            const QByteArray subject(natsMsg_GetSubject(msg));
+            auto decoder = decoders.find(subject);
+            if (decoder == decoders.end())
+                decoder = decoders.insert(subject, FeedCodec::StatesDecoder());
+            FeedCodec::States decoded;
+            QVariantList sats;
+            if (decoder->decode(QByteArray::fromRawData(natsMsg_GetData(msg), natsMsg_GetDataLength(msg)), decoded))
+                sats = decoded.toVariantList(); // the history keeps maps
+            if (!sats.isEmpty()) {
+                addHistory(ts, sats);
+                states += sats.size();
+                latest = std::move(sats);
+                latestNs = ts;
+            }
+            ++messages;
+            done = pending == 0;
         }
-        sats.append(sat);
+        natsMsgList_Destroy(&list);
     }
 
-    if (!sats.isEmpty()) {
-        QMetaObject::invokeMethod(
-            this,
-            [this, sats]() { emit satellitesUpdated(sats); },
-            Qt::QueuedConnection);
-    }
+    natsSubscription_Unsubscribe(sub);
+    natsSubscription_Destroy(sub);
+    jsCtx_Destroy(js);
 
-    natsMsg_Destroy(msg);
+    // Show the newest backfilled state (with its history) unless live data has already replaced it. Checked and
+    // published under the lock the live path publishes under, so a live batch is never overtaken by an older one.
+    if (m_backfillRunning && !latest.isEmpty()) {
+        QMutexLocker locker(&m_publishMutex);
+        if (m_livePublished == 0)
+            publishSatellites(std::move(latest), latestNs);
+    }
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    QString summary = QStringLiteral("Backfill: %1 messages, %2 states from the last %3 min in %4 ms")
+                          .arg(messages)
+                          .arg(states)
+                          .arg(m_backfillMinutes)
+                          .arg(ms, 0, 'f', 0);
+    if (unstamped > 0)
+        summary += QStringLiteral(" (%1 skipped without JetStream metadata)").arg(unstamped);
+    postStatus(summary);
+    m_backfillRunning = false;
 }
 
-void OrbitFeed::startGroundStationWatcher()
+void OrbitFeed::startKvWatcher()
 {
     if (!m_conn || m_kvWatcher)
         return;
@@ -185,7 +330,8 @@ void OrbitFeed::startGroundStationWatcher()
         return;
     }
 
-    s = js_KeyValue(&m_kv, m_js, "mgs");
+    const QByteArray bucketUtf8 = m_kvBucket.isEmpty() ? QByteArrayLiteral("mgs") : m_kvBucket.toUtf8();
+    s = js_KeyValue(&m_kv, m_js, bucketUtf8.constData());
     if (s != NATS_OK) {
         emit statusMessage(QStringLiteral("KV bind failed: %1").arg(QString::fromLatin1(natsStatus_GetText(s))));
         if (m_kv) {
@@ -204,7 +350,8 @@ void OrbitFeed::startGroundStationWatcher()
     opts.IgnoreDeletes = false;
     opts.UpdatesOnly = false;
 
-    s = kvStore_Watch(&m_kvWatcher, m_kv, "m.gs.*.mask", &opts);
+    // Masks (`m.gs.<id>.mask`) and element sets (`m.el.<id>`) share the bucket; keys are dispatched by FeedSource.
+    s = kvStore_WatchAll(&m_kvWatcher, m_kv, &opts);
     if (s != NATS_OK) {
         emit statusMessage(QStringLiteral("KV watch failed: %1").arg(QString::fromLatin1(natsStatus_GetText(s))));
         if (m_kvWatcher) {
@@ -223,10 +370,10 @@ void OrbitFeed::startGroundStationWatcher()
     }
 
     m_kvThreadRunning = true;
-    m_kvThread = std::thread([this]() { watchGroundStations(); });
+    m_kvThread = std::thread([this]() { watchKv(); });
 }
 
-void OrbitFeed::stopGroundStationWatcher()
+void OrbitFeed::stopKvWatcher()
 {
     m_kvThreadRunning = false;
     if (m_kvWatcher) {
@@ -247,14 +394,11 @@ void OrbitFeed::stopGroundStationWatcher()
         jsCtx_Destroy(m_js);
         m_js = nullptr;
     }
-    {
-        QMutexLocker locker(&m_groundStationMutex);
-        m_groundStations.clear();
-    }
-    publishGroundStations();
+    clearGroundStations();
+    clearElements();
 }
 
-void OrbitFeed::watchGroundStations()
+void OrbitFeed::watchKv()
 {
     while (m_kvThreadRunning && m_kvWatcher) {
         kvEntry *entry = nullptr;
@@ -274,19 +418,19 @@ void OrbitFeed::watchGroundStations()
                 kvEntry_Destroy(entry);
                 entry = nullptr;
             }
-            emit statusMessage(QStringLiteral("KV watch stopped: %1").arg(QString::fromLatin1(natsStatus_GetText(s))));
+            postStatus(QStringLiteral("KV watch stopped: %1").arg(QString::fromLatin1(natsStatus_GetText(s))));
             m_kvThreadRunning = false;
             break;
         }
         if (!entry) {
             continue; // initial snapshot marker
         }
-        handleGroundStationEntry(entry);
+        handleKvEntry(entry);
         kvEntry_Destroy(entry);
     }
 }
 
-void OrbitFeed::handleGroundStationEntry(kvEntry *entry)
+void OrbitFeed::handleKvEntry(kvEntry *entry)
 {
     if (!entry)
         return;
@@ -294,22 +438,13 @@ void OrbitFeed::handleGroundStationEntry(kvEntry *entry)
     const char *keyPtr = kvEntry_Key(entry);
     if (!keyPtr)
         return;
-    const QString key = QString::fromLatin1(keyPtr);
-    const QString prefix = QStringLiteral("m.gs.");
-    const QString suffix = QStringLiteral(".mask");
-    if (!key.startsWith(prefix) || !key.endsWith(suffix))
-        return;
-    const QString id = key.mid(prefix.size(), key.size() - prefix.size() - suffix.size());
-    if (id.isEmpty())
-        return;
+    const QString key = QString::fromUtf8(keyPtr);
 
     const kvOperation op = kvEntry_Operation(entry);
     if (op == kvOp_Delete || op == kvOp_Purge) {
-        {
-            QMutexLocker locker(&m_groundStationMutex);
-            m_groundStations.remove(id);
-        }
-        publishGroundStations();
+        if (m_recorder.isOpen())
+            m_recorder.append(FeedCapture::nowNs(), FeedCapture::RecordKind::KvDelete, keyPtr, {});
+        applyKvDelete(key);
         return;
     }
 
@@ -317,154 +452,9 @@ void OrbitFeed::handleGroundStationEntry(kvEntry *entry)
     const int len = kvEntry_ValueLen(entry);
     if (!valPtr || len <= 0)
         return;
+    if (m_recorder.isOpen())
+        m_recorder.append(FeedCapture::nowNs(), FeedCapture::RecordKind::KvPut, keyPtr,
+                          QByteArrayView(static_cast<const char *>(valPtr), len));
 
-    const QByteArray payload(static_cast<const char *>(valPtr), len);
-    QVariantMap station = parseGroundStationPayload(payload);
-    if (station.isEmpty())
-        return;
-    station.insert(QStringLiteral("id"), id);
-
-    {
-        QMutexLocker locker(&m_groundStationMutex);
-        m_groundStations.insert(id, station);
-    }
-    publishGroundStations();
-}
-
-QVariantMap OrbitFeed::parseGroundStationPayload(const QByteArray &payload) const
-{
-    QCborParserError err;
-    QCborValue val = QCborValue::fromCbor(payload, &err);
-    if (err.error != QCborError::NoError)
-        return {};
-
-    auto readNumber = [](const QCborMap &m, const std::initializer_list<QCborValue> &keys, double &out) -> bool {
-        for (const auto &k : keys) {
-            auto it = m.constFind(k);
-            if (it != m.constEnd()) {
-                const double v = it->toDouble(std::numeric_limits<double>::quiet_NaN());
-                if (std::isfinite(v)) {
-                    out = v;
-                    return true;
-                }
-            }
-        }
-        return false;
-    };
-
-    auto parsePoint = [&](const QCborValue &v, double &lat, double &lon) -> bool {
-        if (v.isMap()) {
-            const QCborMap m = v.toMap();
-            return readNumber(m, {QCborValue(QStringLiteral("Lat")), QCborValue(QStringLiteral("lat"))}, lat)
-                && readNumber(m, {QCborValue(QStringLiteral("Lon")), QCborValue(QStringLiteral("lon"))}, lon);
-        }
-        if (v.isArray()) {
-            const QCborArray arr = v.toArray();
-            if (arr.size() >= 2) {
-                const double la = arr.at(0).toDouble(std::numeric_limits<double>::quiet_NaN());
-                const double lo = arr.at(1).toDouble(std::numeric_limits<double>::quiet_NaN());
-                if (std::isfinite(la) && std::isfinite(lo)) {
-                    lat = la;
-                    lon = lo;
-                    return true;
-                }
-            }
-        }
-        return false;
-    };
-
-    auto parsePointsArray = [&](const QCborArray &arr) -> QVariantList {
-        QVariantList pts;
-        for (const QCborValue &item : arr) {
-            double lat = std::numeric_limits<double>::quiet_NaN();
-            double lon = std::numeric_limits<double>::quiet_NaN();
-            if (parsePoint(item, lat, lon)) {
-                QVariantMap p;
-                p.insert(QStringLiteral("lat"), lat);
-                p.insert(QStringLiteral("lon"), lon);
-                pts.append(p);
-            }
-        }
-        return pts;
-    };
-
-    QVariantList mask;
-    double lat = std::numeric_limits<double>::quiet_NaN();
-    double lon = std::numeric_limits<double>::quiet_NaN();
-    double radiusKm = std::numeric_limits<double>::quiet_NaN();
-
-    if (val.isMap()) {
-        const QCborMap m = val.toMap();
-        readNumber(m, {QCborValue(QStringLiteral("Lat")), QCborValue(QStringLiteral("lat"))}, lat);
-        readNumber(m, {QCborValue(QStringLiteral("Lon")), QCborValue(QStringLiteral("lon"))}, lon);
-        readNumber(m, {QCborValue(QStringLiteral("radius_km")), QCborValue(QStringLiteral("RadiusKm")), QCborValue(QStringLiteral("radiusKm")), QCborValue(QStringLiteral("radius"))}, radiusKm);
-
-        auto pick = [&](const std::initializer_list<QCborValue> &keys) -> QCborValue {
-            for (const auto &k : keys) {
-                auto it = m.constFind(k);
-                if (it != m.constEnd())
-                    return it.value();
-            }
-            return QCborValue();
-        };
-
-        auto tryParseMask = [&](const QCborValue &candidate) {
-            if (!candidate.isArray())
-                return;
-            QVariantList pts = parsePointsArray(candidate.toArray());
-            if (!pts.isEmpty())
-                mask = pts;
-        };
-
-        tryParseMask(pick({QCborValue(QStringLiteral("mask")), QCborValue(QStringLiteral("Mask"))}));
-        if (mask.isEmpty())
-            tryParseMask(pick({QCborValue(QStringLiteral("boundary")), QCborValue(QStringLiteral("Boundary"))}));
-        if (mask.isEmpty())
-            tryParseMask(pick({QCborValue(QStringLiteral("footprint")), QCborValue(QStringLiteral("Footprint"))}));
-        if (mask.isEmpty())
-            tryParseMask(pick({QCborValue(QStringLiteral("points")), QCborValue(QStringLiteral("Points"))}));
-        if (mask.isEmpty() && val.isArray())
-            mask = parsePointsArray(val.toArray());
-    } else if (val.isArray()) {
-        mask = parsePointsArray(val.toArray());
-    }
-
-    if ((std::isnan(lat) || std::isnan(lon)) && !mask.isEmpty()) {
-        double sumLat = 0.0;
-        double sumLon = 0.0;
-        for (const auto &pVar : mask) {
-            const QVariantMap p = pVar.toMap();
-            sumLat += p.value(QStringLiteral("lat")).toDouble();
-            sumLon += p.value(QStringLiteral("lon")).toDouble();
-        }
-        lat = sumLat / mask.size();
-        lon = sumLon / mask.size();
-    }
-
-    QVariantMap out;
-    if (std::isfinite(lat) && std::isfinite(lon)) {
-        out.insert(QStringLiteral("lat"), lat);
-        out.insert(QStringLiteral("lon"), lon);
-    }
-    if (!mask.isEmpty())
-        out.insert(QStringLiteral("mask"), mask);
-    if (std::isfinite(radiusKm))
-        out.insert(QStringLiteral("radius_km"), radiusKm);
-    return out;
-}
-
-void OrbitFeed::publishGroundStations()
-{
-    QVariantList stations;
-    {
-        QMutexLocker locker(&m_groundStationMutex);
-        stations.reserve(m_groundStations.size());
-        for (auto it = m_groundStations.constBegin(); it != m_groundStations.constEnd(); ++it)
-            stations.append(it.value());
-    }
-
-    QMetaObject::invokeMethod(
-        this,
-        [this, stations]() { emit groundStationsUpdated(stations); },
-        Qt::QueuedConnection);
+    applyKvPut(key, QByteArray::fromRawData(static_cast<const char *>(valPtr), len));
 }
@@ -1,12 +1,16 @@
 #pragma once
 
-#include <QObject>
-#include <QVariantList>
-#include <QMutex>
+#include <QByteArray>
 #include <QHash>
+#include <QMutex>
+#include <QString>
 #include <atomic>
 #include <thread>
 
+#include "FeedCapture.h"
+#include "FeedCodec.h"
+#include "FeedSource.h"
+
 extern "C" {
 #include "nats.h"
 }
@@ -14,34 +18,48 @@ extern "C" {
 // Copyright (c) 2026 Andy Armitage
 // This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
 
-class OrbitFeed : public QObject
+// NATS feed: satellite states from core pub/sub; ground-station masks and orbital element sets from a KV bucket
+// watcher (element sets are propagated locally, see FeedSource).
+class OrbitFeed : public FeedSource
 {
     Q_OBJECT
 public:
     explicit OrbitFeed(QObject *parent = nullptr);
-    ~OrbitFeed();
+    ~OrbitFeed() override;
 
+    void setUrl(const QString &url);
     void setSubject(const QString &subject);
-    void start();
-    void stop();
+    void setKvBucket(const QString &bucket);
+    // On start, fetch this much recent history of the subject from JetStream (pull consumer, background thread) into
+    // the track history before live data takes over. Needs a stream capturing the subject; 0 disables.
+    void setBackfillMinutes(double minutes);
+    // Stream to read from; if empty, JetStream looks it up by subject.
+    void setBackfillStream(const QString &stream);
+    void start() override;
+    void stop() override;
 
-signals:
-    void satellitesUpdated(const QVariantList &satellites);
-    void groundStationsUpdated(const QVariantList &groundStations);
-    void statusMessage(const QString &msg);
+    // Records raw orbit messages and KV mask changes to a capture file for later replay.
+    bool startRecording(const QString &fileName);
+    void stopRecording();
 
 private:
     static void onMessage(natsConnection *, natsSubscription *, natsMsg *msg, void *closure);
     void handleMessage(natsMsg *msg);
-    void startGroundStationWatcher();
-    void stopGroundStationWatcher();
-    void watchGroundStations();
-    void handleGroundStationEntry(kvEntry *entry);
-    QVariantMap parseGroundStationPayload(const QByteArray &payload) const;
-    void publishGroundStations();
+    FeedCodec::StatesDecoder &decoderFor(const char *subject);
+    void startBackfill();
+    void stopBackfill();
+    void runBackfill(qint64 liveStartNs);
+    void startKvWatcher();
+    void stopKvWatcher();
+    void watchKv();
+    void handleKvEntry(kvEntry *entry);
     void disconnect();
 
+    QString m_url;
     QString m_subject;
+    QString m_kvBucket;
+    QString m_backfillStream;
+    double m_backfillMinutes {0.0};
     natsConnection *m_conn {nullptr};
     natsSubscription *m_sub {nullptr};
     jsCtx *m_js {nullptr};
@@ -49,6 +67,10 @@ private:
     kvWatcher *m_kvWatcher {nullptr};
     std::thread m_kvThread;
     std::atomic<bool> m_kvThreadRunning {false};
-    mutable QMutex m_groundStationMutex;
-    QHash<QString, QVariantMap> m_groundStations;
+    std::thread m_backfillThread;
+    std::atomic<bool> m_backfillRunning {false};
+    QMutex m_publishMutex; // orders live and backfilled publishes
+    qint64 m_livePublished {0}; // guarded by m_publishMutex
+    FeedCaptureWriter m_recorder;
+    QHash<QByteArray, FeedCodec::StatesDecoder> m_decoders; // per subject; touched only by the delivery thread
 };
@@ -0,0 +1,253 @@
+#include "PayloadCompression.h"
+
+#include <QtEndian>
+#include <algorithm>
+
+#ifdef EARTH_VIEW_HAVE_ZSTD
+#include <zstd.h>
+#endif
+#ifdef EARTH_VIEW_HAVE_LZ4
+#include <lz4frame.h>
+#endif
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+namespace
+{
+constexpr quint32 ZstdMagic = 0xFD2FB528;
+constexpr quint32 Lz4Magic = 0x184D2204;
+// Upper bound on a decompressed payload, against decompression bombs.
+constexpr qsizetype MaxDecompressedSize = qsizetype(256) * 1024 * 1024;
+
+struct ThreadState
+{
+    QByteArray buffer;
+#ifdef EARTH_VIEW_HAVE_ZSTD
+    ZSTD_DCtx *zstd {nullptr};
+#endif
+#ifdef EARTH_VIEW_HAVE_LZ4
+    LZ4F_dctx *lz4 {nullptr};
+#endif
+
+    ~ThreadState()
+    {
+#ifdef EARTH_VIEW_HAVE_ZSTD
+        ZSTD_freeDCtx(zstd);
+#endif
+#ifdef EARTH_VIEW_HAVE_LZ4
+        LZ4F_freeDecompressionContext(lz4);
+#endif
+    }
+};
+
+ThreadState &threadState()
+{
+    thread_local ThreadState state;
+    return state;
+}
+
+// Grows the buffer geometrically; capacity is kept between calls, so steady-state payloads reuse it.
+bool ensureCapacity(QByteArray &buffer, qsizetype needed)
+{
+    if (needed > MaxDecompressedSize)
+        return false;
+    if (buffer.size() < needed)
+        buffer.resize(std::min(std::max(needed, buffer.size() * 2), MaxDecompressedSize));
+    return true;
+}
+
+#ifdef EARTH_VIEW_HAVE_ZSTD
+qsizetype decompressZstd(ThreadState &ts, QByteArrayView in)
+{
+    if (!ts.zstd && !(ts.zstd = ZSTD_createDCtx()))
+        return -1;
+    ZSTD_DCtx_reset(ts.zstd, ZSTD_reset_session_only);
+
+    const unsigned long long contentSize = ZSTD_getFrameContentSize(in.data(), size_t(in.size()));
+    if (contentSize == ZSTD_CONTENTSIZE_ERROR)
+        return -1;
+    if (!ensureCapacity(ts.buffer, contentSize != ZSTD_CONTENTSIZE_UNKNOWN ? qsizetype(contentSize) : in.size() * 4))
+        return -1;
+
+    ZSTD_inBuffer input {in.data(), size_t(in.size()), 0};
+    ZSTD_outBuffer output {ts.buffer.data(), size_t(ts.buffer.size()), 0};
+    for (;;) {
+        const size_t ret = ZSTD_decompressStream(ts.zstd, &output, &input);
+        if (ZSTD_isError(ret))
+            return -1;
+        if (ret == 0)
+            return qsizetype(output.pos);
+        if (input.pos == input.size && output.pos < output.size)
+            return -1; // truncated frame
+        if (output.pos == output.size) {
+            if (!ensureCapacity(ts.buffer, ts.buffer.size() * 2))
+                return -1;
+            output.dst = ts.buffer.data();
+            output.size = size_t(ts.buffer.size());
+        }
+    }
+}
+#endif
+
+#ifdef EARTH_VIEW_HAVE_LZ4
+qsizetype decompressLz4(ThreadState &ts, QByteArrayView in)
+{
+    if (!ts.lz4 && LZ4F_isError(LZ4F_createDecompressionContext(&ts.lz4, LZ4F_VERSION)))
+        return -1;
+    LZ4F_resetDecompressionContext(ts.lz4);
+
+    // The frame header may carry the content size.
+    LZ4F_frameInfo_t info = LZ4F_INIT_FRAMEINFO;
+    size_t consumed = size_t(in.size());
+    if (LZ4F_isError(LZ4F_getFrameInfo(ts.lz4, &info, in.data(), &consumed)))
+        return -1;
+    if (!ensureCapacity(ts.buffer, info.contentSize ? qsizetype(info.contentSize) : in.size() * 4))
+        return -1;
+
+    const char *src = in.data() + consumed;
+    const char *srcEnd = in.data() + in.size();
+    qsizetype written = 0;
+    for (;;) {
+        size_t srcSize = size_t(srcEnd - src);
+        size_t dstSize = size_t(ts.buffer.size() - written);
+        const size_t ret = LZ4F_decompress(ts.lz4, ts.buffer.data() + written, &dstSize, src, &srcSize, nullptr);
+        if (LZ4F_isError(ret))
+            return -1;
+        src += srcSize;
+        written += qsizetype(dstSize);
+        if (ret == 0)
+            return written;
+        if (src == srcEnd && dstSize == 0)
+            return -1; // truncated frame
+        if (written == ts.buffer.size() && !ensureCapacity(ts.buffer, ts.buffer.size() * 2))
+            return -1;
+    }
+}
+#endif
+}
+
+namespace PayloadCompression
+{
+
+Codec detect(QByteArrayView payload)
+{
+    if (payload.size() < 4)
+        return Codec::None;
+    const quint32 magic = qFromLittleEndian<quint32>(payload.data());
+    if (magic == ZstdMagic)
+        return Codec::Zstd;
+    if (magic == Lz4Magic)
+        return Codec::Lz4;
+    return Codec::None;
+}
+
+QString name(Codec codec)
+{
+    switch (codec) {
+    case Codec::Zstd:
+        return QStringLiteral("zstd");
+    case Codec::Lz4:
+        return QStringLiteral("lz4");
+    case Codec::None:
+        break;
+    }
+    return QStringLiteral("none");
+}
+
+bool fromName(QStringView name, Codec &codec)
+{
+    for (Codec c : {Codec::None, Codec::Zstd, Codec::Lz4}) {
+        if (name.compare(PayloadCompression::name(c), Qt::CaseInsensitive) == 0) {
+            codec = c;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool isAvailable(Codec codec)
+{
+    switch (codec) {
+    case Codec::None:
+        return true;
+    case Codec::Zstd:
+#ifdef EARTH_VIEW_HAVE_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    case Codec::Lz4:
+#ifdef EARTH_VIEW_HAVE_LZ4
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+QByteArray decompressed(const QByteArray &payload)
+{
+    const Codec codec = detect(payload);
+    if (codec == Codec::None)
+        return payload;
+
+    ThreadState &ts = threadState();
+    qsizetype size = -1;
+    switch (codec) {
+    case Codec::Zstd:
+#ifdef EARTH_VIEW_HAVE_ZSTD
+        size = decompressZstd(ts, payload);
+#endif
+        break;
+    case Codec::Lz4:
+#ifdef EARTH_VIEW_HAVE_LZ4
+        size = decompressLz4(ts, payload);
+#endif
+        break;
+    case Codec::None:
+        break;
+    }
+    if (size < 0)
+        return {};
+    return QByteArray::fromRawData(ts.buffer.constData(), size);
+}
+
+QByteArray compress(QByteArrayView payload, Codec codec, int level)
+{
+    Q_UNUSED(level); // when neither library is compiled in
+    if (!isAvailable(codec))
+        return payload.toByteArray();
+    QByteArray out;
+    switch (codec) {
+    case Codec::None:
+        return payload.toByteArray();
+    case Codec::Zstd: {
+#ifdef EARTH_VIEW_HAVE_ZSTD
+        out.resize(qsizetype(ZSTD_compressBound(size_t(payload.size()))));
+        const size_t n = ZSTD_compress(out.data(), size_t(out.size()), payload.data(), size_t(payload.size()), level);
+        if (ZSTD_isError(n))
+            return {};
+        out.resize(qsizetype(n));
+#endif
+        break;
+    }
+    case Codec::Lz4: {
+#ifdef EARTH_VIEW_HAVE_LZ4
+        LZ4F_preferences_t prefs = LZ4F_INIT_PREFERENCES;
+        prefs.compressionLevel = level;
+        prefs.frameInfo.contentSize = quint64(payload.size());
+        out.resize(qsizetype(LZ4F_compressFrameBound(size_t(payload.size()), &prefs)));
+        const size_t n = LZ4F_compressFrame(out.data(), size_t(out.size()), payload.data(), size_t(payload.size()), &prefs);
+        if (LZ4F_isError(n))
+            return {};
+        out.resize(qsizetype(n));
+#endif
+        break;
+    }
+    }
+    return out;
+}
+
+} // namespace PayloadCompression
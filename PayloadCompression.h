@@ -0,0 +1,38 @@
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QString>
+#include <QStringView>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Transparent payload compression for feed messages and KV values. Compressed payloads are standard zstd or LZ4
+// frames and are recognised by their frame magic, so publishers can compress per message without a schema change.
+// Each codec is only available if the build found the library (EARTH_VIEW_HAVE_ZSTD / EARTH_VIEW_HAVE_LZ4).
+namespace PayloadCompression
+{
+enum class Codec {
+    None,
+    Zstd,
+    Lz4,
+};
+
+Codec detect(QByteArrayView payload);
+// Whether this build can compress and decompress `codec` (None always).
+bool isAvailable(Codec codec);
+// "none", "zstd" or "lz4"; fromName() accepts those, in any case.
+QString name(Codec codec);
+bool fromName(QStringView name, Codec &codec);
+
+// Returns the payload itself if it is not compressed. Otherwise decompresses into a per-thread buffer that is
+// reused by the next call on the same thread, and returns a non-owning view of it (QByteArray::fromRawData): decode
+// it before decompressing anything else on this thread. Returns an empty array if decompression fails or the codec
+// is unavailable. Decompression contexts are per thread too, so steady-state calls do not allocate.
+QByteArray decompressed(const QByteArray &payload);
+
+// One-shot compression, for publishers and load tests. Returns the payload uncompressed if the codec is unavailable
+// (check isAvailable() to report that), and an empty array if the library fails.
+QByteArray compress(QByteArrayView payload, Codec codec, int level = 3);
+}
@@ -0,0 +1,189 @@
+#include "Projection.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define EARTH_VIEW_PROJECTION_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define EARTH_VIEW_PROJECTION_NEON
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define EARTH_VIEW_PROJECTION_WASM
+#endif
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+namespace
+{
+// x = x0 + t * width with t = lon * lonScale + lonOffset (in view widths); y = y0 + lat * latScale.
+struct Coefficients
+{
+    float lonScale;
+    float lonOffset;
+    float x0;
+    float width;
+    float latScale;
+    float y0;
+
+    explicit Coefficients(const Projection::Mapping &m)
+        : lonScale(float(1.0 / 360.0))
+        , lonOffset(float((180.0 - m.centerLongitude) / 360.0))
+        , x0(float(m.x))
+        , width(float(m.width))
+        , latScale(float(-m.height / 180.0))
+        , y0(float(m.y + m.height / 2.0))
+    {
+    }
+};
+
+template <bool Wrap>
+void projectScalar(const Coefficients &c, const double *lat, const double *lon, qsizetype from, qsizetype n, qsizetype stride, float *xy)
+{
+    for (qsizetype i = from; i < n; ++i) {
+        float t = float(lon[i * stride]) * c.lonScale + c.lonOffset;
+        if (Wrap)
+            t -= std::floor(t);
+        xy[2 * i] = c.x0 + t * c.width;
+        xy[2 * i + 1] = c.y0 + float(lat[i * stride]) * c.latScale;
+    }
+}
+
+#if defined(EARTH_VIEW_PROJECTION_SSE2)
+inline __m128 load4(const double *p, qsizetype stride)
+{
+    if (stride == 1)
+        return _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(p)), _mm_cvtpd_ps(_mm_loadu_pd(p + 2)));
+    return _mm_setr_ps(float(p[0]), float(p[stride]), float(p[2 * stride]), float(p[3 * stride]));
+}
+
+// floor() without SSE4.1: truncate, then step down where truncation rounded up (negative inputs).
+inline __m128 floor4(__m128 v)
+{
+    const __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(v));
+    return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, v), _mm_set1_ps(1.0f)));
+}
+
+template <bool Wrap>
+qsizetype projectSimd(const Coefficients &c, const double *lat, const double *lon, qsizetype n, qsizetype stride, float *xy)
+{
+    const __m128 lonScale = _mm_set1_ps(c.lonScale);
+    const __m128 lonOffset = _mm_set1_ps(c.lonOffset);
+    const __m128 x0 = _mm_set1_ps(c.x0);
+    const __m128 width = _mm_set1_ps(c.width);
+    const __m128 latScale = _mm_set1_ps(c.latScale);
+    const __m128 y0 = _mm_set1_ps(c.y0);
+    qsizetype i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 t = _mm_add_ps(_mm_mul_ps(load4(lon + i * stride, stride), lonScale), lonOffset);
+        if (Wrap)
+            t = _mm_sub_ps(t, floor4(t));
+        const __m128 x = _mm_add_ps(x0, _mm_mul_ps(t, width));
+        const __m128 y = _mm_add_ps(y0, _mm_mul_ps(load4(lat + i * stride, stride), latScale));
+        _mm_storeu_ps(xy + 2 * i, _mm_unpacklo_ps(x, y));
+        _mm_storeu_ps(xy + 2 * i + 4, _mm_unpackhi_ps(x, y));
+    }
+    return i;
+}
+#elif defined(EARTH_VIEW_PROJECTION_NEON)
+inline float32x4_t load4(const double *p, qsizetype stride)
+{
+#if defined(__aarch64__)
+    if (stride == 1)
+        return vcombine_f32(vcvt_f32_f64(vld1q_f64(p)), vcvt_f32_f64(vld1q_f64(p + 2)));
+#endif
+    const float lanes[4] = {float(p[0]), float(p[stride]), float(p[2 * stride]), float(p[3 * stride])};
+    return vld1q_f32(lanes);
+}
+
+inline float32x4_t floor4(float32x4_t v)
+{
+#if defined(__aarch64__)
+    return vrndmq_f32(v);
+#else
+    const float32x4_t truncated = vcvtq_f32_s32(vcvtq_s32_f32(v));
+    const uint32x4_t roundedUp = vcgtq_f32(truncated, v);
+    return vsubq_f32(truncated, vreinterpretq_f32_u32(vandq_u32(roundedUp, vreinterpretq_u32_f32(vdupq_n_f32(1.0f)))));
+#endif
+}
+
+template <bool Wrap>
+qsizetype projectSimd(const Coefficients &c, const double *lat, const double *lon, qsizetype n, qsizetype stride, float *xy)
+{
+    const float32x4_t lonOffset = vdupq_n_f32(c.lonOffset);
+    const float32x4_t x0 = vdupq_n_f32(c.x0);
+    const float32x4_t y0 = vdupq_n_f32(c.y0);
+    qsizetype i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t t = vmlaq_n_f32(lonOffset, load4(lon + i * stride, stride), c.lonScale);
+        if (Wrap)
+            t = vsubq_f32(t, floor4(t));
+        float32x4x2_t out;
+        out.val[0] = vmlaq_n_f32(x0, t, c.width);
+        out.val[1] = vmlaq_n_f32(y0, load4(lat + i * stride, stride), c.latScale);
+        vst2q_f32(xy + 2 * i, out); // interleaves x and y
+    }
+    return i;
+}
+#elif defined(EARTH_VIEW_PROJECTION_WASM)
+inline v128_t load4(const double *p, qsizetype stride)
+{
+    return wasm_f32x4_make(float(p[0]), float(p[stride]), float(p[2 * stride]), float(p[3 * stride]));
+}
+
+template <bool Wrap>
+qsizetype projectSimd(const Coefficients &c, const double *lat, const double *lon, qsizetype n, qsizetype stride, float *xy)
+{
+    const v128_t lonScale = wasm_f32x4_splat(c.lonScale);
+    const v128_t lonOffset = wasm_f32x4_splat(c.lonOffset);
+    const v128_t x0 = wasm_f32x4_splat(c.x0);
+    const v128_t width = wasm_f32x4_splat(c.width);
+    const v128_t latScale = wasm_f32x4_splat(c.latScale);
+    const v128_t y0 = wasm_f32x4_splat(c.y0);
+    qsizetype i = 0;
+    for (; i + 4 <= n; i += 4) {
+        v128_t t = wasm_f32x4_add(wasm_f32x4_mul(load4(lon + i * stride, stride), lonScale), lonOffset);
+        if (Wrap)
+            t = wasm_f32x4_sub(t, wasm_f32x4_floor(t));
+        const v128_t x = wasm_f32x4_add(x0, wasm_f32x4_mul(t, width));
+        const v128_t y = wasm_f32x4_add(y0, wasm_f32x4_mul(load4(lat + i * stride, stride), latScale));
+        wasm_v128_store(xy + 2 * i, wasm_i32x4_shuffle(x, y, 0, 4, 1, 5));
+        wasm_v128_store(xy + 2 * i + 4, wasm_i32x4_shuffle(x, y, 2, 6, 3, 7));
+    }
+    return i;
+}
+#else
+template <bool Wrap>
+qsizetype projectSimd(const Coefficients &, const double *, const double *, qsizetype, qsizetype, float *)
+{
+    return 0;
+}
+#endif
+}
+
+namespace Projection
+{
+
+void projectWrapped(const Mapping &m, const double *lat, const double *lon, qsizetype n, qsizetype stride, float *xy)
+{
+    const Coefficients c(m);
+    projectScalar<true>(c, lat, lon, projectSimd<true>(c, lat, lon, n, stride, xy), n, stride, xy);
+}
+
+void projectUnwrapped(const Mapping &m, const double *lat, const double *lon, qsizetype n, qsizetype stride, float *xy)
+{
+    const Coefficients c(m);
+    projectScalar<false>(c, lat, lon, projectSimd<false>(c, lat, lon, n, stride, xy), n, stride, xy);
+}
+
+void projectWrappedReference(const Mapping &m, const double *lat, const double *lon, qsizetype n, qsizetype stride, float *xy)
+{
+    projectScalar<true>(Coefficients(m), lat, lon, 0, n, stride, xy);
+}
+
+void projectUnwrappedReference(const Mapping &m, const double *lat, const double *lon, qsizetype n, qsizetype stride, float *xy)
+{
+    projectScalar<false>(Coefficients(m), lat, lon, 0, n, stride, xy);
+}
+
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <QPointF>
+#include <QRectF>
+#include <QtGlobal>
+#include <algorithm>
+#include <cmath>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Equirectangular projection shared by every EarthView layer and the hit testers. The batch entry points take
+// latitude/longitude columns (stride 1) or interleaved GeoPoint arrays (stride 2) and write (x, y) float pairs in the
+// QSGGeometry::Point2D layout. They use SSE2, NEON or WASM SIMD128 where the build targets it, with branch-free
+// longitude wrapping; the *Reference functions are the scalar definitions the SIMD paths must match.
+namespace Projection
+{
+struct Mapping
+{
+    double x {0.0};
+    double y {0.0};
+    double width {0.0};
+    double height {0.0};
+    double centerLongitude {0.0};
+
+    static Mapping forView(const QRectF &rect, double centerLongitude)
+    {
+        return {rect.x(), rect.y(), rect.width(), rect.height(), centerLongitude};
+    }
+};
+
+// The part of the map a view shows, in degrees: latitudes [south, north] and longitudes within halfSpan of
+// centerLongitude (180: all of them). Layers test objects against it before projecting them.
+struct GeoWindow
+{
+    double south {-90.0};
+    double north {90.0};
+    double centerLongitude {0.0};
+    double halfSpan {180.0};
+
+    // The window of `visible` (item pixels) under `m`, widened by `marginPx` on every side.
+    static GeoWindow forView(const Mapping &m, const QRectF &visible, qreal marginPx = 0.0)
+    {
+        GeoWindow w;
+        w.north = std::min(90.0, 90.0 - (visible.top() - marginPx - m.y) / m.height * 180.0);
+        w.south = std::max(-90.0, 90.0 - (visible.bottom() + marginPx - m.y) / m.height * 180.0);
+        w.centerLongitude = m.centerLongitude + ((visible.center().x() - m.x) / m.width - 0.5) * 360.0;
+        w.halfSpan = std::min(180.0, (visible.width() / 2 + marginPx) / m.width * 360.0);
+        return w;
+    }
+
+    bool contains(double latDeg, double lonDeg) const
+    {
+        return latDeg >= south && latDeg <= north && std::abs(std::remainder(lonDeg - centerLongitude, 360.0)) <= halfSpan;
+    }
+
+    // Overlap with latitudes [s, n] and longitudes within `lonHalfSpan` of `lonCentre`.
+    bool intersects(double s, double n, double lonCentre, double lonHalfSpan) const
+    {
+        return n >= south && s <= north && std::abs(std::remainder(lonCentre - centerLongitude, 360.0)) <= halfSpan + lonHalfSpan;
+    }
+};
+
+// Wrapped: x in [x, x + width), the view's copy of the world. Unwrapped: continuous in longitude.
+// Reads lat[i * stride] and lon[i * stride] for i < n and writes xy[2 * i], xy[2 * i + 1].
+void projectWrapped(const Mapping &m, const double *lat, const double *lon, qsizetype n, qsizetype stride, float *xy);
+void projectUnwrapped(const Mapping &m, const double *lat, const double *lon, qsizetype n, qsizetype stride, float *xy);
+
+void projectWrappedReference(const Mapping &m, const double *lat, const double *lon, qsizetype n, qsizetype stride, float *xy);
+void projectUnwrappedReference(const Mapping &m, const double *lat, const double *lon, qsizetype n, qsizetype stride, float *xy);
+
+// Single points through the same kernels and float arithmetic, so hit testing and points drawn on their own land where
+// the batch paths draw.
+inline QPointF projectWrapped(const Mapping &m, double latDeg, double lonDeg)
+{
+    float xy[2];
+    projectWrapped(m, &latDeg, &lonDeg, 1, 1, xy);
+    return QPointF(xy[0], xy[1]);
+}
+
+inline QPointF projectUnwrapped(const Mapping &m, double latDeg, double lonDeg)
+{
+    float xy[2];
+    projectUnwrapped(m, &latDeg, &lonDeg, 1, 1, xy);
+    return QPointF(xy[0], xy[1]);
+}
+
+// `bx` moved by whole view widths to the copy nearest `ax`, so a segment from a to b never spans the seam.
+inline qreal nearestCopy(qreal ax, qreal bx, qreal width)
+{
+    return bx - width * std::nearbyint((bx - ax) / width);
+}
+}
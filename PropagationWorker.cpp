@@ -0,0 +1,261 @@
+#include "PropagationWorker.h"
+
+#include <QMutexLocker>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+PropagationWorker::PropagationWorker(Sink sink, StatusSink status, TimeSource clock)
+    : m_sink(std::move(sink))
+    , m_status(std::move(status))
+    , m_clock(std::move(clock))
+{
+}
+
+PropagationWorker::~PropagationWorker()
+{
+    stop();
+}
+
+void PropagationWorker::setRateHz(double hz)
+{
+    if (hz > 0.0)
+        m_rateHz = hz;
+}
+
+void PropagationWorker::setTrack(double spanSeconds, double stepSeconds, double refreshSeconds)
+{
+    if (spanSeconds < 0.0 || stepSeconds <= 0.0 || refreshSeconds <= 0.0)
+        return;
+    m_trackSpanSeconds = spanSeconds;
+    m_trackStepSeconds = stepSeconds;
+    m_trackRefreshSeconds = refreshSeconds;
+}
+
+void PropagationWorker::setElements(const QString &id, const Sgp4Elements &elements)
+{
+    QMutexLocker locker(&m_mutex);
+    m_elements.insert(id, elements);
+    m_elementsDirty = true;
+}
+
+void PropagationWorker::removeElements(const QString &id)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_elements.remove(id))
+        m_elementsDirty = true;
+}
+
+void PropagationWorker::clearElements()
+{
+    QMutexLocker locker(&m_mutex);
+    m_elements.clear();
+    m_elementsDirty = true;
+}
+
+int PropagationWorker::elementCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return int(m_elements.size());
+}
+
+void PropagationWorker::setStreamedStates(QVariantList satellites)
+{
+    QMutexLocker locker(&m_mutex);
+    m_streamed = std::move(satellites);
+}
+
+void PropagationWorker::start()
+{
+    if (m_running)
+        return;
+    m_running = true;
+    m_thread = std::thread([this]() { run(); });
+}
+
+void PropagationWorker::stop()
+{
+    m_running = false;
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+void PropagationWorker::run()
+{
+    using Clock = std::chrono::steady_clock;
+
+    const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_rateHz));
+    auto nextTick = Clock::now();
+
+    while (m_running) {
+        bool dirty = false;
+        {
+            QMutexLocker locker(&m_mutex);
+            dirty = m_elementsDirty;
+        }
+        if (dirty)
+            rebuild();
+
+        const double jd = currentJd();
+        if (dirty || std::abs(jd - m_tracksJd) * 86400.0 >= m_trackRefreshSeconds)
+            resampleTracks(jd);
+
+        m_propagator.propagate(jd, m_lat.data(), m_lon.data(), m_alt.data(), m_ok.data());
+        QVariantList batch = buildBatch(jd);
+        if (!batch.isEmpty())
+            m_sink(std::move(batch));
+
+        nextTick += period;
+        if (nextTick < Clock::now())
+            nextTick = Clock::now(); // don't try to catch up after a stall
+        for (auto t = Clock::now(); m_running && t < nextTick; t = Clock::now())
+            std::this_thread::sleep_for(std::min<Clock::duration>(nextTick - t, std::chrono::milliseconds(50)));
+    }
+}
+
+double PropagationWorker::currentJd() const
+{
+    if (m_clock)
+        return Sgp4Propagator::julianDateFromUnix(double(m_clock()) / 1e9);
+    const auto since = std::chrono::system_clock::now().time_since_epoch();
+    return Sgp4Propagator::julianDateFromUnix(std::chrono::duration<double>(since).count());
+}
+
+void PropagationWorker::rebuild()
+{
+    QHash<QString, Sgp4Elements> elements;
+    {
+        QMutexLocker locker(&m_mutex);
+        elements = m_elements;
+        m_elementsDirty = false;
+    }
+
+    m_propagator.clear();
+    m_propagator.reserve(elements.size());
+    m_ids.clear();
+    m_ids.reserve(elements.size());
+    int rejected = 0;
+    for (auto it = elements.constBegin(); it != elements.constEnd(); ++it) {
+        if (m_propagator.add(it.value()) < 0) {
+            ++rejected;
+            continue;
+        }
+        m_ids.append(it.key());
+    }
+
+    const std::size_t n = m_propagator.size();
+    m_lat.assign(n, 0.0);
+    m_lon.assign(n, 0.0);
+    m_alt.assign(n, 0.0);
+    m_ok.assign(n, 0);
+    m_slots.clear();
+    m_slots.reserve(m_ids.size());
+    for (int i = 0; i < m_ids.size(); ++i)
+        m_slots.insert(m_ids[i], i);
+
+    if (m_status) {
+        m_status(rejected > 0 ? QStringLiteral("Propagating %1 objects (%2 element sets rejected: invalid or deep-space)")
+                                    .arg(n)
+                                    .arg(rejected)
+                              : QStringLiteral("Propagating %1 objects").arg(n));
+    }
+}
+
+void PropagationWorker::resampleTracks(double jd)
+{
+    const std::size_t n = m_propagator.size();
+    const int half = int(m_trackSpanSeconds / m_trackStepSeconds);
+    const int samples = 2 * half + 1;
+    const double stepJd = m_trackStepSeconds / 86400.0;
+
+    m_tracks.resize(int(n));
+    for (auto &track : m_tracks)
+        track.resize(samples);
+
+    // One catalogue-wide propagation per sample time, scattered into the per-object tracks.
+    std::vector<double> lat(n), lon(n), alt(n);
+    std::vector<unsigned char> ok(n);
+    m_trackStartJd = jd - half * stepJd;
+    for (int k = 0; k < samples; ++k) {
+        m_propagator.propagate(m_trackStartJd + k * stepJd, lat.data(), lon.data(), alt.data(), ok.data());
+        for (std::size_t i = 0; i < n; ++i) {
+            GeoPoint &p = m_tracks[int(i)][k];
+            p.lat = ok[i] ? lat[i] : std::numeric_limits<double>::quiet_NaN();
+            p.lon = ok[i] ? lon[i] : std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+    m_tracksJd = jd;
+    m_trackSplit = -1;
+}
+
+void PropagationWorker::splitTracks(int split)
+{
+    m_pastTracks.resize(m_tracks.size());
+    m_futureTracks.resize(m_tracks.size());
+    for (int i = 0; i < m_tracks.size(); ++i) {
+        const QVector<GeoPoint> &track = m_tracks[i];
+        QVector<GeoPoint> past;
+        QVector<GeoPoint> future;
+        past.reserve(std::clamp(split, 0, int(track.size())));
+        future.reserve(std::max<int>(int(track.size()) - split, 0));
+        for (int k = 0; k < track.size(); ++k) {
+            const GeoPoint &p = track[k];
+            if (!std::isfinite(p.lat))
+                continue;
+            (k < split ? past : future).append(p);
+        }
+        m_pastTracks[i] = past.isEmpty() ? QVariant() : QVariant::fromValue(past);
+        m_futureTracks[i] = future.isEmpty() ? QVariant() : QVariant::fromValue(future);
+    }
+    m_trackSplit = split;
+}
+
+QVariantList PropagationWorker::buildBatch(double jd)
+{
+    QVariantList streamed;
+    {
+        QMutexLocker locker(&m_mutex);
+        streamed = m_streamed;
+    }
+
+    const std::size_t n = m_propagator.size();
+    const double stepJd = m_trackStepSeconds / 86400.0;
+    // Samples at or before now belong to the past track.
+    const int split = int(std::floor((jd - m_trackStartJd) / stepJd)) + 1;
+
+    // Tracks only change when resampled or when now crosses a sample, not on every tick.
+    if (split != m_trackSplit)
+        splitTracks(split);
+
+    QVariantList sats;
+    sats.reserve(int(n) + streamed.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!m_ok[i])
+            continue;
+        QVariantMap sat;
+        sat.insert(QStringLiteral("ID"), m_ids[int(i)]);
+        sat.insert(QStringLiteral("Lat"), m_lat[i]);
+        sat.insert(QStringLiteral("Lon"), m_lon[i]);
+        sat.insert(QStringLiteral("Alt"), m_alt[i]);
+        if (int(i) < m_pastTracks.size()) {
+            if (m_pastTracks[int(i)].isValid())
+                sat.insert(QStringLiteral("TrackPast"), m_pastTracks[int(i)]);
+            if (m_futureTracks[int(i)].isValid())
+                sat.insert(QStringLiteral("TrackFuture"), m_futureTracks[int(i)]);
+        }
+        sats.append(sat);
+    }
+
+    for (const QVariant &v : std::as_const(streamed)) {
+        const QVariantMap m = v.toMap();
+        const QString id = m.value(QStringLiteral("ID"), m.value(QStringLiteral("id"))).toString();
+        const auto slot = m_slots.constFind(id);
+        if (id.isEmpty() || slot == m_slots.constEnd() || !m_ok[std::size_t(*slot)])
+            sats.append(v);
+    }
+    return sats;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QVariantList>
+#include <QVector>
+#include <atomic>
+#include <functional>
+#include <thread>
+
+#include "GeoTypes.h"
+#include "Sgp4.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Propagates the current element set on a worker thread and emits satellite batches (current position plus sampled
+// past/future tracks) at a fixed rate. Positions are for the time the clock callback reports (the feed's clock, so a
+// replay propagates to the recorded time), or the wall clock without one. Objects that only arrive as streamed states
+// are merged into each batch so the view sees one list. All setters are thread-safe.
+class PropagationWorker
+{
+public:
+    using Sink = std::function<void(QVariantList)>;
+    using StatusSink = std::function<void(const QString &)>;
+    // Current time in nanoseconds since the Unix epoch; called on the worker thread.
+    using TimeSource = std::function<qint64()>;
+
+    PropagationWorker(Sink sink, StatusSink status, TimeSource clock = {});
+    ~PropagationWorker();
+
+    void setRateHz(double hz);
+    // Track extends this far either side of now, sampled every stepSeconds; resampled every refreshSeconds.
+    void setTrack(double spanSeconds, double stepSeconds, double refreshSeconds);
+
+    void setElements(const QString &id, const Sgp4Elements &elements);
+    void removeElements(const QString &id);
+    void clearElements();
+    int elementCount() const;
+
+    // Latest streamed batch; entries whose ID has elements are superseded by the propagated state.
+    void setStreamedStates(QVariantList satellites);
+
+    void start();
+    void stop();
+    bool isRunning() const { return m_running; }
+
+private:
+    void run();
+    double currentJd() const;
+    void rebuild();
+    void resampleTracks(double jd);
+    void splitTracks(int split);
+    QVariantList buildBatch(double jd);
+
+    Sink m_sink;
+    StatusSink m_status;
+    TimeSource m_clock;
+    double m_rateHz {10.0};
+    double m_trackSpanSeconds {2700.0};
+    double m_trackStepSeconds {60.0};
+    double m_trackRefreshSeconds {30.0};
+
+    mutable QMutex m_mutex;
+    QHash<QString, Sgp4Elements> m_elements; // guarded by m_mutex
+    QVariantList m_streamed;                 // guarded by m_mutex
+    bool m_elementsDirty {false};            // guarded by m_mutex
+
+    // Worker-thread state.
+    Sgp4Propagator m_propagator;
+    QVector<QString> m_ids;
+    std::vector<double> m_lat, m_lon, m_alt;
+    std::vector<unsigned char> m_ok;
+    QVector<QVector<GeoPoint>> m_tracks; // per slot, 2 * samples + 1 points starting at m_trackStartJd
+    double m_trackStartJd {0.0};
+    double m_tracksJd {0.0};
+    // Per slot past/future halves of m_tracks as split at m_trackSplit; shared into every batch until either changes.
+    QVector<QVariant> m_pastTracks;
+    QVector<QVariant> m_futureTracks;
+    int m_trackSplit {-1};
+    QHash<QString, int> m_slots; // ID -> slot
+
+    std::thread m_thread;
+    std::atomic<bool> m_running {false};
+};
@@ -0,0 +1,195 @@
+#include "ReplayFeedSource.h"
+
+#include <QHash>
+#include <QVector>
+#include <algorithm>
+#include <chrono>
+
+#include "FeedCapture.h"
+#include "FeedCodec.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+namespace
+{
+// Bounds the queue towards the owner thread when replaying without delays, so throughput reflects consumption.
+constexpr int MaxPendingBatches = 4;
+}
+
+ReplayFeedSource::ReplayFeedSource(QObject *parent)
+    : FeedSource(parent)
+{
+}
+
+ReplayFeedSource::~ReplayFeedSource()
+{
+    stop();
+}
+
+void ReplayFeedSource::setFileName(const QString &fileName)
+{
+    m_fileName = fileName;
+}
+
+void ReplayFeedSource::setPacing(Pacing pacing)
+{
+    m_pacing = pacing;
+}
+
+void ReplayFeedSource::setSpeed(double speed)
+{
+    if (speed > 0.0)
+        m_speed = speed;
+}
+
+void ReplayFeedSource::setLoop(bool loop)
+{
+    m_loop = loop;
+}
+
+void ReplayFeedSource::setStartOffsetMs(qint64 offsetMs)
+{
+    m_startOffsetMs = std::max<qint64>(offsetMs, 0);
+}
+
+void ReplayFeedSource::start()
+{
+    if (m_running)
+        return;
+    if (m_thread.joinable())
+        m_thread.join(); // previous run finished on its own
+
+    m_running = true;
+    m_thread = std::thread([this]() { run(); });
+    emit statusMessage(QStringLiteral("Replaying %1").arg(m_fileName));
+}
+
+void ReplayFeedSource::stop()
+{
+    m_running = false;
+    if (m_thread.joinable())
+        m_thread.join();
+    clearGroundStations();
+    clearElements();
+}
+
+void ReplayFeedSource::applyKvRecord(const FeedCapture::RecordView &record)
+{
+    const QString key = QString::fromUtf8(record.subject);
+    if (record.kind == FeedCapture::RecordKind::KvDelete)
+        applyKvDelete(key);
+    else
+        applyKvPut(key, QByteArray::fromRawData(record.payload.data(), record.payload.size()));
+}
+
+void ReplayFeedSource::restoreKvState(const FeedCaptureReader &reader, qint64 timestampNs)
+{
+    // Masks, stations and element sets recorded before the start point: the last put or delete of each key, applied
+    // in the order the keys first appeared. The capture's KV index finds them without reading any message.
+    QVector<FeedCapture::RecordView> latest;
+    QHash<QByteArray, qsizetype> slotByKey;
+    for (const FeedCapture::RecordView &rec : reader.kvRecordsBefore(timestampNs)) {
+        const QByteArray key = rec.subject.toByteArray();
+        const auto it = slotByKey.constFind(key);
+        if (it != slotByKey.constEnd()) {
+            latest[*it] = rec;
+        } else {
+            slotByKey.insert(key, latest.size());
+            latest.append(rec);
+        }
+    }
+    for (const FeedCapture::RecordView &record : std::as_const(latest))
+        applyKvRecord(record);
+}
+
+void ReplayFeedSource::run()
+{
+    using Clock = std::chrono::steady_clock;
+
+    FeedCaptureReader reader;
+    if (!reader.open(m_fileName)) {
+        postStatus(QStringLiteral("Replay open failed: %1").arg(reader.errorString()));
+        m_running = false;
+        return;
+    }
+    if (reader.recovered())
+        postStatus(QStringLiteral("Replay: %1 was not closed cleanly; index rebuilt").arg(m_fileName));
+    const qint64 startNs = reader.firstTimestampNs() + m_startOffsetMs * 1000000;
+
+    const double speed = m_pacing == Pacing::RealTime ? 1.0 : m_speed;
+    // Element sets are propagated to the recorded time, which runs at the replay speed between records.
+    const double clockRate = m_pacing == Pacing::AsFastAsPossible ? 0.0 : speed;
+    qint64 messages = 0;
+    qint64 states = 0;
+    const auto replayStart = Clock::now();
+
+    bool again = true;
+    for (int pass = 0; again && m_running; ++pass) {
+        // Each pass starts from the KV state as of the start point, not from wherever the last pass left it.
+        if (pass > 0) {
+            clearGroundStations();
+            clearElements();
+        }
+        setFeedClock(startNs, 0.0);
+        restoreKvState(reader, startNs);
+
+        const auto passStart = Clock::now();
+        qint64 firstTs = -1;
+        qint64 passMessages = 0;
+        reader.seek(startNs);
+        // Compact deltas restart at each seek; frames before the next key frame are dropped.
+        QHash<QByteArray, FeedCodec::StatesDecoder> decoders;
+        FeedCapture::RecordView rec;
+        while (m_running && reader.next(rec)) {
+            if (m_pacing == Pacing::AsFastAsPossible) {
+                while (m_running && pendingBatches() >= MaxPendingBatches)
+                    std::this_thread::sleep_for(std::chrono::microseconds(200));
+            } else {
+                if (firstTs < 0)
+                    firstTs = rec.timestampNs;
+                const auto due = passStart + std::chrono::nanoseconds(qint64((rec.timestampNs - firstTs) / speed));
+                for (auto now = Clock::now(); m_running && now < due; now = Clock::now())
+                    std::this_thread::sleep_for(std::min<Clock::duration>(due - now, std::chrono::milliseconds(50)));
+            }
+            if (!m_running)
+                break;
+            setFeedClock(rec.timestampNs, clockRate);
+
+            switch (rec.kind) {
+            case FeedCapture::RecordKind::Message: {
+                // The payload stays in the file mapping; the decoder reads it in place.
+                const QByteArray subject = rec.subject.toByteArray();
+                auto decoder = decoders.find(subject);
+                if (decoder == decoders.end())
+                    decoder = decoders.insert(subject, FeedCodec::StatesDecoder());
+                warnIfCodecUnavailable(rec.payload);
+                FeedCodec::States decoded;
+                if (!decoder->decode(QByteArray::fromRawData(rec.payload.data(), rec.payload.size()), decoded)) {
+                    countDroppedBatch();
+                    break;
+                }
+                states += decoded.isColumns ? decoded.columns.count() : decoded.list.size();
+                publishStates(std::move(decoded), rec.timestampNs);
+                break;
+            }
+            case FeedCapture::RecordKind::KvPut:
+            case FeedCapture::RecordKind::KvDelete:
+                applyKvRecord(rec);
+                break;
+            }
+            ++passMessages;
+        }
+        messages += passMessages;
+        again = m_loop && passMessages > 0;
+    }
+
+    setFeedClock(feedTimeNs(), 0.0); // hold at the end of the capture
+    const double secs = std::chrono::duration<double>(Clock::now() - replayStart).count();
+    postStatus(QStringLiteral("Replay finished: %1 messages, %2 states in %3 s (%4 states/s)")
+                   .arg(messages)
+                   .arg(states)
+                   .arg(secs, 0, 'f', 2)
+                   .arg(secs > 0 ? states / secs : 0.0, 0, 'f', 0));
+    m_running = false;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QString>
+#include <atomic>
+#include <thread>
+
+#include "FeedCapture.h"
+#include "FeedSource.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Replays a feed capture file (see FeedCapture.h) through the normal decode path on a worker thread.
+class ReplayFeedSource : public FeedSource
+{
+    Q_OBJECT
+public:
+    enum class Pacing {
+        RealTime,         // original inter-message timing
+        Accelerated,      // original timing divided by speed()
+        AsFastAsPossible, // no delays; throttled only by how fast the owner thread consumes batches
+    };
+
+    explicit ReplayFeedSource(QObject *parent = nullptr);
+    ~ReplayFeedSource() override;
+
+    void setFileName(const QString &fileName);
+    void setPacing(Pacing pacing);
+    void setSpeed(double speed);
+    void setLoop(bool loop);
+    // Skips the first part of the capture. Seeking uses the file index; the KV records before the start point (masks,
+    // stations, element sets) are still applied, from a scan of the record headers.
+    void setStartOffsetMs(qint64 offsetMs);
+
+    void start() override;
+    void stop() override;
+
+private:
+    void run();
+    void applyKvRecord(const FeedCapture::RecordView &record);
+    // Applies the KV records before `timestampNs`, so a replay from an offset starts with the state at that point.
+    void restoreKvState(const FeedCaptureReader &reader, qint64 timestampNs);
+
+    QString m_fileName;
+    Pacing m_pacing {Pacing::RealTime};
+    double m_speed {1.0};
+    bool m_loop {false};
+    qint64 m_startOffsetMs {0};
+    std::thread m_thread;
+    std::atomic<bool> m_running {false};
+};
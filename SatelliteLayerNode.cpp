@@ -0,0 +1,551 @@
+#include "SatelliteLayerNode.h"
+#include "CompactLineMaterial.h"
+#include "VertexArena.h"
+
+#include <QSGFlatColorMaterial>
+#include <QVector3D>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+namespace
+{
+constexpr int MaxArcSamples = 16;
+
+quint64 mixKey(quint64 key, quint64 value)
+{
+    return key ^ (value + 0x9e3779b97f4a7c15ULL + (key << 6) + (key >> 2));
+}
+
+quint64 bitsOf(double value)
+{
+    quint64 bits;
+    std::memcpy(&bits, &value, sizeof bits);
+    return bits;
+}
+
+quint64 bitsOf(const float *xy)
+{
+    quint64 bits;
+    std::memcpy(&bits, xy, sizeof bits);
+    return bits;
+}
+
+// Never 0, which marks an empty slot.
+quint64 finishKey(quint64 key)
+{
+    return key ? key : 1;
+}
+
+// Sampled tracks are identified by their size, ends and storage: a new sample changes the end, and a shared list
+// that was not touched keeps its data pointer.
+quint64 trackKey(quint64 key, const QVector<GeoPoint> &track)
+{
+    key = mixKey(key, quint64(track.size()));
+    if (track.isEmpty())
+        return key;
+    key = mixKey(key, quint64(quintptr(track.constData())));
+    key = mixKey(key, bitsOf(track.constFirst().lat) ^ (bitsOf(track.constFirst().lon) << 1));
+    return mixKey(key, bitsOf(track.constLast().lat) ^ (bitsOf(track.constLast().lon) << 1));
+}
+
+// Great-circle samples from A to B, projected into xy; returns the point count (0 if A and B coincide).
+int sampleArc(const Projection::Mapping &mapping, double latA, double lonA, double latB, double lonB, int segments, float *xy)
+{
+    if (segments < 2)
+        return 0;
+
+    const double aLat = latA * M_PI / 180.0;
+    const double aLon = lonA * M_PI / 180.0;
+    const double bLat = latB * M_PI / 180.0;
+    const double bLon = lonB * M_PI / 180.0;
+
+    auto toVec = [](double lat, double lon) {
+        return QVector3D(std::cos(lat) * std::cos(lon),
+                         std::cos(lat) * std::sin(lon),
+                         std::sin(lat));
+    };
+    QVector3D A = toVec(aLat, aLon).normalized();
+    QVector3D B = toVec(bLat, bLon).normalized();
+
+    const float dot = QVector3D::dotProduct(A, B);
+    double omega = std::acos(std::clamp(static_cast<double>(dot), -1.0, 1.0));
+    if (omega < 1e-6)
+        return 0;
+
+    for (int i = 0; i < segments; ++i) {
+        const double t = static_cast<double>(i) / (segments - 1);
+        const double sinOmega = std::sin(omega);
+        const double wA = std::sin((1 - t) * omega) / sinOmega;
+        const double wB = std::sin(t * omega) / sinOmega;
+        QVector3D P = A * wA + B * wB;
+        P.normalize();
+        const double lat = std::asin(std::clamp(static_cast<double>(P.z()), -1.0, 1.0)) * 180.0 / M_PI;
+        const double lon = std::atan2(P.y(), P.x()) * 180.0 / M_PI;
+        const QPointF p = Projection::projectWrapped(mapping, lat, lon);
+        xy[2 * i] = float(p.x());
+        xy[2 * i + 1] = float(p.y());
+    }
+    return segments;
+}
+
+void markUploaded(QSGGeometryNode *node, SatelliteLayerNode::Stats &stats)
+{
+    QSGGeometry *geom = node->geometry();
+    geom->markVertexDataDirty();
+    node->markDirty(QSGNode::DirtyGeometry);
+    ++stats.dirtyChunks;
+    stats.uploadBytes += qint64(geom->vertexCount()) * geom->sizeOfVertex();
+}
+
+void setColor(QSGGeometryNode *node, const QColor &color, const QRectF &mapRect = {})
+{
+    if (auto *compact = dynamic_cast<CompactLineMaterial *>(node->material())) {
+        if (compact->color() == color && compact->mapRect() == mapRect)
+            return;
+        compact->setColor(color);
+        compact->setMapRect(mapRect);
+        node->markDirty(QSGNode::DirtyMaterial);
+        return;
+    }
+    auto *mat = static_cast<QSGFlatColorMaterial *>(node->material());
+    if (mat->color() == color)
+        return;
+    mat->setColor(color);
+    node->markDirty(QSGNode::DirtyMaterial);
+}
+
+bool operator!=(const Projection::Mapping &a, const Projection::Mapping &b)
+{
+    return a.x != b.x || a.y != b.y || a.width != b.width || a.height != b.height || a.centerLongitude != b.centerLongitude;
+}
+
+qint64 capacityBytes(const QSGGeometryNode *node)
+{
+    const QSGGeometry *geom = node->geometry();
+    return qint64(geom->vertexCount()) * geom->sizeOfVertex();
+}
+}
+
+SatelliteLayerNode::SatelliteLayerNode(QQuickWindow *window)
+    : m_pastGroup(new QSGNode)
+    , m_futureGroup(new QSGNode)
+    , m_dotGroup(new QSGNode)
+    , m_dots(new DotBufferNode(window))
+{
+    // Draw order: tracks under dots.
+    appendChildNode(m_pastGroup);
+    appendChildNode(m_futureGroup);
+    appendChildNode(m_dotGroup);
+    m_dotGroup->appendChildNode(m_dots);
+}
+
+QSGGeometryNode *SatelliteLayerNode::createChunkNode(QSGNode *group, QSGGeometry::DrawingMode mode, const QColor &color)
+{
+    // Track lines may use the compact layout; seam and cluster dots are sized in pixels and stay in item coordinates.
+    const bool compact = m_compactTracks && mode == QSGGeometry::DrawLines;
+    auto *node = new QSGGeometryNode();
+    auto *geom = new QSGGeometry(compact ? CompactPoint2D::attributes() : QSGGeometry::defaultAttributes_Point2D(), 0);
+    geom->setDrawingMode(mode);
+    geom->setVertexDataPattern(QSGGeometry::DynamicPattern); // uploaded only after markVertexDataDirty()
+    if (mode == QSGGeometry::DrawLines)
+        geom->setLineWidth(0.5f);
+    node->setGeometry(geom);
+    node->setFlag(QSGNode::OwnsGeometry);
+    if (compact) {
+        auto *mat = new CompactLineMaterial();
+        mat->setColor(color);
+        mat->setMapRect(m_rect);
+        node->setMaterial(mat);
+    } else {
+        auto *mat = new QSGFlatColorMaterial();
+        mat->setColor(color);
+        node->setMaterial(mat);
+    }
+    node->setFlag(QSGNode::OwnsMaterial);
+    group->appendChildNode(node);
+    return node;
+}
+
+void SatelliteLayerNode::prepare(const SatelliteStore &sats, const Projection::Mapping &mapping, const QRectF &rect,
+                                 const QRectF &visible, const Style &style, int vertexLimit)
+{
+    Style clamped = style;
+    clamped.dotSegments = std::clamp(style.dotSegments, 3, VertexArena::MaxDotSegments);
+    clamped.arcSamples = std::clamp(style.arcSamples, 2, MaxArcSamples);
+    if (clamped.arcSamples != m_style.arcSamples)
+        m_tracksChanged = true;
+    if (clamped.dotRadius != m_style.dotRadius || clamped.dotSegments != m_style.dotSegments)
+        m_dotsChanged = true;
+    if (clamped.compactTracks != m_compactTracks) {
+        // Switching layouts recreates every chunk.
+        for (const Chunk &chunk : std::as_const(m_chunks)) {
+            for (QSGGeometryNode *node : {chunk.past, chunk.future}) {
+                node->parent()->removeChildNode(node);
+                delete node;
+            }
+        }
+        m_chunks.clear();
+        m_trackKey.clear();
+        m_compactTracks = clamped.compactTracks;
+        m_tracksChanged = true;
+    }
+    // Compact track geometry is in map units, so only a new centre longitude rewrites it; a resize moves it through
+    // the material.
+    const Projection::Mapping trackMapping = m_compactTracks ? compactMapping(mapping.centerLongitude) : mapping;
+    if (trackMapping != m_trackMapping || (!m_compactTracks && visible != m_visible)) {
+        m_trackMapping = trackMapping;
+        m_tracksChanged = true;
+    }
+    for (const Chunk &chunk : std::as_const(m_chunks)) {
+        setColor(chunk.past, clamped.pastColor, rect);
+        setColor(chunk.future, clamped.futureColor, rect);
+    }
+    if (m_dots->color() != clamped.dotColor) {
+        m_dots->setColor(clamped.dotColor);
+        m_dots->markDirty(QSGNode::DirtyMaterial);
+    }
+    if (m_seamDots)
+        setColor(m_seamDots, clamped.dotColor);
+    if (m_clusterDots)
+        setColor(m_clusterDots, clamped.dotColor);
+    m_style = clamped;
+    m_rect = rect;
+    m_visible = visible;
+    m_vertexLimit = vertexLimit;
+
+    const int n = sats.size();
+    m_projected.resize(2 * n);
+    Projection::projectWrapped(mapping, sats.lat(), sats.lon(), n, 1, m_projected.data());
+
+    const int slotCount = sats.slotCount();
+    m_rowBySlot.resize(slotCount);
+    m_rowBySlot.fill(-1);
+    for (int row = 0; row < n; ++row)
+        m_rowBySlot[sats.slot(row)] = row;
+
+    const int chunkCount = (slotCount + ChunkSlots - 1) / ChunkSlots;
+    while (m_chunks.size() < chunkCount) {
+        m_chunks.append({createChunkNode(m_pastGroup, QSGGeometry::DrawLines, m_style.pastColor),
+                         createChunkNode(m_futureGroup, QSGGeometry::DrawLines, m_style.futureColor)});
+    }
+    while (m_chunks.size() > chunkCount) {
+        const Chunk chunk = m_chunks.takeLast();
+        for (QSGGeometryNode *node : {chunk.past, chunk.future}) {
+            node->parent()->removeChildNode(node);
+            delete node;
+        }
+    }
+    // Slots of new chunks start empty, matching their empty geometry.
+    m_dotKey.resize(qsizetype(chunkCount) * ChunkSlots);
+    m_trackKey.resize(qsizetype(chunkCount) * ChunkSlots);
+
+    // Dots: every drawn slot has room for one dot; fewer segments first, then fewer slots.
+    const int segments = VertexArena::dotSegmentsFor(slotCount, m_style.dotSegments, vertexLimit);
+    m_dotSegments = segments; // a change reallocates, and so rewrites, the dot buffer in updateDots
+    m_drawnDotSlots = int(std::min<qint64>(slotCount, vertexLimit / (3 * segments)));
+    m_dotsReduced = segments < m_style.dotSegments || m_drawnDotSlots < slotCount;
+
+    // Tracks: thin sampled tracks (and straighten arcs) until the layer fits.
+    qint64 points[2] = {0, 0};
+    int tracks[2] = {0, 0};
+    int arcs[2] = {0, 0};
+    const double *latEnd[2] = {sats.latPast(), sats.latFuture()};
+    const double *lonEnd[2] = {sats.lonPast(), sats.lonFuture()};
+    for (int row = 0; row < n; ++row) {
+        for (int k = 0; k < 2; ++k) {
+            const QVector<GeoPoint> &track = k == 0 ? sats.trackPast(row) : sats.trackFuture(row);
+            if (!track.isEmpty()) {
+                points[k] += track.size();
+                ++tracks[k];
+            } else if (std::isfinite(latEnd[k][row]) && std::isfinite(lonEnd[k][row])) {
+                ++arcs[k];
+            }
+        }
+    }
+    int *steps[2] = {&m_pastStep, &m_futureStep};
+    int *samples[2] = {&m_pastSamples, &m_futureSamples};
+    for (int k = 0; k < 2; ++k) {
+        int sampleCount = m_style.arcSamples;
+        int step = VertexArena::lodStride(2 * points[k] + 2 * (sampleCount - 1) * qint64(arcs[k]), vertexLimit);
+        if (step > 1) {
+            sampleCount = 2;
+            const qint64 room = std::max<qint64>(vertexLimit - 2 * (qint64(tracks[k]) + arcs[k]), 1);
+            step = std::max(2, VertexArena::lodStride(2 * points[k], int(std::min<qint64>(room, vertexLimit))));
+        }
+        if (step != *steps[k] || sampleCount != *samples[k])
+            m_tracksChanged = true;
+        *steps[k] = step;
+        *samples[k] = sampleCount;
+    }
+}
+
+void SatelliteLayerNode::updateTracks(const SatelliteStore &sats, Stats &stats)
+{
+    const double *lat = sats.lat();
+    const double *lon = sats.lon();
+    const double *latPast = sats.latPast();
+    const double *lonPast = sats.lonPast();
+    const double *latFuture = sats.latFuture();
+    const double *lonFuture = sats.lonFuture();
+    const int slotCount = int(m_rowBySlot.size());
+
+    for (int c = 0; c < m_chunks.size(); ++c) {
+        bool dirty = m_tracksChanged;
+        const int end = std::min((c + 1) * ChunkSlots, slotCount);
+        for (int slot = c * ChunkSlots; slot < end; ++slot) {
+            const qint32 row = m_rowBySlot[slot];
+            quint64 key = 0;
+            if (row >= 0) {
+                // Geographic, so a mapping change is handled once per frame (m_tracksChanged) rather than per slot.
+                for (double v : {lat[row], lon[row], latPast[row], lonPast[row], latFuture[row], lonFuture[row]})
+                    key = mixKey(key, bitsOf(v));
+                key = finishKey(trackKey(trackKey(key, sats.trackPast(row)), sats.trackFuture(row)));
+            }
+            if (key != m_trackKey[slot]) {
+                m_trackKey[slot] = key;
+                dirty = true;
+            }
+        }
+        // Slots past the end of the range were emptied when the range shrank.
+        for (int slot = end; slot < (c + 1) * ChunkSlots; ++slot) {
+            if (m_trackKey[slot]) {
+                m_trackKey[slot] = 0;
+                dirty = true;
+            }
+        }
+        if (dirty) {
+            writeTrackChunk(sats, c, true, stats);
+            writeTrackChunk(sats, c, false, stats);
+        }
+        const Chunk &chunk = m_chunks[c];
+        stats.vertices[PastTracks] += chunk.pastUsed;
+        stats.vertices[FutureTracks] += chunk.futureUsed;
+        stats.bytes[PastTracks] += capacityBytes(chunk.past);
+        stats.bytes[FutureTracks] += capacityBytes(chunk.future);
+    }
+    m_tracksChanged = false;
+    stats.reduced[PastTracks] = m_pastStep > 1;
+    stats.reduced[FutureTracks] = m_futureStep > 1;
+    stats.chunks += 2 * int(m_chunks.size());
+}
+
+void SatelliteLayerNode::writeTrackChunk(const SatelliteStore &sats, int c, bool past, Stats &stats)
+{
+    Chunk &chunk = m_chunks[c];
+    QSGGeometryNode *node = past ? chunk.past : chunk.future;
+    const int step = past ? m_pastStep : m_futureStep;
+    const int arcSamples = past ? m_pastSamples : m_futureSamples;
+    const double *latEnd = past ? sats.latPast() : sats.latFuture();
+    const double *lonEnd = past ? sats.lonPast() : sats.lonFuture();
+    const int end = std::min((c + 1) * ChunkSlots, int(m_rowBySlot.size()));
+
+    int cap = 0;
+    for (int slot = c * ChunkSlots; slot < end; ++slot) {
+        const qint32 row = m_rowBySlot[slot];
+        if (row < 0)
+            continue;
+        if (const qsizetype m = (past ? sats.trackPast(row) : sats.trackFuture(row)).size())
+            cap += 2 * int(m / step + 1);
+        else if (std::isfinite(latEnd[row]) && std::isfinite(lonEnd[row]))
+            cap += 2 * (arcSamples - 1);
+    }
+
+    QSGGeometry *geom = node->geometry();
+    void *data = VertexArena::reserveData(geom, cap);
+    const int used = m_compactTracks ? writeTracks(static_cast<CompactPoint2D *>(data), cap, sats, c, past)
+                                     : writeTracks(static_cast<QSGGeometry::Point2D *>(data), cap, sats, c, past);
+    VertexArena::finish(geom, used);
+    (past ? chunk.pastUsed : chunk.futureUsed) = used;
+    markUploaded(node, stats);
+}
+
+template <typename Vertex>
+int SatelliteLayerNode::writeTracks(Vertex *v, int cap, const SatelliteStore &sats, int c, bool past)
+{
+    const Projection::Mapping &mapping = m_trackMapping;
+    const QRectF visible = m_compactTracks ? QRectF() : m_visible;
+    const int step = past ? m_pastStep : m_futureStep;
+    const int arcSamples = past ? m_pastSamples : m_futureSamples;
+    const double *latEnd = past ? sats.latPast() : sats.latFuture();
+    const double *lonEnd = past ? sats.lonPast() : sats.lonFuture();
+    const double *lat = sats.lat();
+    const double *lon = sats.lon();
+    const int end = std::min((c + 1) * ChunkSlots, int(m_rowBySlot.size()));
+
+    int idx = 0;
+    float arc[2 * MaxArcSamples];
+    for (int slot = c * ChunkSlots; slot < end; ++slot) {
+        const qint32 row = m_rowBySlot[slot];
+        if (row < 0)
+            continue;
+        if (const QVector<GeoPoint> &track = past ? sats.trackPast(row) : sats.trackFuture(row); !track.isEmpty()) {
+            // The current position closes a past track and opens a future one.
+            const int n = int(track.size()) + 1;
+            m_scratch.resize(2 * n);
+            float *xy = m_scratch.data();
+            Projection::projectWrapped(mapping, &track.constData()->lat, &track.constData()->lon, track.size(), 2, xy + (past ? 0 : 2));
+            Projection::projectWrapped(mapping, lat + row, lon + row, 1, 1, xy + (past ? 2 * (n - 1) : 0));
+            idx = VertexArena::writePolyline(v, idx, cap, xy, n, step, mapping.width, visible);
+        } else if (std::isfinite(latEnd[row]) && std::isfinite(lonEnd[row])) {
+            const int n = past ? sampleArc(mapping, latEnd[row], lonEnd[row], lat[row], lon[row], arcSamples, arc)
+                               : sampleArc(mapping, lat[row], lon[row], latEnd[row], lonEnd[row], arcSamples, arc);
+            idx = VertexArena::writePolyline(v, idx, cap, arc, n, 1, mapping.width, visible);
+        }
+    }
+    return idx;
+}
+
+bool SatelliteLayerNode::isDotVisible(int row) const
+{
+    const qreal r = m_style.dotRadius;
+    const float x = m_projected[2 * row];
+    const float y = m_projected[2 * row + 1];
+    return x >= m_visible.left() - r && x <= m_visible.right() + r && y >= m_visible.top() - r && y <= m_visible.bottom() + r;
+}
+
+void SatelliteLayerNode::updateClusters(Stats &stats)
+{
+    const int slotCount = int(m_rowBySlot.size());
+    m_grid.configure(m_visible, m_style.declutterCell, m_style.declutterThreshold);
+    m_grid.resize(slotCount);
+    if (!m_grid.isEnabled()) {
+        if (m_clusterDots) {
+            m_dotGroup->removeChildNode(m_clusterDots);
+            delete m_clusterDots;
+            m_clusterDots = nullptr;
+        }
+        m_clusters.clear();
+        m_clusteredObjects = 0;
+        m_clusterUsed = 0;
+        m_clustersReduced = false;
+        return;
+    }
+
+    // Only slots that moved (or came and went) touch their cells; objects out of view are off the grid.
+    for (int slot = 0; slot < slotCount; ++slot) {
+        const qint32 row = m_rowBySlot[slot];
+        if (row < 0 || !isDotVisible(row))
+            m_grid.remove(slot);
+        else
+            m_grid.place(slot, m_projected[2 * row], m_projected[2 * row + 1]);
+    }
+    bool rebuild = m_grid.takeChanged() || m_dotsChanged;
+    if (!m_clusterDots) {
+        m_clusterDots = createChunkNode(m_dotGroup, QSGGeometry::DrawTriangles, m_style.dotColor);
+        rebuild = true;
+    }
+
+    if (rebuild) {
+        m_clusteredObjects = m_grid.clusters(m_clusters);
+        // Markers grow with the log of their count up to half a cell, with copies across the seam as for dots.
+        m_scratch.clear();
+        const float left = float(m_rect.x());
+        const float right = float(m_rect.x() + m_rect.width());
+        const float w = float(m_rect.width());
+        const float maxRadius = 0.5f * float(m_style.declutterCell);
+        for (const DeclutterGrid::Cluster &cluster : std::as_const(m_clusters)) {
+            const float r = std::min(maxRadius, float(m_style.dotRadius * (1.0 + 0.5 * std::log2(double(cluster.count)))));
+            m_scratch.append({cluster.x, cluster.y, r});
+            if (cluster.x - r < left)
+                m_scratch.append({cluster.x + w, cluster.y, r});
+            else if (cluster.x + r > right)
+                m_scratch.append({cluster.x - w, cluster.y, r});
+        }
+        const int segments = VertexArena::MaxDotSegments;
+        const int perMarker = 3 * segments;
+        const int markers = int(std::min<qint64>(m_scratch.size() / 3, m_vertexLimit / perMarker));
+        QSGGeometry *geom = m_clusterDots->geometry();
+        QSGGeometry::Point2D *v = VertexArena::reserve(geom, markers * perMarker);
+        std::array<float, 2 * (VertexArena::MaxDotSegments + 1)> ring;
+        for (int i = 0; i < markers; ++i) {
+            VertexArena::dotRing(segments, m_scratch[3 * i + 2], ring.data());
+            VertexArena::writeDot(v + i * perMarker, m_scratch[3 * i], m_scratch[3 * i + 1], ring.data(), segments);
+        }
+        m_clusterUsed = markers * perMarker;
+        VertexArena::finish(geom, m_clusterUsed);
+        markUploaded(m_clusterDots, stats);
+        m_clustersReduced = markers < m_scratch.size() / 3;
+    }
+    stats.clusters = int(m_clusters.size());
+    stats.clusteredObjects = m_clusteredObjects;
+}
+
+void SatelliteLayerNode::updateDots(const SatelliteStore &sats, Stats &stats)
+{
+    updateClusters(stats);
+
+    const int segments = m_dotSegments;
+    const int vertsPerSlot = 3 * segments;
+    std::array<float, 2 * (VertexArena::MaxDotSegments + 1)> ring;
+    VertexArena::dotRing(segments, float(m_style.dotRadius), ring.data());
+
+    // Only slots whose dot changed are written, and so uploaded; a new size or style rewrites the buffer.
+    const bool reallocated = m_dots->slotCount() != m_drawnDotSlots || m_dots->verticesPerSlot() != vertsPerSlot;
+    if (reallocated)
+        m_dots->resize(m_drawnDotSlots, vertsPerSlot);
+    const bool rewrite = reallocated || m_dotsChanged;
+    int used = 0;
+    for (int slot = 0; slot < m_drawnDotSlots; ++slot) {
+        const qint32 row = m_rowBySlot[slot];
+        // A dot out of view or in a cluster is hidden like an empty slot.
+        const bool hidden = row < 0 || !isDotVisible(row) || m_grid.isClustered(slot);
+        const quint64 key = hidden ? 0 : finishKey(bitsOf(m_projected.constData() + 2 * row));
+        if (!hidden)
+            used += vertsPerSlot;
+        if (!rewrite && key == m_dotKey[slot])
+            continue;
+        m_dotKey[slot] = key;
+        QSGGeometry::Point2D *slotVertices = m_dots->writeSlot(slot);
+        if (hidden)
+            std::fill(slotVertices, slotVertices + vertsPerSlot, QSGGeometry::Point2D {0.0f, 0.0f});
+        else
+            VertexArena::writeDot(slotVertices, m_projected[2 * row], m_projected[2 * row + 1], ring.data(), segments);
+    }
+    if (const int ranges = m_dots->pendingRanges()) {
+        m_dots->markDirty(QSGNode::DirtyMaterial);
+        stats.dirtyChunks += ranges;
+        stats.uploadBytes += m_dots->pendingBytes();
+    }
+    stats.bytes[Dots] += m_dots->capacityBytes();
+
+    // Copies across the seam for dots near the map edges that land in view, from drawn slots only.
+    m_scratch.clear();
+    const float r = float(m_style.dotRadius);
+    const float left = float(m_rect.x()) + r;
+    const float right = float(m_rect.x() + m_rect.width()) - r;
+    const float w = float(m_rect.width());
+    const QRectF inView = m_visible.adjusted(-r, -r, r, r);
+    for (int row = 0; row < sats.size(); ++row) {
+        const float x = m_projected[2 * row];
+        const float y = m_projected[2 * row + 1];
+        const int slot = sats.slot(row);
+        if ((x >= left && x <= right) || slot >= m_drawnDotSlots || m_grid.isClustered(slot))
+            continue;
+        const float copy = x < left ? x + w : x - w;
+        if (!inView.contains(copy, y))
+            continue;
+        m_scratch.append(copy);
+        m_scratch.append(y);
+    }
+    const int seamCount = int(m_scratch.size() / 2);
+    if (!m_seamDots)
+        m_seamDots = createChunkNode(m_dotGroup, QSGGeometry::DrawTriangles, m_style.dotColor);
+    QSGGeometry *seamGeom = m_seamDots->geometry();
+    QSGGeometry::Point2D *v = VertexArena::reserve(seamGeom, seamCount * vertsPerSlot);
+    for (int i = 0; i < seamCount; ++i)
+        VertexArena::writeDot(v + i * vertsPerSlot, m_scratch[2 * i], m_scratch[2 * i + 1], ring.data(), segments);
+    VertexArena::finish(seamGeom, seamCount * vertsPerSlot);
+    if (seamCount || m_seamUsed)
+        markUploaded(m_seamDots, stats);
+    m_seamUsed = seamCount * vertsPerSlot;
+
+    m_dotsChanged = false;
+    stats.vertices[Dots] = used + m_seamUsed + m_clusterUsed;
+    stats.bytes[Dots] += capacityBytes(m_seamDots) + (m_clusterDots ? capacityBytes(m_clusterDots) : 0);
+    stats.reduced[Dots] = m_dotsReduced || m_clustersReduced;
+    stats.chunks += 2 + (m_clusterDots ? 1 : 0); // the dot buffer and the seam node
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <QColor>
+#include <QRectF>
+#include <QSGGeometryNode>
+#include <QSGNode>
+#include <QVector>
+#include <array>
+
+#include "DeclutterGrid.h"
+#include "DotBufferNode.h"
+#include "Projection.h"
+#include "SatelliteStore.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Satellite dots and tracks over stable slots (SatelliteStore::slot). Each slot's last drawn state is kept as a key, and
+// a batch that moves a few objects rewrites only what they touch. Dots have a fixed size per slot, so they live in one
+// RHI buffer (DotBufferNode) and only the changed slots are uploaded. Tracks vary in length with the object and the
+// level of detail, so they stay in fixed-size chunks of slots, one geometry node per chunk and layer; chunks are larger
+// than the batch renderer's merge threshold, so each keeps its own vertex buffer and only chunks holding a changed
+// track are re-uploaded. Dot copies across the seam go to one small node rebuilt every frame. With decluttering on,
+// dots in dense grid cells are hidden (their slots written empty) and drawn as one count-sized marker per cell in a
+// cluster node.
+class SatelliteLayerNode : public QSGNode
+{
+public:
+    static constexpr int ChunkSlots = 512;
+
+    enum Layer {
+        PastTracks,
+        FutureTracks,
+        Dots,
+        LayerCount
+    };
+
+    struct Style
+    {
+        QColor pastColor;
+        QColor futureColor;
+        QColor dotColor;
+        qreal dotRadius {3.0};
+        int dotSegments {8};
+        int arcSamples {4};
+        bool compactTracks {false}; // CompactLineMaterial track geometry (RHI backends only)
+        int declutterCell {0};      // grid cell in pixels, 0: every dot drawn
+        int declutterThreshold {4}; // objects in a cell that make it a cluster
+    };
+
+    struct Stats
+    {
+        std::array<int, LayerCount> vertices {};
+        std::array<qint64, LayerCount> bytes {};   // geometry capacity
+        std::array<bool, LayerCount> reduced {};   // drawn at lower detail because of the vertex limit
+        int chunks {0};
+        int dirtyChunks {0};                        // track geometries and dot ranges marked for upload this frame
+        int clusters {0};
+        int clusteredObjects {0};
+        qint64 uploadBytes {0};
+    };
+
+    // The window provides the RHI for the dot buffer.
+    explicit SatelliteLayerNode(QQuickWindow *window);
+
+    // Projects the batch, applies the vertex limit (per layer) and keeps the chunk nodes in step with the slot range.
+    // `rect` is the whole map in item pixels, as in `mapping`; only dots and track segments inside `visible` are written
+    // (compact tracks, placed by their material, are not culled).
+    void prepare(const SatelliteStore &sats, const Projection::Mapping &mapping, const QRectF &rect, const QRectF &visible,
+                 const Style &style, int vertexLimit);
+    // Rewrite the chunks whose slots changed since the last frame. Call after prepare().
+    void updateTracks(const SatelliteStore &sats, Stats &stats);
+    void updateDots(const SatelliteStore &sats, Stats &stats);
+
+private:
+    struct Chunk
+    {
+        QSGGeometryNode *past {nullptr};
+        QSGGeometryNode *future {nullptr};
+        int pastUsed {0}; // vertices before the degenerate tail
+        int futureUsed {0};
+    };
+
+    QSGGeometryNode *createChunkNode(QSGNode *group, QSGGeometry::DrawingMode mode, const QColor &color);
+    void writeTrackChunk(const SatelliteStore &sats, int chunk, bool past, Stats &stats);
+    template <typename Vertex>
+    int writeTracks(Vertex *v, int cap, const SatelliteStore &sats, int chunk, bool past);
+    void updateClusters(Stats &stats);
+    bool isDotVisible(int row) const;
+
+    QSGNode *m_pastGroup {nullptr};
+    QSGNode *m_futureGroup {nullptr};
+    QSGNode *m_dotGroup {nullptr};
+    DotBufferNode *m_dots {nullptr};
+    QSGGeometryNode *m_seamDots {nullptr};
+    QSGGeometryNode *m_clusterDots {nullptr};
+    QVector<Chunk> m_chunks;
+    Style m_style;
+    QRectF m_rect;
+    QRectF m_visible;
+    Projection::Mapping m_trackMapping; // pixels, or map units for compact tracks
+    bool m_compactTracks {false};
+    DeclutterGrid m_grid;
+    QVector<DeclutterGrid::Cluster> m_clusters;
+
+    // Per slot: key of what was last written, 0 for an empty slot.
+    QVector<quint64> m_dotKey;
+    QVector<quint64> m_trackKey;
+    QVector<qint32> m_rowBySlot; // current batch
+    QVector<float> m_projected;  // per row
+    QVector<float> m_scratch;    // track points and seam centres
+
+    int m_dotSegments {0};
+    int m_drawnDotSlots {0};
+    int m_pastStep {1};
+    int m_futureStep {1};
+    int m_pastSamples {0};
+    int m_futureSamples {0};
+    int m_seamUsed {0};
+    int m_clusterUsed {0};
+    int m_clusteredObjects {0};
+    int m_vertexLimit {0};
+    bool m_tracksChanged {true}; // LOD or style change: rewrite every track chunk
+    bool m_dotsChanged {true};
+    bool m_dotsReduced {false};
+    bool m_clustersReduced {false};
+};
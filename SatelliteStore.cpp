@@ -0,0 +1,257 @@
+#include "SatelliteStore.h"
+
+#include <cmath>
+#include <limits>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+namespace
+{
+constexpr quint32 NoId = std::numeric_limits<quint32>::max();
+constexpr double Missing = std::numeric_limits<double>::quiet_NaN();
+
+double readField(const QVariantMap &m, const QString &key)
+{
+    const auto it = m.constFind(key);
+    if (it == m.constEnd())
+        return Missing;
+    bool ok = false;
+    const double val = it->toDouble(&ok);
+    return ok && std::isfinite(val) ? val : Missing;
+}
+
+const QVector<GeoPoint> &emptyTrack()
+{
+    static const QVector<GeoPoint> empty;
+    return empty;
+}
+}
+
+void SatelliteStore::clear()
+{
+    for (QVector<double> *column : {&m_lat, &m_lon, &m_alt, &m_latPast, &m_lonPast, &m_latFuture, &m_lonFuture})
+        column->clear();
+    m_idHandle.clear();
+    m_slot.clear();
+    m_slotCount = 0;
+    m_sourceIndex.clear();
+    m_trackSlot.clear();
+    m_tracks.clear();
+    m_source.clear();
+    m_fromColumns = false;
+    m_rowByHandle.fill(-1);
+}
+
+void SatelliteStore::resetIdsIfSparse(qsizetype batchSize)
+{
+    if (m_ids.size() > 2 * batchSize + 1024) {
+        m_ids.clear();
+        m_idLookup.clear();
+        m_numericIdLookup.clear();
+        m_rowByHandle.clear();
+    }
+}
+
+void SatelliteStore::assign(const QVariantList &source)
+{
+    clear();
+    m_source = source;
+    resetIdsIfSparse(source.size());
+
+    const qsizetype n = source.size();
+    for (QVector<double> *column : {&m_lat, &m_lon, &m_alt, &m_latPast, &m_lonPast, &m_latFuture, &m_lonFuture})
+        column->reserve(n);
+    m_idHandle.reserve(n);
+    m_sourceIndex.reserve(n);
+    m_trackSlot.reserve(n);
+
+    const QString idKey = QStringLiteral("ID");
+    const QString idKeyLower = QStringLiteral("id");
+    const QString latKey = QStringLiteral("Lat");
+    const QString lonKey = QStringLiteral("Lon");
+    const QString altKey = QStringLiteral("Alt");
+    const QString latPastKey = QStringLiteral("LatPast");
+    const QString lonPastKey = QStringLiteral("LonPast");
+    const QString latFutureKey = QStringLiteral("LatFuture");
+    const QString lonFutureKey = QStringLiteral("LonFuture");
+    const QString trackPastKey = QStringLiteral("TrackPast");
+    const QString trackFutureKey = QStringLiteral("TrackFuture");
+
+    for (qsizetype i = 0; i < n; ++i) {
+        const QVariantMap m = source[i].toMap();
+        const double lat = m.value(latKey).toDouble();
+        const double lon = m.value(lonKey).toDouble();
+        if (!std::isfinite(lat) || !std::isfinite(lon))
+            continue;
+        if (lat < -90.0 || lat > 90.0)
+            continue;
+
+        const QVariant idField = m.value(idKey, m.value(idKeyLower));
+        const int row = rowFor(idField.isValid() ? intern(idField.toString()) : NoId);
+        m_lat[row] = lat;
+        m_lon[row] = lon;
+        m_alt[row] = readField(m, altKey);
+        m_latPast[row] = readField(m, latPastKey);
+        m_lonPast[row] = readField(m, lonPastKey);
+        m_latFuture[row] = readField(m, latFutureKey);
+        m_lonFuture[row] = readField(m, lonFutureKey);
+        m_sourceIndex[row] = qint32(i);
+
+        Tracks tracks {geoPointsFromVariant(m.value(trackPastKey)), geoPointsFromVariant(m.value(trackFutureKey))};
+        if (tracks.past.isEmpty() && tracks.future.isEmpty()) {
+            m_trackSlot[row] = -1;
+        } else {
+            m_trackSlot[row] = qint32(m_tracks.size());
+            m_tracks.append(std::move(tracks));
+        }
+    }
+
+    assignSlots();
+}
+
+void SatelliteStore::assign(const CompactStates::Batch &batch)
+{
+    clear();
+    m_fromColumns = true;
+    const int n = batch.count();
+    if (batch.lat.size() != n || batch.lon.size() != n)
+        return;
+    resetIdsIfSparse(n);
+
+    for (QVector<double> *column : {&m_lat, &m_lon, &m_alt, &m_latPast, &m_lonPast, &m_latFuture, &m_lonFuture})
+        column->reserve(n);
+    m_idHandle.reserve(n);
+    m_sourceIndex.reserve(n);
+    m_trackSlot.reserve(n);
+
+    // Optional columns are empty or n long.
+    const auto value = [n](const QVector<double> &column, int i) {
+        return column.size() == n && std::isfinite(column[i]) ? column[i] : Missing;
+    };
+    for (int i = 0; i < n; ++i) {
+        const double lat = batch.lat[i];
+        const double lon = batch.lon[i];
+        if (!std::isfinite(lat) || !std::isfinite(lon))
+            continue;
+        if (lat < -90.0 || lat > 90.0)
+            continue;
+
+        const int row = rowFor(intern(batch.ids[i]));
+        m_lat[row] = lat;
+        m_lon[row] = lon;
+        m_alt[row] = value(batch.alt, i);
+        m_latPast[row] = value(batch.latPast, i);
+        m_lonPast[row] = value(batch.lonPast, i);
+        m_latFuture[row] = value(batch.latFuture, i);
+        m_lonFuture[row] = value(batch.lonFuture, i);
+    }
+    assignSlots();
+}
+
+int SatelliteStore::rowFor(quint32 handle)
+{
+    // An ID seen earlier in the batch keeps its row, which the caller overwrites: the last entry for an object wins,
+    // so each handle (and drawing slot) has exactly one row.
+    if (handle != NoId && m_rowByHandle[handle] >= 0)
+        return m_rowByHandle[handle];
+    const int row = size();
+    for (QVector<double> *column : {&m_lat, &m_lon, &m_alt, &m_latPast, &m_lonPast, &m_latFuture, &m_lonFuture})
+        column->append(Missing);
+    m_idHandle.append(handle);
+    m_sourceIndex.append(-1);
+    m_trackSlot.append(-1);
+    if (handle != NoId)
+        m_rowByHandle[handle] = row;
+    return row;
+}
+
+void SatelliteStore::assignSlots()
+{
+    m_slot.resize(size());
+    m_slotCount = int(m_ids.size());
+    for (int row = 0; row < size(); ++row)
+        m_slot[row] = m_idHandle[row] != NoId ? qint32(m_idHandle[row]) : qint32(m_slotCount++);
+}
+
+quint32 SatelliteStore::intern(const QString &id)
+{
+    const auto it = m_idLookup.constFind(id);
+    if (it != m_idLookup.constEnd())
+        return it.value();
+    const quint32 handle = quint32(m_ids.size());
+    m_ids.append(id);
+    m_idLookup.insert(id, handle);
+    m_rowByHandle.append(-1);
+    return handle;
+}
+
+quint32 SatelliteStore::intern(quint32 numericId)
+{
+    const auto it = m_numericIdLookup.constFind(numericId);
+    if (it != m_numericIdLookup.constEnd())
+        return it.value();
+    const quint32 handle = intern(QString::number(numericId));
+    m_numericIdLookup.insert(numericId, handle);
+    return handle;
+}
+
+const QVector<GeoPoint> &SatelliteStore::trackPast(int row) const
+{
+    const qint32 slot = m_trackSlot[row];
+    return slot < 0 ? emptyTrack() : m_tracks[slot].past;
+}
+
+const QVector<GeoPoint> &SatelliteStore::trackFuture(int row) const
+{
+    const qint32 slot = m_trackSlot[row];
+    return slot < 0 ? emptyTrack() : m_tracks[slot].future;
+}
+
+QString SatelliteStore::id(int row) const
+{
+    const quint32 handle = m_idHandle[row];
+    return handle == NoId ? QString() : m_ids[handle];
+}
+
+int SatelliteStore::rowOf(const QString &id) const
+{
+    const auto it = m_idLookup.constFind(id);
+    return it == m_idLookup.constEnd() ? -1 : m_rowByHandle[it.value()];
+}
+
+QVariantMap SatelliteStore::attributes(int row) const
+{
+    QVariantMap m;
+    if (m_sourceIndex[row] >= 0) {
+        m = m_source[m_sourceIndex[row]].toMap();
+    } else {
+        m.insert(QStringLiteral("Lat"), m_lat[row]);
+        m.insert(QStringLiteral("Lon"), m_lon[row]);
+        if (std::isfinite(m_alt[row]))
+            m.insert(QStringLiteral("Alt"), m_alt[row]);
+        if (std::isfinite(m_latPast[row]) && std::isfinite(m_lonPast[row])) {
+            m.insert(QStringLiteral("LatPast"), m_latPast[row]);
+            m.insert(QStringLiteral("LonPast"), m_lonPast[row]);
+        }
+        if (std::isfinite(m_latFuture[row]) && std::isfinite(m_lonFuture[row])) {
+            m.insert(QStringLiteral("LatFuture"), m_latFuture[row]);
+            m.insert(QStringLiteral("LonFuture"), m_lonFuture[row]);
+        }
+    }
+    const QString satId = id(row);
+    if (!satId.isEmpty())
+        m.insert(QStringLiteral("ID"), satId);
+    return m;
+}
+
+QVariantList SatelliteStore::toVariantList() const
+{
+    if (!m_fromColumns)
+        return m_source;
+    QVariantList list;
+    list.reserve(size());
+    for (int row = 0; row < size(); ++row)
+        list.append(attributes(row));
+    return list;
+}
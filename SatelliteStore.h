@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QVector>
+
+#include "CompactStates.h"
+#include "GeoTypes.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Column-wise satellite data for drawing and hit testing: contiguous position arrays (NaN where a value is absent),
+// interned IDs and a sparse track table. The input maps are not copied; each row keeps the index of its entry in the
+// source list, and attributes() materialises a map only when one is asked for (hover, tap). Column batches
+// (CompactStates::Batch) are taken without a map at all.
+class SatelliteStore
+{
+public:
+    // Rebuilds from a batch in the FeedCodec::decodeStates shape; entries without a usable position are skipped. An ID
+    // that appears more than once keeps the row of its first entry with the values of its last.
+    void assign(const QVariantList &source);
+    // The same from columns; numeric IDs are interned by value, so steady-state batches build no strings either.
+    void assign(const CompactStates::Batch &batch);
+    void clear();
+
+    int size() const { return int(m_lat.size()); }
+    bool isEmpty() const { return m_lat.isEmpty(); }
+
+    const double *lat() const { return m_lat.constData(); }
+    const double *lon() const { return m_lon.constData(); }
+    const double *alt() const { return m_alt.constData(); }
+    const double *latPast() const { return m_latPast.constData(); }
+    const double *lonPast() const { return m_lonPast.constData(); }
+    const double *latFuture() const { return m_latFuture.constData(); }
+    const double *lonFuture() const { return m_lonFuture.constData(); }
+
+    // Empty if the row has no sampled track.
+    const QVector<GeoPoint> &trackPast(int row) const;
+    const QVector<GeoPoint> &trackFuture(int row) const;
+
+    // Drawing slot, stable across batches for objects with an ID (their interned handle); rows without an ID get the
+    // slots after the handles. Slots lie in [0, slotCount()) and may be unused.
+    int slot(int row) const { return m_slot[row]; }
+    int slotCount() const { return m_slotCount; }
+
+    QString id(int row) const;
+    // Row of the satellite with this ID in the current batch, or -1.
+    int rowOf(const QString &id) const;
+
+    // The source entry, with the ID normalised to `ID`; for a column batch, built from the row's values.
+    QVariantMap attributes(int row) const;
+    // The batch in the decodeStates shape: the source list itself, or built from a column batch.
+    QVariantList toVariantList() const;
+
+private:
+    struct Tracks
+    {
+        QVector<GeoPoint> past;
+        QVector<GeoPoint> future;
+    };
+
+    quint32 intern(const QString &id);
+    quint32 intern(quint32 numericId);
+    void resetIdsIfSparse(qsizetype batchSize);
+    int rowFor(quint32 handle);
+    void assignSlots();
+
+    QVector<double> m_lat, m_lon, m_alt, m_latPast, m_lonPast, m_latFuture, m_lonFuture;
+    QVector<quint32> m_idHandle;     // into m_ids; NoId if the entry had none
+    QVector<qint32> m_slot;
+    int m_slotCount {0};
+    QVector<qint32> m_sourceIndex;   // into m_source; -1 for a column batch
+    QVector<qint32> m_trackSlot;     // into m_tracks, or -1
+    QVector<Tracks> m_tracks;
+    QVariantList m_source;           // shared with the caller's list, no deep copy
+    bool m_fromColumns {false};
+
+    // IDs are interned across batches (the same objects keep arriving), so steady-state updates do not allocate
+    // strings. The table is rebuilt when it grows well beyond the live set.
+    QVector<QString> m_ids;
+    QHash<QString, quint32> m_idLookup;
+    QHash<quint32, quint32> m_numericIdLookup; // column batch IDs
+    QVector<qint32> m_rowByHandle;   // per handle, row in the current batch or -1
+};
@@ -0,0 +1,342 @@
+#include "Sgp4.h"
+
+#include <cmath>
+#include <limits>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+namespace
+{
+constexpr double Pi = 3.14159265358979323846;
+constexpr double TwoPi = 2.0 * Pi;
+constexpr double DegToRad = Pi / 180.0;
+constexpr double RadToDeg = 180.0 / Pi;
+
+// WGS-72 gravity model, as SGP4 element sets are fitted with it.
+constexpr double Mu = 398600.8;
+constexpr double RadiusEarthKm = 6378.135;
+constexpr double J2 = 0.001082616;
+constexpr double J3 = -0.00000253881;
+constexpr double J4 = -0.00000165597;
+constexpr double J3oJ2 = J3 / J2;
+const double Xke = 60.0 / std::sqrt(RadiusEarthKm * RadiusEarthKm * RadiusEarthKm / Mu);
+
+// WGS-84 ellipsoid for the geodetic output.
+constexpr double Wgs84A = 6378.137;
+constexpr double Wgs84F = 1.0 / 298.257223563;
+constexpr double Wgs84E2 = Wgs84F * (2.0 - Wgs84F);
+}
+
+void Sgp4Propagator::clear()
+{
+    for (auto *col : {&m_epochJd, &m_no, &m_ecco, &m_inclo, &m_nodeo, &m_argpo, &m_mo, &m_bstar, &m_mdot, &m_argpdot,
+                      &m_nodedot, &m_nodecf, &m_cc1, &m_cc4, &m_cc5, &m_t2cof, &m_omgcof, &m_xmcof, &m_eta, &m_delmo,
+                      &m_sinmao, &m_d2, &m_d3, &m_d4, &m_t3cof, &m_t4cof, &m_t5cof, &m_xlcof, &m_aycof, &m_con41,
+                      &m_x1mth2, &m_x7thm1})
+        col->clear();
+    m_isimp.clear();
+}
+
+void Sgp4Propagator::reserve(std::size_t n)
+{
+    for (auto *col : {&m_epochJd, &m_no, &m_ecco, &m_inclo, &m_nodeo, &m_argpo, &m_mo, &m_bstar, &m_mdot, &m_argpdot,
+                      &m_nodedot, &m_nodecf, &m_cc1, &m_cc4, &m_cc5, &m_t2cof, &m_omgcof, &m_xmcof, &m_eta, &m_delmo,
+                      &m_sinmao, &m_d2, &m_d3, &m_d4, &m_t3cof, &m_t4cof, &m_t5cof, &m_xlcof, &m_aycof, &m_con41,
+                      &m_x1mth2, &m_x7thm1})
+        col->reserve(n);
+    m_isimp.reserve(n);
+}
+
+int Sgp4Propagator::add(const Sgp4Elements &el)
+{
+    const double ecco = el.eccentricity;
+    const double inclo = el.inclinationDeg * DegToRad;
+    const double nodeo = el.raanDeg * DegToRad;
+    const double argpo = el.argPerigeeDeg * DegToRad;
+    const double mo = el.meanAnomalyDeg * DegToRad;
+    const double noKozai = el.meanMotionRevDay * TwoPi / 1440.0; // rad/min
+    if (!(noKozai > 0.0) || !(ecco >= 0.0 && ecco < 1.0) || !std::isfinite(el.epochJd))
+        return -1;
+
+    // initl: recover the un-Kozai'd mean motion and semi-major axis.
+    const double x2o3 = 2.0 / 3.0;
+    const double eccsq = ecco * ecco;
+    const double omeosq = 1.0 - eccsq;
+    const double rteosq = std::sqrt(omeosq);
+    const double cosio = std::cos(inclo);
+    const double cosio2 = cosio * cosio;
+    const double ak = std::pow(Xke / noKozai, x2o3);
+    const double d1 = 0.75 * J2 * (3.0 * cosio2 - 1.0) / (rteosq * omeosq);
+    double del = d1 / (ak * ak);
+    const double adel = ak * (1.0 - del * del - del * (1.0 / 3.0 + 134.0 * del * del / 81.0));
+    del = d1 / (adel * adel);
+    const double no = noKozai / (1.0 + del);
+    if (TwoPi / no >= 225.0)
+        return -1; // deep space
+
+    const double ao = std::pow(Xke / no, x2o3);
+    const double sinio = std::sin(inclo);
+    const double po = ao * omeosq;
+    const double con42 = 1.0 - 5.0 * cosio2;
+    const double con41 = -con42 - cosio2 - cosio2;
+    const double posq = po * po;
+    const double rp = ao * (1.0 - ecco);
+
+    // sgp4init, near-Earth branch.
+    const double ss = 78.0 / RadiusEarthKm + 1.0;
+    const double qzms2t = std::pow((120.0 - 78.0) / RadiusEarthKm, 4);
+    const unsigned char isimp = rp < (220.0 / RadiusEarthKm + 1.0) ? 1 : 0;
+    double sfour = ss;
+    double qzms24 = qzms2t;
+    const double perige = (rp - 1.0) * RadiusEarthKm;
+    if (perige < 156.0) {
+        sfour = perige - 78.0;
+        if (perige < 98.0)
+            sfour = 20.0;
+        qzms24 = std::pow((120.0 - sfour) / RadiusEarthKm, 4);
+        sfour = sfour / RadiusEarthKm + 1.0;
+    }
+    const double pinvsq = 1.0 / posq;
+    const double tsi = 1.0 / (ao - sfour);
+    const double eta = ao * ecco * tsi;
+    const double etasq = eta * eta;
+    const double eeta = ecco * eta;
+    const double psisq = std::fabs(1.0 - etasq);
+    const double coef = qzms24 * std::pow(tsi, 4);
+    const double coef1 = coef / std::pow(psisq, 3.5);
+    const double cc2 = coef1 * no
+        * (ao * (1.0 + 1.5 * etasq + eeta * (4.0 + etasq))
+           + 0.375 * J2 * tsi / psisq * con41 * (8.0 + 3.0 * etasq * (8.0 + etasq)));
+    const double cc1 = el.bstar * cc2;
+    const double cc3 = ecco > 1.0e-4 ? -2.0 * coef * tsi * J3oJ2 * no * sinio / ecco : 0.0;
+    const double x1mth2 = 1.0 - cosio2;
+    const double cc4 = 2.0 * no * coef1 * ao * omeosq
+        * (eta * (2.0 + 0.5 * etasq) + ecco * (0.5 + 2.0 * etasq)
+           - J2 * tsi / (ao * psisq)
+               * (-3.0 * con41 * (1.0 - 2.0 * eeta + etasq * (1.5 - 0.5 * eeta))
+                  + 0.75 * x1mth2 * (2.0 * etasq - eeta * (1.0 + etasq)) * std::cos(2.0 * argpo)));
+    const double cc5 = 2.0 * coef1 * ao * omeosq * (1.0 + 2.75 * (etasq + eeta) + eeta * etasq);
+    const double cosio4 = cosio2 * cosio2;
+    const double temp1 = 1.5 * J2 * pinvsq * no;
+    const double temp2 = 0.5 * temp1 * J2 * pinvsq;
+    const double temp3 = -0.46875 * J4 * pinvsq * pinvsq * no;
+    const double mdot = no + 0.5 * temp1 * rteosq * con41 + 0.0625 * temp2 * rteosq * (13.0 - 78.0 * cosio2 + 137.0 * cosio4);
+    const double argpdot = -0.5 * temp1 * con42 + 0.0625 * temp2 * (7.0 - 114.0 * cosio2 + 395.0 * cosio4)
+        + temp3 * (3.0 - 36.0 * cosio2 + 49.0 * cosio4);
+    const double xhdot1 = -temp1 * cosio;
+    const double nodedot = xhdot1 + (0.5 * temp2 * (4.0 - 19.0 * cosio2) + 2.0 * temp3 * (3.0 - 7.0 * cosio2)) * cosio;
+    const double omgcof = el.bstar * cc3 * std::cos(argpo);
+    const double xmcof = ecco > 1.0e-4 ? -x2o3 * coef * el.bstar / eeta : 0.0;
+    const double nodecf = 3.5 * omeosq * xhdot1 * cc1;
+    const double t2cof = 1.5 * cc1;
+    const double xlcofDen = std::fabs(cosio + 1.0) > 1.5e-12 ? 1.0 + cosio : 1.5e-12;
+    const double xlcof = -0.25 * J3oJ2 * sinio * (3.0 + 5.0 * cosio) / xlcofDen;
+    const double aycof = -0.5 * J3oJ2 * sinio;
+    const double delmo = std::pow(1.0 + eta * std::cos(mo), 3);
+    const double sinmao = std::sin(mo);
+    const double x7thm1 = 7.0 * cosio2 - 1.0;
+
+    double d2 = 0.0, d3 = 0.0, d4 = 0.0, t3cof = 0.0, t4cof = 0.0, t5cof = 0.0;
+    if (!isimp) {
+        const double cc1sq = cc1 * cc1;
+        d2 = 4.0 * ao * tsi * cc1sq;
+        const double temp = d2 * tsi * cc1 / 3.0;
+        d3 = (17.0 * ao + sfour) * temp;
+        d4 = 0.5 * temp * ao * tsi * (221.0 * ao + 31.0 * sfour) * cc1;
+        t3cof = d2 + 2.0 * cc1sq;
+        t4cof = 0.25 * (3.0 * d3 + cc1 * (12.0 * d2 + 10.0 * cc1sq));
+        t5cof = 0.2 * (3.0 * d4 + 12.0 * cc1 * d3 + 6.0 * d2 * d2 + 15.0 * cc1sq * (2.0 * d2 + cc1sq));
+    }
+
+    m_epochJd.push_back(el.epochJd);
+    m_no.push_back(no);
+    m_ecco.push_back(ecco);
+    m_inclo.push_back(inclo);
+    m_nodeo.push_back(nodeo);
+    m_argpo.push_back(argpo);
+    m_mo.push_back(mo);
+    m_bstar.push_back(el.bstar);
+    m_mdot.push_back(mdot);
+    m_argpdot.push_back(argpdot);
+    m_nodedot.push_back(nodedot);
+    m_nodecf.push_back(nodecf);
+    m_cc1.push_back(cc1);
+    m_cc4.push_back(cc4);
+    m_cc5.push_back(cc5);
+    m_t2cof.push_back(t2cof);
+    m_omgcof.push_back(omgcof);
+    m_xmcof.push_back(xmcof);
+    m_eta.push_back(eta);
+    m_delmo.push_back(delmo);
+    m_sinmao.push_back(sinmao);
+    m_d2.push_back(d2);
+    m_d3.push_back(d3);
+    m_d4.push_back(d4);
+    m_t3cof.push_back(t3cof);
+    m_t4cof.push_back(t4cof);
+    m_t5cof.push_back(t5cof);
+    m_xlcof.push_back(xlcof);
+    m_aycof.push_back(aycof);
+    m_con41.push_back(con41);
+    m_x1mth2.push_back(x1mth2);
+    m_x7thm1.push_back(x7thm1);
+    m_isimp.push_back(isimp);
+    return int(m_epochJd.size() - 1);
+}
+
+bool Sgp4Propagator::positionTeme(std::size_t i, double t, double r[3]) const
+{
+    const double x2o3 = 2.0 / 3.0;
+
+    // Secular gravity and atmospheric drag.
+    const double xmdf = m_mo[i] + m_mdot[i] * t;
+    const double argpdf = m_argpo[i] + m_argpdot[i] * t;
+    const double nodedf = m_nodeo[i] + m_nodedot[i] * t;
+    double argpm = argpdf;
+    double mm = xmdf;
+    const double t2 = t * t;
+    double nodem = nodedf + m_nodecf[i] * t2;
+    double tempa = 1.0 - m_cc1[i] * t;
+    double tempe = m_bstar[i] * m_cc4[i] * t;
+    double templ = m_t2cof[i] * t2;
+
+    if (!m_isimp[i]) {
+        const double delomg = m_omgcof[i] * t;
+        const double delmtemp = 1.0 + m_eta[i] * std::cos(xmdf);
+        const double delm = m_xmcof[i] * (delmtemp * delmtemp * delmtemp - m_delmo[i]);
+        const double temp = delomg + delm;
+        mm = xmdf + temp;
+        argpm = argpdf - temp;
+        const double t3 = t2 * t;
+        const double t4 = t3 * t;
+        tempa = tempa - m_d2[i] * t2 - m_d3[i] * t3 - m_d4[i] * t4;
+        tempe = tempe + m_bstar[i] * m_cc5[i] * (std::sin(mm) - m_sinmao[i]);
+        templ = templ + m_t3cof[i] * t3 + t4 * (m_t4cof[i] + t * m_t5cof[i]);
+    }
+
+    const double no = m_no[i];
+    const double am = std::pow(Xke / no, x2o3) * tempa * tempa;
+    double em = m_ecco[i] - tempe;
+    if (em >= 1.0 || em < -0.001 || am < 0.95)
+        return false;
+    if (em < 1.0e-6)
+        em = 1.0e-6;
+    mm = mm + no * templ;
+    double xlm = mm + argpm + nodem;
+    nodem = std::fmod(nodem, TwoPi);
+    argpm = std::fmod(argpm, TwoPi);
+    xlm = std::fmod(xlm, TwoPi);
+    mm = std::fmod(xlm - argpm - nodem, TwoPi);
+
+    const double inclm = m_inclo[i];
+    const double sinip = std::sin(inclm);
+    const double cosip = std::cos(inclm);
+
+    // Long-period periodics.
+    const double axnl = em * std::cos(argpm);
+    double temp = 1.0 / (am * (1.0 - em * em));
+    const double aynl = em * std::sin(argpm) + temp * m_aycof[i];
+    const double xl = mm + argpm + nodem + temp * m_xlcof[i] * axnl;
+
+    // Kepler's equation, fixed-bound Newton iteration.
+    const double u = std::fmod(xl - nodem, TwoPi);
+    double eo1 = u;
+    double sineo1 = 0.0;
+    double coseo1 = 0.0;
+    for (int ktr = 0; ktr < 10; ++ktr) {
+        sineo1 = std::sin(eo1);
+        coseo1 = std::cos(eo1);
+        double tem5 = (u - aynl * coseo1 + axnl * sineo1 - eo1) / (1.0 - coseo1 * axnl - sineo1 * aynl);
+        tem5 = std::fmax(-0.95, std::fmin(0.95, tem5));
+        eo1 += tem5;
+        if (std::fabs(tem5) < 1.0e-12)
+            break;
+    }
+
+    // Short-period periodics.
+    const double ecose = axnl * coseo1 + aynl * sineo1;
+    const double esine = axnl * sineo1 - aynl * coseo1;
+    const double el2 = axnl * axnl + aynl * aynl;
+    const double pl = am * (1.0 - el2);
+    if (pl < 0.0)
+        return false;
+    const double rl = am * (1.0 - ecose);
+    const double betal = std::sqrt(1.0 - el2);
+    temp = esine / (1.0 + betal);
+    const double sinu = am / rl * (sineo1 - aynl - axnl * temp);
+    const double cosu = am / rl * (coseo1 - axnl + aynl * temp);
+    double su = std::atan2(sinu, cosu);
+    const double sin2u = (cosu + cosu) * sinu;
+    const double cos2u = 1.0 - 2.0 * sinu * sinu;
+    temp = 1.0 / pl;
+    const double temp1 = 0.5 * J2 * temp;
+    const double temp2 = temp1 * temp;
+
+    const double mrt = rl * (1.0 - 1.5 * temp2 * betal * m_con41[i]) + 0.5 * temp1 * m_x1mth2[i] * cos2u;
+    su = su - 0.25 * temp2 * m_x7thm1[i] * sin2u;
+    const double xnode = nodem + 1.5 * temp2 * cosip * sin2u;
+    const double xinc = inclm + 1.5 * temp2 * cosip * sinip * cos2u;
+    if (mrt < 1.0)
+        return false; // decayed
+
+    const double sinsu = std::sin(su);
+    const double cossu = std::cos(su);
+    const double snod = std::sin(xnode);
+    const double cnod = std::cos(xnode);
+    const double sini = std::sin(xinc);
+    const double cosi = std::cos(xinc);
+    const double xmx = -snod * cosi;
+    const double xmy = cnod * cosi;
+    r[0] = mrt * (xmx * sinsu + cnod * cossu) * RadiusEarthKm;
+    r[1] = mrt * (xmy * sinsu + snod * cossu) * RadiusEarthKm;
+    r[2] = mrt * (sini * sinsu) * RadiusEarthKm;
+    return true;
+}
+
+double Sgp4Propagator::gmst(double jdUt1)
+{
+    const double tut1 = (jdUt1 - 2451545.0) / 36525.0;
+    double temp = -6.2e-6 * tut1 * tut1 * tut1 + 0.093104 * tut1 * tut1
+        + (876600.0 * 3600.0 + 8640184.812866) * tut1 + 67310.54841; // seconds
+    temp = std::fmod(temp * DegToRad / 240.0, TwoPi);
+    if (temp < 0.0)
+        temp += TwoPi;
+    return temp;
+}
+
+void Sgp4Propagator::propagate(double jdUtc, double *latDeg, double *lonDeg, double *altKm, unsigned char *ok) const
+{
+    // UTC is used for UT1 (< 1 s difference, well below display resolution).
+    const double theta = gmst(jdUtc);
+    const double cosT = std::cos(theta);
+    const double sinT = std::sin(theta);
+    const double b = Wgs84A * std::sqrt(1.0 - Wgs84E2);
+    const double ep2 = (Wgs84A * Wgs84A - b * b) / (b * b);
+
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; ++i) {
+        double r[3];
+        const double tsince = (jdUtc - m_epochJd[i]) * 1440.0;
+        if (!positionTeme(i, tsince, r)) {
+            ok[i] = 0;
+            latDeg[i] = lonDeg[i] = altKm[i] = std::numeric_limits<double>::quiet_NaN();
+            continue;
+        }
+        ok[i] = 1;
+
+        // TEME -> Earth-fixed (polar motion ignored), then geodetic via Bowring.
+        const double x = cosT * r[0] + sinT * r[1];
+        const double y = -sinT * r[0] + cosT * r[1];
+        const double z = r[2];
+        const double p = std::sqrt(x * x + y * y);
+        const double th = std::atan2(Wgs84A * z, b * p);
+        const double sinTh = std::sin(th);
+        const double cosTh = std::cos(th);
+        const double lat = std::atan2(z + ep2 * b * sinTh * sinTh * sinTh, p - Wgs84E2 * Wgs84A * cosTh * cosTh * cosTh);
+        const double sinLat = std::sin(lat);
+        latDeg[i] = lat * RadToDeg;
+        lonDeg[i] = std::atan2(y, x) * RadToDeg;
+        altKm[i] = p * std::cos(lat) + z * sinLat - Wgs84A * std::sqrt(1.0 - Wgs84E2 * sinLat * sinLat);
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Mean elements as carried by a TLE or OMM (SGP4 theory, Kozai mean motion).
+struct Sgp4Elements
+{
+    double epochJd {0.0};          // UTC Julian date
+    double meanMotionRevDay {0.0}; // rev/day
+    double eccentricity {0.0};
+    double inclinationDeg {0.0};
+    double raanDeg {0.0};
+    double argPerigeeDeg {0.0};
+    double meanAnomalyDeg {0.0};
+    double bstar {0.0};            // 1/earth radii
+};
+
+// Batch SGP4 (near-Earth, WGS-72 constants, after Vallado et al. 2006). Per-satellite constants are held as
+// structure-of-arrays columns and the whole catalogue is evaluated for one epoch per call. The kernel is scalar: each
+// slot takes its own branches (simplified drag, the Kepler iteration), so batching saves per-object overhead and keeps
+// the columns contiguous but is not SIMD. Deep-space objects (period >= 225 min) need SDP4 and are rejected by add().
+class Sgp4Propagator
+{
+public:
+    // Returns the slot index, or -1 if the elements are invalid or deep-space.
+    int add(const Sgp4Elements &el);
+    void clear();
+    void reserve(std::size_t n);
+    std::size_t size() const { return m_epochJd.size(); }
+
+    // Geodetic (WGS-84) positions at the given UTC Julian date. ok[i] is 0, and the position NaN, for slots whose
+    // orbit has decayed or become invalid at that time.
+    void propagate(double jdUtc, double *latDeg, double *lonDeg, double *altKm, unsigned char *ok) const;
+
+    // TEME position in km at minutes since the slot's epoch (exposed for verification against reference vectors).
+    bool positionTeme(std::size_t i, double tsinceMin, double r[3]) const;
+
+    static double julianDateFromUnix(double unixSeconds) { return unixSeconds / 86400.0 + 2440587.5; }
+    static double gmst(double jdUt1);
+
+private:
+    // Per-slot constants from sgp4init; one column each.
+    std::vector<double> m_epochJd, m_no, m_ecco, m_inclo, m_nodeo, m_argpo, m_mo, m_bstar;
+    std::vector<double> m_mdot, m_argpdot, m_nodedot, m_nodecf, m_cc1, m_cc4, m_cc5, m_t2cof;
+    std::vector<double> m_omgcof, m_xmcof, m_eta, m_delmo, m_sinmao;
+    std::vector<double> m_d2, m_d3, m_d4, m_t3cof, m_t4cof, m_t5cof;
+    std::vector<double> m_xlcof, m_aycof, m_con41, m_x1mth2, m_x7thm1;
+    std::vector<unsigned char> m_isimp;
+};
@@ -0,0 +1,139 @@
+#include "ShmFeedSource.h"
+
+#include <QVector>
+#include <limits>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+namespace
+{
+constexpr qint64 ReportIntervalNs = 5000000000;
+constexpr qint64 ReopenIntervalNs = 1000000000;
+// Without a new frame for this long the name is checked for a restarted publisher's segment.
+constexpr qint64 StaleFrameNs = 2000000000;
+}
+
+ShmFeedSource::ShmFeedSource(QObject *parent)
+    : FeedSource(parent)
+{
+    m_timer.setTimerType(Qt::PreciseTimer);
+    m_timer.setInterval(16);
+    connect(&m_timer, &QTimer::timeout, this, &ShmFeedSource::poll);
+}
+
+ShmFeedSource::~ShmFeedSource()
+{
+    stop();
+}
+
+void ShmFeedSource::setName(const QString &name)
+{
+    m_name = name;
+}
+
+void ShmFeedSource::setPollIntervalMs(int ms)
+{
+    if (ms > 0)
+        m_timer.setInterval(ms);
+}
+
+void ShmFeedSource::start()
+{
+    if (m_timer.isActive())
+        return;
+    const qint64 now = qint64(ShmState::nowNs());
+    if (openSegment(now))
+        emit statusMessage(QStringLiteral("Reading shared-memory states from %1").arg(m_name));
+    else
+        emit statusMessage(QStringLiteral("Waiting for shared-memory segment %1 (%2)").arg(m_name, m_reader.errorString()));
+    m_lastReportNs = now;
+    m_timer.start();
+}
+
+void ShmFeedSource::stop()
+{
+    m_timer.stop();
+    m_reader.close();
+    clearElements();
+}
+
+bool ShmFeedSource::openSegment(qint64 now)
+{
+    m_lastProbeNs = now;
+    m_lastFrame = 0;
+    m_lastFrameNs = now;
+    return m_reader.open(m_name);
+}
+
+void ShmFeedSource::poll()
+{
+    const qint64 now = qint64(ShmState::nowNs());
+    if (m_reader.isOpen() && !m_reader.isCurrent()) {
+        m_reader.close();
+        m_lastProbeNs = now;
+        emit statusMessage(QStringLiteral("Publisher closed %1; waiting for it to return").arg(m_name));
+    } else if (m_reader.isOpen() && now - m_lastFrameNs >= StaleFrameNs && now - m_lastProbeNs >= ReopenIntervalNs) {
+        // A publisher that died without closing leaves its segment mapped here; a restarted one creates a new segment
+        // under the same name.
+        m_lastProbeNs = now;
+        ShmStateReader probe;
+        if (probe.open(m_name) && probe.generation() != m_reader.generation()) {
+            probe.close();
+            if (openSegment(now))
+                emit statusMessage(QStringLiteral("Publisher of %1 restarted; reading its new segment").arg(m_name));
+        }
+    }
+    if (!m_reader.isOpen()) {
+        if (now - m_lastProbeNs < ReopenIntervalNs || !openSegment(now))
+            return;
+        emit statusMessage(QStringLiteral("Reading shared-memory states from %1").arg(m_name));
+    }
+
+    const quint64 frame = m_reader.frame();
+    if (frame != m_lastFrame) {
+        m_lastFrame = frame;
+        m_lastFrameNs = now;
+        const quint32 count = m_reader.count();
+        // Straight into columns: the view takes them without a map per object.
+        CompactStates::Batch batch;
+        for (QVector<double> *column : {&batch.lat, &batch.lon, &batch.alt, &batch.latPast, &batch.lonPast,
+                                        &batch.latFuture, &batch.lonFuture})
+            column->reserve(int(count));
+        batch.ids.reserve(int(count));
+        ShmState::State st;
+        for (quint32 i = 0; i < count; ++i) {
+            if (!m_reader.read(i, st) || st.id > std::numeric_limits<quint32>::max()) {
+                ++m_skippedSlots;
+                continue;
+            }
+            batch.ids.append(quint32(st.id));
+            batch.lat.append(st.lat);
+            batch.lon.append(st.lon);
+            batch.alt.append(st.altKm);
+            batch.latPast.append(double(st.latPast));
+            batch.lonPast.append(double(st.lonPast));
+            batch.latFuture.append(double(st.latFuture));
+            batch.lonFuture.append(double(st.lonFuture));
+        }
+        m_latencySumMs += double(now - qint64(m_reader.frameTimeNs())) / 1e6;
+        ++m_framesSinceReport;
+        BatchTiming timing;
+        timing.originNs = qint64(m_reader.frameTimeNs());
+        timing.receivedNs = now;
+        timing.decodedNs = LatencyHistogram::nowNs();
+        publishSatelliteStates(std::move(batch), timing.originNs, timing);
+    }
+
+    if (now - m_lastReportNs >= ReportIntervalNs) {
+        const double secs = double(now - m_lastReportNs) / 1e9;
+        emit statusMessage(QStringLiteral("Shared memory: %1 frames/s, %2 ms publish-to-read, %3 slots skipped")
+                               .arg(m_framesSinceReport / secs, 0, 'f', 1)
+                               .arg(m_framesSinceReport > 0 ? m_latencySumMs / m_framesSinceReport : 0.0, 0, 'f', 2)
+                               .arg(m_skippedSlots));
+        m_framesSinceReport = 0;
+        m_skippedSlots = 0;
+        m_latencySumMs = 0.0;
+        m_lastReportNs = now;
+    }
+}
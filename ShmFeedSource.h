@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QString>
+#include <QTimer>
+
+#include "FeedSource.h"
+#include "ShmStateRing.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Reads satellite states from a co-located publisher's shared-memory segment (see ShmStateRing.h). Polls on the
+// owner thread about once per display frame; an unchanged frame counter costs two atomic loads. Follows the publisher
+// across restarts (see the generation field in ShmStateRing.h). Frames reach the view as columns
+// (publishSatelliteStates); objects whose ID does not fit 32 bits are skipped.
+class ShmFeedSource : public FeedSource
+{
+    Q_OBJECT
+public:
+    explicit ShmFeedSource(QObject *parent = nullptr);
+    ~ShmFeedSource() override;
+
+    void setName(const QString &name);
+    void setPollIntervalMs(int ms);
+
+    void start() override;
+    void stop() override;
+
+public slots:
+    void poll();
+
+private:
+    // (Re)opens the segment and resets the frame bookkeeping; false if it is not there yet.
+    bool openSegment(qint64 now);
+
+    QString m_name;
+    QTimer m_timer;
+    ShmStateReader m_reader;
+    quint64 m_lastFrame {0};
+    qint64 m_lastFrameNs {0}; // when m_lastFrame changed
+    qint64 m_lastProbeNs {0}; // last open attempt or restart check
+    qint64 m_framesSinceReport {0};
+    qint64 m_skippedSlots {0};
+    double m_latencySumMs {0.0};
+    qint64 m_lastReportNs {0};
+};
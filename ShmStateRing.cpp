@@ -0,0 +1,191 @@
+#include "ShmStateRing.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+namespace
+{
+constexpr int MaxReadAttempts = 4;
+
+QByteArray shmName(const QString &name)
+{
+    const QByteArray utf8 = name.toUtf8();
+    return utf8.startsWith('/') ? utf8 : QByteArray("/") + utf8;
+}
+
+QString errnoString(const char *what)
+{
+    return QStringLiteral("%1: %2").arg(QString::fromLatin1(what), QString::fromLocal8Bit(std::strerror(errno)));
+}
+}
+
+quint64 ShmState::nowNs()
+{
+    return quint64(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+ShmStateWriter::~ShmStateWriter()
+{
+    close();
+}
+
+bool ShmStateWriter::create(const QString &name, quint32 capacity)
+{
+    close();
+    m_name = name;
+    const QByteArray path = shmName(name);
+    // A fresh object rather than the existing one rewritten: readers still mapping a previous publisher's segment keep
+    // valid (if stale) memory instead of seeing it zeroed or truncated under them.
+    ::shm_unlink(path.constData());
+    const int fd = ::shm_open(path.constData(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) {
+        m_error = errnoString("shm_open");
+        return false;
+    }
+    m_size = sizeof(ShmState::Header) + size_t(capacity) * sizeof(ShmState::Slot);
+    if (::ftruncate(fd, off_t(m_size)) != 0) {
+        m_error = errnoString("ftruncate");
+        ::close(fd);
+        return false;
+    }
+    void *mem = ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mem == MAP_FAILED) {
+        m_error = errnoString("mmap");
+        return false;
+    }
+
+    // Header fields are filled in before the magic, so a reader never sees a half-initialised segment as valid.
+    std::memset(mem, 0, m_size);
+    m_header = static_cast<ShmState::Header *>(mem);
+    m_slots = reinterpret_cast<ShmState::Slot *>(static_cast<char *>(mem) + sizeof(ShmState::Header));
+    m_header->version = ShmState::Version;
+    m_header->capacity = capacity;
+    m_header->recordSize = sizeof(ShmState::Slot);
+    m_header->generation.store(std::max<quint64>(ShmState::nowNs(), 1), std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(m_header->magic, ShmState::Magic, sizeof(ShmState::Magic));
+    return true;
+}
+
+void ShmStateWriter::close()
+{
+    if (!m_header)
+        return;
+    m_header->generation.store(0, std::memory_order_release);
+    ::munmap(m_header, m_size);
+    ::shm_unlink(shmName(m_name).constData());
+    m_header = nullptr;
+    m_slots = nullptr;
+    m_size = 0;
+}
+
+void ShmStateWriter::write(quint32 slot, const ShmState::State &state)
+{
+    if (!m_header || slot >= m_header->capacity)
+        return;
+    ShmState::Slot &s = m_slots[slot];
+    const quint32 seq = s.seq.load(std::memory_order_relaxed);
+    s.seq.store(seq + 1, std::memory_order_relaxed); // odd: write in progress
+    std::atomic_thread_fence(std::memory_order_release);
+    s.state = state;
+    s.seq.store(seq + 2, std::memory_order_release);
+}
+
+void ShmStateWriter::commit(quint32 count, quint64 frameTimeNs)
+{
+    if (!m_header)
+        return;
+    m_header->count.store(std::min(count, m_header->capacity), std::memory_order_relaxed);
+    m_header->frameTimeNs.store(frameTimeNs, std::memory_order_relaxed);
+    m_header->frame.fetch_add(1, std::memory_order_release);
+}
+
+ShmStateReader::~ShmStateReader()
+{
+    close();
+}
+
+bool ShmStateReader::open(const QString &name)
+{
+    close();
+    const int fd = ::shm_open(shmName(name).constData(), O_RDONLY, 0);
+    if (fd < 0) {
+        m_error = errnoString("shm_open");
+        return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(ShmState::Header)) {
+        m_error = QStringLiteral("Shared-memory segment %1 is too small").arg(name);
+        ::close(fd);
+        return false;
+    }
+    m_size = size_t(st.st_size);
+    void *mem = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mem == MAP_FAILED) {
+        m_error = errnoString("mmap");
+        return false;
+    }
+
+    const auto *header = static_cast<const ShmState::Header *>(mem);
+    if (std::memcmp(header->magic, ShmState::Magic, sizeof(ShmState::Magic)) != 0 || header->version != ShmState::Version
+        || header->recordSize != sizeof(ShmState::Slot)
+        || sizeof(ShmState::Header) + size_t(header->capacity) * sizeof(ShmState::Slot) > m_size) {
+        m_error = QStringLiteral("%1 is not an EarthView state segment").arg(name);
+        ::munmap(mem, m_size);
+        return false;
+    }
+    const quint64 generation = header->generation.load(std::memory_order_acquire);
+    if (generation == 0) {
+        m_error = QStringLiteral("%1 was closed by its publisher").arg(name);
+        ::munmap(mem, m_size);
+        return false;
+    }
+    m_header = header;
+    m_generation = generation;
+    m_slots = reinterpret_cast<const ShmState::Slot *>(static_cast<const char *>(mem) + sizeof(ShmState::Header));
+    return true;
+}
+
+void ShmStateReader::close()
+{
+    if (!m_header)
+        return;
+    ::munmap(const_cast<ShmState::Header *>(m_header), m_size);
+    m_header = nullptr;
+    m_slots = nullptr;
+    m_size = 0;
+    m_generation = 0;
+}
+
+quint32 ShmStateReader::count() const
+{
+    return std::min(m_header->count.load(std::memory_order_relaxed), m_header->capacity);
+}
+
+bool ShmStateReader::read(quint32 slot, ShmState::State &out) const
+{
+    if (slot >= m_header->capacity)
+        return false;
+    const ShmState::Slot &s = m_slots[slot];
+    for (int attempt = 0; attempt < MaxReadAttempts; ++attempt) {
+        const quint32 before = s.seq.load(std::memory_order_acquire);
+        if (before & 1u)
+            continue;
+        out = s.state;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (s.seq.load(std::memory_order_relaxed) == before)
+            return true;
+    }
+    return false;
+}
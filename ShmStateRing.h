@@ -0,0 +1,121 @@
+#pragma once
+
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Shared-memory satellite states for publishers on the same host (POSIX shm, `/dev/shm/<name>` on Linux).
+//
+//   header (64 bytes): magic[8], u32 version, u32 capacity, u32 record size, u32 count, u64 frame, u64 frame time ns,
+//                      u64 generation
+//   slots  (capacity x 64 bytes): one fixed-size record per object, each guarded by its own seqlock
+//
+// The publisher rewrites slots [0, count) each frame and then bumps `frame`; a slot's sequence is odd while it is
+// being written. Readers never block the publisher: a slot read that overlaps a write is retried, and a slot that
+// keeps changing is skipped for that frame. Native endianness; both sides must run on the same host.
+//
+// Every create() makes a new segment under the name (the old one is unlinked, so readers still mapping it are not cut
+// off) with a new nonzero `generation`; a clean close() sets it to zero first. Readers reopen when their generation
+// changes, and after a publisher crash notice the replacement by checking the name once their frames go stale.
+namespace ShmState
+{
+inline constexpr char Magic[8] = {'E', 'V', 'S', 'H', 'M', '\0', '\0', '\1'};
+inline constexpr quint32 Version = 2;
+
+struct State
+{
+    quint64 id {0};
+    double lat {0.0};
+    double lon {0.0};
+    double altKm {0.0};
+    // NaN when absent.
+    float latPast {0.0f};
+    float lonPast {0.0f};
+    float latFuture {0.0f};
+    float lonFuture {0.0f};
+};
+
+struct alignas(64) Header
+{
+    char magic[8];
+    quint32 version;
+    quint32 capacity;
+    quint32 recordSize;
+    std::atomic<quint32> count;
+    std::atomic<quint64> frame;
+    std::atomic<quint64> frameTimeNs;
+    std::atomic<quint64> generation; // 0 once the publisher has closed the segment
+};
+
+struct alignas(64) Slot
+{
+    std::atomic<quint32> seq;
+    quint32 reserved;
+    State state;
+};
+
+static_assert(sizeof(Header) == 64, "shm header layout");
+static_assert(sizeof(Slot) == 64, "shm slot layout");
+static_assert(std::atomic<quint64>::is_always_lock_free, "shm atomics must be lock-free");
+
+// Wall-clock timestamp used for frame times (comparable across processes).
+quint64 nowNs();
+}
+
+class ShmStateWriter
+{
+public:
+    ~ShmStateWriter();
+
+    // Creates the named segment, replacing any segment left under that name.
+    bool create(const QString &name, quint32 capacity);
+    // Marks the segment closed for its readers, then unmaps and unlinks it.
+    void close();
+    bool isOpen() const { return m_header != nullptr; }
+    QString errorString() const { return m_error; }
+    quint32 capacity() const { return m_header ? m_header->capacity : 0; }
+
+    void write(quint32 slot, const ShmState::State &state);
+    // Publishes slots [0, count) as the next frame.
+    void commit(quint32 count, quint64 frameTimeNs);
+
+private:
+    ShmState::Header *m_header {nullptr};
+    ShmState::Slot *m_slots {nullptr};
+    size_t m_size {0};
+    QString m_name;
+    QString m_error;
+};
+
+class ShmStateReader
+{
+public:
+    ~ShmStateReader();
+
+    bool open(const QString &name);
+    void close();
+    bool isOpen() const { return m_header != nullptr; }
+    QString errorString() const { return m_error; }
+
+    // Plain loads from the mapping; polling costs no syscalls.
+    quint64 frame() const { return m_header->frame.load(std::memory_order_acquire); }
+    quint64 frameTimeNs() const { return m_header->frameTimeNs.load(std::memory_order_relaxed); }
+    quint32 count() const;
+    // The generation this reader opened. isCurrent() turns false when the publisher closes the segment; a crashed
+    // publisher's replacement is a new segment, found by opening the name again and comparing generations.
+    quint64 generation() const { return m_generation; }
+    bool isCurrent() const { return m_header->generation.load(std::memory_order_acquire) == m_generation; }
+
+    // Consistent copy of one slot; false if it was being rewritten on every attempt.
+    bool read(quint32 slot, ShmState::State &out) const;
+
+private:
+    const ShmState::Header *m_header {nullptr};
+    const ShmState::Slot *m_slots {nullptr};
+    size_t m_size {0};
+    quint64 m_generation {0};
+    QString m_error;
+};
@@ -0,0 +1,225 @@
+#include "SyntheticConstellation.h"
+
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborValue>
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+namespace
+{
+constexpr double EarthRadiusKm = 6371.0;
+constexpr double EarthMu = 398600.4418;            // km^3/s^2
+constexpr double EarthRotationRate = 7.2921159e-5; // rad/s
+constexpr double DegToRad = M_PI / 180.0;
+constexpr double RadToDeg = 180.0 / M_PI;
+
+// Point at great-circle distance `rho` (rad) and `bearing` (rad) from (lat, lon) (rad), returned in degrees.
+GeoPoint destination(double lat, double lon, double rho, double bearing)
+{
+    const double lat2 = std::asin(std::sin(lat) * std::cos(rho) + std::cos(lat) * std::sin(rho) * std::cos(bearing));
+    const double lon2 = lon + std::atan2(std::sin(bearing) * std::sin(rho) * std::cos(lat),
+                                         std::cos(rho) - std::sin(lat) * std::sin(lat2));
+    return GeoPoint{lat2 * RadToDeg, std::remainder(lon2, 2.0 * M_PI) * RadToDeg};
+}
+}
+
+SyntheticConstellation::SyntheticConstellation(const Config &config)
+    : m_config(config)
+{
+    std::mt19937 rng(m_config.seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    auto uniform = [&](double lo, double hi) { return lo + (hi - lo) * unit(rng); };
+
+    const int count = std::max(m_config.satelliteCount, 0);
+    const int edgeBatch = std::max(1, count / 50);
+    int seamLeft = m_config.edgeCases.testFlag(SeamCrossings) ? std::min(edgeBatch, count) : 0;
+    int poleLeft = m_config.edgeCases.testFlag(PolePasses) ? std::min(edgeBatch, count - seamLeft) : 0;
+
+    m_orbits.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        Orbit o;
+        const double altKm = uniform(m_config.minAltitudeKm, m_config.maxAltitudeKm);
+        o.a = EarthRadiusKm + altKm;
+        // Keep perigee above 100 km.
+        const double maxE = std::min(m_config.maxEccentricity, 1.0 - (EarthRadiusKm + 100.0) / o.a);
+        o.e = maxE > 0.0 ? uniform(0.0, maxE) : 0.0;
+        o.inc = uniform(m_config.minInclinationDeg, m_config.maxInclinationDeg) * DegToRad;
+        o.raan = uniform(0.0, 2.0 * M_PI);
+        o.argp = uniform(0.0, 2.0 * M_PI);
+        o.m0 = uniform(0.0, 2.0 * M_PI);
+
+        if (seamLeft > 0) {
+            // Near-equatorial, spread +/-2 deg around the antimeridian at t = 0.
+            --seamLeft;
+            o.e = 0.0;
+            o.inc = uniform(0.0, 5.0) * DegToRad;
+            o.raan = 0.0;
+            o.argp = 0.0;
+            o.m0 = M_PI + uniform(-2.0, 2.0) * DegToRad;
+        } else if (poleLeft > 0) {
+            // Polar, over a pole at t = 0 (alternating north/south).
+            --poleLeft;
+            o.e = 0.0;
+            o.inc = M_PI / 2.0;
+            o.argp = 0.0;
+            o.m0 = (poleLeft % 2 ? M_PI / 2.0 : -M_PI / 2.0) + uniform(-0.5, 0.5) * DegToRad;
+        }
+
+        o.n = std::sqrt(EarthMu / (o.a * o.a * o.a));
+        m_orbits.append(o);
+    }
+}
+
+SyntheticConstellation::Position SyntheticConstellation::position(int index, double t) const
+{
+    const Orbit &o = m_orbits[index];
+    const double M = o.m0 + o.n * t;
+    double E = M;
+    if (o.e > 0.0) {
+        for (int k = 0; k < 6; ++k)
+            E -= (E - o.e * std::sin(E) - M) / (1.0 - o.e * std::cos(E));
+    }
+    const double nu = 2.0 * std::atan2(std::sqrt(1.0 + o.e) * std::sin(E / 2.0), std::sqrt(1.0 - o.e) * std::cos(E / 2.0));
+    const double r = o.a * (1.0 - o.e * std::cos(E));
+    const double u = o.argp + nu;
+
+    const double cosU = std::cos(u);
+    const double sinU = std::sin(u);
+    const double cosO = std::cos(o.raan);
+    const double sinO = std::sin(o.raan);
+    const double cosI = std::cos(o.inc);
+    const double x = r * (cosO * cosU - sinO * sinU * cosI);
+    const double y = r * (sinO * cosU + cosO * sinU * cosI);
+    const double z = r * sinU * std::sin(o.inc);
+
+    const double lon = std::remainder(std::atan2(y, x) - EarthRotationRate * t, 2.0 * M_PI);
+    const double lat = std::asin(std::clamp(z / r, -1.0, 1.0));
+    return Position{lat * RadToDeg, lon * RadToDeg, r - EarthRadiusKm};
+}
+
+QVariantList SyntheticConstellation::satellites(double t) const
+{
+    const double dt = m_config.trackSeconds;
+    QVariantList sats;
+    sats.reserve(m_orbits.size());
+    for (int i = 0; i < m_orbits.size(); ++i) {
+        const Position now = position(i, t);
+        QVariantMap sat;
+        sat.insert(QStringLiteral("ID"), 100000 + i);
+        sat.insert(QStringLiteral("Lat"), now.lat);
+        sat.insert(QStringLiteral("Lon"), now.lon);
+        sat.insert(QStringLiteral("Alt"), now.altKm);
+        if (dt > 0.0) {
+            const Position past = position(i, t - dt);
+            const Position future = position(i, t + dt);
+            sat.insert(QStringLiteral("LatPast"), past.lat);
+            sat.insert(QStringLiteral("LonPast"), past.lon);
+            sat.insert(QStringLiteral("LatFuture"), future.lat);
+            sat.insert(QStringLiteral("LonFuture"), future.lon);
+        }
+        sats.append(sat);
+    }
+    return sats;
+}
+
+QByteArray SyntheticConstellation::statesPayload(double t) const
+{
+    const double dt = m_config.trackSeconds;
+    QCborArray states;
+    for (int i = 0; i < m_orbits.size(); ++i) {
+        const Position now = position(i, t);
+        QCborMap m;
+        m.insert(QStringLiteral("ID"), 100000 + i);
+        m.insert(QStringLiteral("Lat"), now.lat);
+        m.insert(QStringLiteral("Lon"), now.lon);
+        m.insert(QStringLiteral("Alt"), now.altKm);
+        if (dt > 0.0) {
+            const Position past = position(i, t - dt);
+            const Position future = position(i, t + dt);
+            m.insert(QStringLiteral("LatPast"), past.lat);
+            m.insert(QStringLiteral("LonPast"), past.lon);
+            m.insert(QStringLiteral("LatFuture"), future.lat);
+            m.insert(QStringLiteral("LonFuture"), future.lon);
+        }
+        states.append(m);
+    }
+    QCborMap root;
+    root.insert(QStringLiteral("States"), states);
+    return QCborValue(root).toCbor();
+}
+
+CompactStates::Batch SyntheticConstellation::batch(double t) const
+{
+    const double dt = m_config.trackSeconds;
+    const int count = int(m_orbits.size());
+    CompactStates::Batch b;
+    b.ids.resize(count);
+    b.lat.resize(count);
+    b.lon.resize(count);
+    b.alt.resize(count);
+    if (dt > 0.0) {
+        b.latPast.resize(count);
+        b.lonPast.resize(count);
+        b.latFuture.resize(count);
+        b.lonFuture.resize(count);
+    }
+    for (int i = 0; i < count; ++i) {
+        const Position now = position(i, t);
+        b.ids[i] = quint32(100000 + i);
+        b.lat[i] = now.lat;
+        b.lon[i] = now.lon;
+        b.alt[i] = now.altKm;
+        if (dt > 0.0) {
+            const Position past = position(i, t - dt);
+            const Position future = position(i, t + dt);
+            b.latPast[i] = past.lat;
+            b.lonPast[i] = past.lon;
+            b.latFuture[i] = future.lat;
+            b.lonFuture[i] = future.lon;
+        }
+    }
+    return b;
+}
+
+GroundStationList SyntheticConstellation::groundStations() const
+{
+    std::mt19937 rng(m_config.seed ^ 0x9e3779b9u);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    auto uniform = [&](double lo, double hi) { return lo + (hi - lo) * unit(rng); };
+
+    const double rho = m_config.maskRadiusKm / EarthRadiusKm;
+    const int maskPoints = std::max(m_config.maskPoints, 0);
+
+    auto makeStation = [&](int index, double latDeg, double lonDeg) {
+        GroundStation gs;
+        gs.id = QStringLiteral("syn_gs_%1").arg(index);
+        gs.lat = latDeg;
+        gs.lon = lonDeg;
+        gs.radiusKm = m_config.maskRadiusKm;
+        gs.mask.reserve(maskPoints);
+        for (int k = 0; k < maskPoints; ++k)
+            gs.mask.append(destination(latDeg * DegToRad, lonDeg * DegToRad, rho, 2.0 * M_PI * k / maskPoints));
+        return gs;
+    };
+
+    GroundStationList stations;
+    const int count = std::max(m_config.groundStationCount, 0);
+    stations.reserve(count);
+    int index = 0;
+    if (m_config.edgeCases.testFlag(SeamCrossings) && index < count) {
+        stations.append(makeStation(index, 0.0, 179.0));
+        ++index;
+    }
+    if (m_config.edgeCases.testFlag(PolePasses) && index < count) {
+        stations.append(makeStation(index, 80.0, 0.0));
+        ++index;
+    }
+    for (; index < count; ++index)
+        stations.append(makeStation(index, uniform(-70.0, 70.0), uniform(-180.0, 180.0)));
+    return stations;
+}
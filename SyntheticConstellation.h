@@ -0,0 +1,78 @@
+#pragma once
+
+#include <QByteArray>
+#include <QVariantList>
+#include <QVector>
+
+#include "CompactStates.h"
+#include "GeoTypes.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Deterministic synthetic constellation for load and edge-case testing. Orbits are two-body Keplerian (circular by
+// default) over a spherical Earth rotating at the sidereal rate; good enough to exercise the view, not for analysis.
+class SyntheticConstellation
+{
+public:
+    enum EdgeCase {
+        NoEdgeCases = 0x0,
+        SeamCrossings = 0x1, // objects and a station mask straddling +/-180 deg
+        PolePasses = 0x2,    // polar orbits passing over the poles at t = 0, and a mask enclosing a pole
+    };
+    Q_DECLARE_FLAGS(EdgeCases, EdgeCase)
+
+    struct Config
+    {
+        int satelliteCount {1000};
+        double minInclinationDeg {0.0};
+        double maxInclinationDeg {98.0};
+        double minAltitudeKm {400.0};
+        double maxAltitudeKm {1200.0};
+        double maxEccentricity {0.0};
+        double trackSeconds {300.0}; // offset of the LatPast/LatFuture points
+        int groundStationCount {20};
+        int maskPoints {72};
+        double maskRadiusKm {2500.0};
+        EdgeCases edgeCases {NoEdgeCases};
+        quint32 seed {1};
+    };
+
+    explicit SyntheticConstellation(const Config &config = Config());
+
+    const Config &config() const { return m_config; }
+
+    // Satellite list at `t` seconds after the epoch, in the shape FeedCodec::decodeStates produces.
+    QVariantList satellites(double t) const;
+    // The same states as an `m.orbit.*` CBOR payload, for exercising the decode path.
+    QByteArray statesPayload(double t) const;
+    // The same states as columns for CompactStates::Encoder.
+    CompactStates::Batch batch(double t) const;
+    // Ground stations with circular masks of config().maskPoints points.
+    GroundStationList groundStations() const;
+
+    struct Position
+    {
+        double lat;
+        double lon;
+        double altKm;
+    };
+    Position position(int index, double t) const;
+
+private:
+    struct Orbit
+    {
+        double a;    // semi-major axis, km
+        double e;
+        double inc;  // rad
+        double raan; // rad
+        double argp; // rad
+        double m0;   // mean anomaly at epoch, rad
+        double n;    // mean motion, rad/s
+    };
+
+    Config m_config;
+    QVector<Orbit> m_orbits;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(SyntheticConstellation::EdgeCases)
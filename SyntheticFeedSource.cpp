@@ -0,0 +1,153 @@
+#include "SyntheticFeedSource.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "FeedCodec.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+namespace
+{
+// Ticks are skipped (and counted) rather than queued when the owner thread falls behind.
+constexpr int MaxPendingBatches = 2;
+}
+
+SyntheticFeedSource::SyntheticFeedSource(QObject *parent)
+    : FeedSource(parent)
+{
+}
+
+SyntheticFeedSource::~SyntheticFeedSource()
+{
+    stop();
+}
+
+void SyntheticFeedSource::setConfig(const SyntheticConstellation::Config &config)
+{
+    m_config = config;
+}
+
+void SyntheticFeedSource::setUpdateRateHz(double hz)
+{
+    if (hz > 0.0)
+        m_updateRateHz = hz;
+}
+
+void SyntheticFeedSource::setPayloadEncoding(PayloadEncoding encoding)
+{
+    m_encoding = encoding;
+}
+
+void SyntheticFeedSource::setCompression(PayloadCompression::Codec codec)
+{
+    m_compression = codec;
+}
+
+void SyntheticFeedSource::setTimeScale(double scale)
+{
+    m_timeScale = scale;
+}
+
+void SyntheticFeedSource::start()
+{
+    if (m_running)
+        return;
+    m_running = true;
+    m_thread = std::thread([this]() { run(); });
+    emit statusMessage(QStringLiteral("Synthetic feed: %1 satellites, %2 stations at %3 Hz")
+                           .arg(m_config.satelliteCount)
+                           .arg(m_config.groundStationCount)
+                           .arg(m_updateRateHz));
+}
+
+void SyntheticFeedSource::stop()
+{
+    m_running = false;
+    if (m_thread.joinable())
+        m_thread.join();
+    clearGroundStations();
+}
+
+void SyntheticFeedSource::run()
+{
+    using Clock = std::chrono::steady_clock;
+
+    const SyntheticConstellation constellation(m_config);
+    replaceGroundStations(constellation.groundStations());
+
+    const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_updateRateHz));
+    const auto start = Clock::now();
+    auto nextTick = start;
+    auto lastReport = start;
+    qint64 published = 0;
+    qint64 skipped = 0;
+    double buildMs = 0.0;
+    CompactStates::Encoder encoder;
+    FeedCodec::StatesDecoder decoder;
+    qint64 payloadBytes = 0;
+    // LZ4 levels below 3 use the fast compressor; zstd's default is 3.
+    const int level = m_compression == PayloadCompression::Codec::Lz4 ? 0 : 3;
+    auto compress = [&](const QByteArray &payload) {
+        return m_compression == PayloadCompression::Codec::None ? payload
+                                                                : PayloadCompression::compress(payload, m_compression, level);
+    };
+
+    while (m_running) {
+        const auto now = Clock::now();
+        if (pendingBatches() >= MaxPendingBatches) {
+            ++skipped;
+        } else {
+            const double t = std::chrono::duration<double>(now - start).count() * m_timeScale;
+            const auto buildStart = Clock::now();
+            FeedCodec::States states;
+            bool encoded = true;
+            switch (m_encoding) {
+            case PayloadEncoding::None:
+                states.list = constellation.satellites(t);
+                break;
+            case PayloadEncoding::Cbor: {
+                const QByteArray payload = compress(constellation.statesPayload(t));
+                payloadBytes += payload.size();
+                encoded = !payload.isEmpty() && decoder.decode(payload, states);
+                break;
+            }
+            case PayloadEncoding::Compact: {
+                const QByteArray payload = compress(encoder.encode(constellation.batch(t)));
+                payloadBytes += payload.size();
+                encoded = !payload.isEmpty() && decoder.decode(payload, states);
+                break;
+            }
+            }
+            buildMs += std::chrono::duration<double, std::milli>(Clock::now() - buildStart).count();
+            if (encoded)
+                publishStates(std::move(states));
+            else
+                countDroppedBatch(); // the compressor failed; an empty batch would clear the map
+            ++published;
+        }
+
+        if (now - lastReport >= std::chrono::seconds(5)) {
+            const double secs = std::chrono::duration<double>(now - lastReport).count();
+            QString msg = QStringLiteral("Synthetic feed: %1 batches/s, %2 ms build per batch, %3 ticks skipped")
+                              .arg(published / secs, 0, 'f', 1)
+                              .arg(published > 0 ? buildMs / published : 0.0, 0, 'f', 2)
+                              .arg(skipped);
+            if (m_encoding != PayloadEncoding::None && published > 0)
+                msg += QStringLiteral(", %1 KiB per payload").arg(payloadBytes / 1024.0 / published, 0, 'f', 1);
+            postStatus(msg);
+            payloadBytes = 0;
+            published = 0;
+            skipped = 0;
+            buildMs = 0.0;
+            lastReport = now;
+        }
+
+        nextTick += period;
+        if (nextTick < Clock::now())
+            nextTick = Clock::now(); // don't try to catch up after a stall
+        for (auto t = Clock::now(); m_running && t < nextTick; t = Clock::now())
+            std::this_thread::sleep_for(std::min<Clock::duration>(nextTick - t, std::chrono::milliseconds(50)));
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+#include "FeedSource.h"
+#include "PayloadCompression.h"
+#include "SyntheticConstellation.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Publishes a SyntheticConstellation at a fixed update rate from a worker thread; no network involved.
+class SyntheticFeedSource : public FeedSource
+{
+    Q_OBJECT
+public:
+    explicit SyntheticFeedSource(QObject *parent = nullptr);
+    ~SyntheticFeedSource() override;
+
+    void setConfig(const SyntheticConstellation::Config &config);
+    void setUpdateRateHz(double hz);
+    enum class PayloadEncoding {
+        None,    // hand over the decoded list directly
+        Cbor,    // encode each batch to CBOR and decode it again, so the decoder is part of the measured path
+        Compact, // the same through CompactStates
+    };
+    void setPayloadEncoding(PayloadEncoding encoding);
+    // Compresses encoded payloads before decoding them (no effect with PayloadEncoding::None, nor with a codec this
+    // build lacks; see PayloadCompression::isAvailable).
+    void setCompression(PayloadCompression::Codec codec);
+    // Constellation seconds per wall-clock second.
+    void setTimeScale(double scale);
+
+    void start() override;
+    void stop() override;
+
+private:
+    void run();
+
+    SyntheticConstellation::Config m_config;
+    double m_updateRateHz {1.0};
+    double m_timeScale {1.0};
+    PayloadEncoding m_encoding {PayloadEncoding::None};
+    PayloadCompression::Codec m_compression {PayloadCompression::Codec::None};
+    std::thread m_thread;
+    std::atomic<bool> m_running {false};
+};
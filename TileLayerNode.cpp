@@ -0,0 +1,171 @@
+#include "TileLayerNode.h"
+
+#include <QQuickWindow>
+#include <QSGSimpleTextureNode>
+#include <QSGTexture>
+#include <algorithm>
+#include <cmath>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+using TilePyramid::TileKey;
+
+TileLayerNode::~TileLayerNode()
+{
+    clear();
+}
+
+void TileLayerNode::clear()
+{
+    for (const CachedTile &tile : std::as_const(m_cache))
+        delete tile.texture;
+    m_cache.clear();
+    m_missing.clear();
+    m_waiting.clear();
+    m_requested.clear();
+}
+
+bool TileLayerNode::update(QQuickWindow *window, TileLoader *loader, quint64 generation, const QRectF &world, qreal baseX,
+                           const QRectF &visible, qreal devicePixelRatio, int cacheSize, Stats &stats)
+{
+    ++m_frame;
+    if (generation != m_generation) {
+        clear();
+        m_generation = generation;
+    }
+
+    int used = 0;
+    const int levels = loader ? loader->levelCount() : 0;
+    if (window && levels > 0 && world.width() > 0 && world.height() > 0) {
+        // Upload what the loader has finished, oldest first.
+        m_waiting.append(loader->takeDecoded());
+        const qsizetype uploads = std::min<qsizetype>(m_waiting.size(), MaxUploadsPerFrame);
+        for (qsizetype i = 0; i < uploads; ++i) {
+            const TileLoader::Decoded &decoded = m_waiting[i];
+            const quint64 packed = decoded.key.packed();
+            if (decoded.image.isNull()) {
+                m_missing.insert(packed);
+            } else if (!m_cache.contains(packed)) {
+                QSGTexture *texture = window->createTextureFromImage(decoded.image);
+                texture->setFiltering(QSGTexture::Linear);
+                m_cache.insert(packed, {texture, m_frame});
+            }
+        }
+        m_waiting.remove(0, uploads);
+
+        // The coarsest level whose tiles are at least as detailed as the screen.
+        const double ratio = world.width() * devicePixelRatio / loader->tileSize();
+        const int level = std::clamp(int(std::ceil(std::log2(std::max(ratio, 1.0)))) - 1, 0, levels - 1);
+        const int cols = TilePyramid::columns(level);
+        const int rows = TilePyramid::rows(level);
+        const qreal tileW = world.width() / cols;
+        const qreal tileH = world.height() / rows;
+        const int row0 = std::clamp(int(std::floor((visible.top() - world.y()) / tileH)), 0, rows - 1);
+        const int row1 = std::clamp(int(std::ceil((visible.bottom() - world.y()) / tileH)) - 1, 0, rows - 1);
+        stats.level = level;
+
+        struct Wanted
+        {
+            TileKey key;
+            qreal distance;
+        };
+        QVector<Wanted> wanted;
+        const QPointF centre = visible.center();
+        for (int copy = 0; copy < 2; ++copy) {
+            const qreal copyX = baseX + copy * world.width();
+            const qreal left = std::max(visible.left(), copyX);
+            const qreal right = std::min(visible.right(), copyX + world.width());
+            if (right <= left)
+                continue;
+            const int col0 = std::clamp(int(std::floor((left - copyX) / tileW)), 0, cols - 1);
+            const int col1 = std::clamp(int(std::ceil((right - copyX) / tileW)) - 1, 0, cols - 1);
+            for (int row = row0; row <= row1; ++row) {
+                for (int col = col0; col <= col1; ++col) {
+                    const TileKey key {level, col, row};
+                    const QRectF rect(copyX + col * tileW, world.y() + row * tileH, tileW, tileH);
+                    ++stats.visible;
+                    auto it = m_cache.find(key.packed());
+                    if (it != m_cache.end()) {
+                        it->lastUsed = m_frame;
+                        drawTile(used, it->texture, rect, QRectF());
+                        continue;
+                    }
+                    ++stats.pending;
+                    if (!m_missing.contains(key.packed())) {
+                        const QPointF d = rect.center() - centre;
+                        wanted.append({key, d.x() * d.x() + d.y() * d.y()});
+                    }
+                    // Stand in with the part of the nearest cached ancestor that covers this tile.
+                    for (int up = 1; up <= level; ++up) {
+                        auto parent = m_cache.find(key.parent(up).packed());
+                        if (parent == m_cache.end())
+                            continue;
+                        parent->lastUsed = m_frame;
+                        const QSize size = parent->texture->textureSize();
+                        const qreal subW = qreal(size.width()) / (1 << up);
+                        const qreal subH = qreal(size.height()) / (1 << up);
+                        const int mask = (1 << up) - 1;
+                        drawTile(used, parent->texture, rect, QRectF((col & mask) * subW, (row & mask) * subH, subW, subH));
+                        break;
+                    }
+                }
+            }
+        }
+
+        // Nearest the centre first; a changed list replaces what the loader still has queued.
+        std::sort(wanted.begin(), wanted.end(), [](const Wanted &a, const Wanted &b) { return a.distance < b.distance; });
+        QVector<TileKey> keys;
+        keys.reserve(wanted.size());
+        for (const Wanted &w : std::as_const(wanted)) {
+            if (!keys.contains(w.key)
+                && std::none_of(m_waiting.cbegin(), m_waiting.cend(), [&w](const TileLoader::Decoded &d) { return d.key == w.key; })) {
+                keys.append(w.key);
+            }
+        }
+        if (keys != m_requested) {
+            m_requested = keys;
+            loader->request(std::move(keys));
+        }
+        evict(cacheSize);
+    }
+
+    // Drop the children this frame did not use.
+    while (m_nodes.size() > used) {
+        QSGSimpleTextureNode *node = m_nodes.takeLast();
+        removeChildNode(node);
+        delete node;
+    }
+    stats.textures = int(m_cache.size());
+    return !m_waiting.isEmpty();
+}
+
+void TileLayerNode::evict(int cacheSize)
+{
+    while (m_cache.size() > cacheSize) {
+        auto oldest = m_cache.end();
+        for (auto it = m_cache.begin(); it != m_cache.end(); ++it) {
+            if (it->lastUsed != m_frame && (oldest == m_cache.end() || it->lastUsed < oldest->lastUsed))
+                oldest = it;
+        }
+        if (oldest == m_cache.end())
+            return; // everything cached is on screen
+        delete oldest->texture;
+        m_cache.erase(oldest);
+    }
+}
+
+void TileLayerNode::drawTile(int &used, QSGTexture *texture, const QRectF &rect, const QRectF &sourceRect)
+{
+    if (used == m_nodes.size()) {
+        auto *node = new QSGSimpleTextureNode();
+        node->setOwnsTexture(false);
+        node->setFiltering(QSGTexture::Linear);
+        appendChildNode(node);
+        m_nodes.append(node);
+    }
+    QSGSimpleTextureNode *node = m_nodes[used++];
+    node->setTexture(texture);
+    node->setRect(rect);
+    node->setSourceRect(sourceRect.isNull() ? QRectF(QPointF(), texture->textureSize()) : sourceRect);
+}
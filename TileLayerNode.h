@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QHash>
+#include <QRectF>
+#include <QSGNode>
+#include <QSet>
+#include <QVector>
+
+#include "TileLoader.h"
+#include "TilePyramid.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+class QQuickWindow;
+class QSGSimpleTextureNode;
+class QSGTexture;
+
+// Background tiles from a TileLoader, drawn over the base texture. Each frame picks the pyramid level whose texels
+// are closest to (but not below) device pixels, draws the visible tiles it has textures for and asks the loader for
+// the rest. A tile still loading is covered by the nearest coarser tile in the cache (a sub-rectangle of it), and by
+// the base texture underneath if there is none. Textures are kept in an LRU cache bounded by tile count; the ones
+// drawn this frame are never evicted. Uploads per frame are capped so that a burst of decoded tiles does not stall a
+// frame. Render thread only.
+class TileLayerNode : public QSGNode
+{
+public:
+    static constexpr int MaxUploadsPerFrame = 4;
+
+    struct Stats
+    {
+        int level {-1};   // level drawn, -1 with no pyramid
+        int visible {0};  // tiles at that level in view
+        int pending {0};  // of which not yet decoded and uploaded
+        int textures {0}; // tile textures in the cache
+    };
+
+    ~TileLayerNode() override;
+
+    // `world` is the whole map in item pixels and `baseX` the left edge of its first copy (longitude -180), as for the
+    // base texture; `visible` is the view. A new `generation` (another pyramid) drops the cache. Returns true if
+    // decoded tiles are waiting for a later frame.
+    bool update(QQuickWindow *window, TileLoader *loader, quint64 generation, const QRectF &world, qreal baseX,
+                const QRectF &visible, qreal devicePixelRatio, int cacheSize, Stats &stats);
+
+private:
+    struct CachedTile
+    {
+        QSGTexture *texture {nullptr};
+        quint64 lastUsed {0}; // frame
+    };
+
+    void clear();
+    void evict(int cacheSize);
+    void drawTile(int &used, QSGTexture *texture, const QRectF &rect, const QRectF &sourceRect);
+
+    QHash<quint64, CachedTile> m_cache;      // by TileKey::packed
+    QSet<quint64> m_missing;                 // tiles the pyramid does not have (or that failed to decode)
+    QVector<TileLoader::Decoded> m_waiting;  // decoded, not yet uploaded
+    QVector<TilePyramid::TileKey> m_requested;
+    QVector<QSGSimpleTextureNode *> m_nodes; // children, reused in order
+    quint64 m_generation {0};
+    quint64 m_frame {0};
+};
@@ -0,0 +1,114 @@
+#include "TileLoader.h"
+
+#include <QMutexLocker>
+#include <algorithm>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+TileLoader::TileLoader(ReadySink ready)
+    : m_ready(std::move(ready))
+{
+}
+
+TileLoader::~TileLoader()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stop = true;
+    }
+    m_wake.wakeAll();
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+bool TileLoader::open(const QString &fileName)
+{
+    if (m_thread.joinable() || !m_reader.open(fileName))
+        return false;
+#if QT_CONFIG(thread)
+    m_thread = std::thread([this]() { run(); });
+#endif
+    return true;
+}
+
+void TileLoader::request(QVector<TilePyramid::TileKey> keys)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        // Tiles being decoded or not yet collected are already on their way.
+        keys.removeIf([this](const TilePyramid::TileKey &key) {
+            if (m_busy && key == m_current)
+                return true;
+            return std::any_of(m_decoded.cbegin(), m_decoded.cend(), [&key](const Decoded &d) { return d.key == key; });
+        });
+        m_queue = std::move(keys);
+    }
+    m_wake.wakeAll();
+#if !QT_CONFIG(thread)
+    // No worker: takeDecoded() decodes, so ask for the frame that calls it.
+    if (!m_queue.isEmpty() && m_ready)
+        m_ready();
+#endif
+}
+
+QVector<TileLoader::Decoded> TileLoader::takeDecoded()
+{
+#if !QT_CONFIG(thread)
+    // Without threads (single-threaded WASM) one queued tile is decoded per call, on the caller's thread, so a frame
+    // never stalls on more than one tile; each call with tiles left schedules another frame.
+    TilePyramid::TileKey key;
+    bool haveKey = false;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (!m_queue.isEmpty()) {
+            key = m_queue.takeFirst();
+            haveKey = true;
+        }
+    }
+    if (haveKey) {
+        QImage image = decodeTile(key);
+        QMutexLocker locker(&m_mutex);
+        m_decoded.append({key, std::move(image)});
+        if (!m_queue.isEmpty() && m_ready)
+            m_ready();
+    }
+#endif
+    QMutexLocker locker(&m_mutex);
+    return std::exchange(m_decoded, {});
+}
+
+QImage TileLoader::decodeTile(const TilePyramid::TileKey &key) const
+{
+    // Decoded straight from the mapping; the premultiplied format uploads without another conversion.
+    const QByteArrayView data = m_reader.tile(key);
+    if (data.isEmpty())
+        return {};
+    return QImage::fromData(data).convertToFormat(QImage::Format_RGBA8888_Premultiplied);
+}
+
+void TileLoader::run()
+{
+    for (;;) {
+        TilePyramid::TileKey key;
+        {
+            QMutexLocker locker(&m_mutex);
+            while (!m_stop && m_queue.isEmpty())
+                m_wake.wait(&m_mutex);
+            if (m_stop)
+                return;
+            key = m_queue.takeFirst();
+            m_current = key;
+            m_busy = true;
+        }
+
+        QImage image = decodeTile(key);
+        {
+            QMutexLocker locker(&m_mutex);
+            m_decoded.append({key, std::move(image)});
+            m_busy = false;
+        }
+        if (m_ready)
+            m_ready();
+    }
+}
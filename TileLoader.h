@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QImage>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <QWaitCondition>
+#include <functional>
+#include <thread>
+
+#include "TilePyramid.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Decodes pyramid tiles on a worker thread. The render thread asks for the tiles a frame is missing and collects the
+// decoded images on a later frame; a new request replaces the tiles still queued from the last one, so a pan or zoom
+// does not decode tiles that are no longer wanted. All public functions are thread-safe. Builds without thread support
+// (Qt for WebAssembly's default) have no worker: takeDecoded() decodes one queued tile per call instead.
+class TileLoader
+{
+public:
+    struct Decoded
+    {
+        TilePyramid::TileKey key;
+        QImage image; // null if the tile is missing or failed to decode
+    };
+    // Called on the worker thread after each decoded tile.
+    using ReadySink = std::function<void()>;
+
+    explicit TileLoader(ReadySink ready);
+    ~TileLoader();
+
+    // Maps the pyramid and starts the worker, if the build has threads.
+    bool open(const QString &fileName);
+    QString errorString() const { return m_reader.errorString(); }
+    int tileSize() const { return m_reader.tileSize(); }
+    int levelCount() const { return m_reader.levelCount(); }
+
+    // Tiles to decode, most wanted first; replaces the queue. Tiles already decoding or decoded are skipped.
+    void request(QVector<TilePyramid::TileKey> keys);
+    // Tiles decoded since the last call.
+    QVector<Decoded> takeDecoded();
+
+private:
+    void run();
+    QImage decodeTile(const TilePyramid::TileKey &key) const;
+
+    ReadySink m_ready;
+    TilePyramidReader m_reader; // set up before the worker starts, then read-only
+
+    QMutex m_mutex;
+    QWaitCondition m_wake;
+    QVector<TilePyramid::TileKey> m_queue; // guarded by m_mutex
+    QVector<Decoded> m_decoded;            // guarded by m_mutex
+    TilePyramid::TileKey m_current;        // guarded by m_mutex; the tile being decoded while m_busy
+    bool m_busy {false};                   // guarded by m_mutex
+    bool m_stop {false};                   // guarded by m_mutex
+
+    std::thread m_thread;
+};
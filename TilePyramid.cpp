@@ -0,0 +1,170 @@
+#include "TilePyramid.h"
+
+#include <QtEndian>
+#include <cstring>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+using namespace TilePyramid;
+
+TilePyramidWriter::~TilePyramidWriter()
+{
+    if (m_file.isOpen())
+        close();
+}
+
+bool TilePyramidWriter::open(const QString &fileName, int tileSize, int levels)
+{
+    if (tileSize <= 0 || levels <= 0 || levels > MaxLevels) {
+        m_error = QStringLiteral("Invalid tile size or level count");
+        return false;
+    }
+    m_file.setFileName(fileName);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        m_error = m_file.errorString();
+        return false;
+    }
+    uchar header[HeaderSize] = {};
+    std::memcpy(header, Magic, sizeof(Magic));
+    qToLittleEndian<quint32>(Version, header + 8);
+    if (m_file.write(reinterpret_cast<const char *>(header), sizeof(header)) != qint64(sizeof(header))) {
+        m_error = m_file.errorString();
+        m_file.close();
+        return false;
+    }
+    m_tileSize = tileSize;
+    m_levels = levels;
+    m_offset = HeaderSize;
+    m_offsets.fill(0, tileCount(levels));
+    m_sizes.fill(0, tileCount(levels));
+    return true;
+}
+
+bool TilePyramidWriter::addTile(const TileKey &key, QByteArrayView encoded)
+{
+    if (!m_file.isOpen() || key.level < 0 || key.level >= m_levels || key.column < 0 || key.column >= columns(key.level)
+        || key.row < 0 || key.row >= rows(key.level) || encoded.size() > 0x7fffffff) {
+        m_error = QStringLiteral("Tile out of range");
+        return false;
+    }
+    if (m_file.write(encoded.data(), encoded.size()) != encoded.size()) {
+        m_error = m_file.errorString();
+        return false;
+    }
+    m_offsets[key.index()] = quint64(m_offset);
+    m_sizes[key.index()] = quint32(encoded.size());
+    m_offset += encoded.size();
+    return true;
+}
+
+bool TilePyramidWriter::close()
+{
+    if (!m_file.isOpen())
+        return false;
+
+    // Pad so the index can be read in place from the mapping. The header's index offset is only written once the index
+    // is complete, so a failed write leaves the reader's "unfinished" placeholder of 0.
+    static const char zeros[8] = {};
+    const qint64 pad = (8 - (m_offset % 8)) % 8;
+    bool ok = m_file.write(zeros, pad) == pad;
+    const quint64 indexOffset = quint64(m_offset + pad);
+    for (qsizetype i = 0; ok && i < m_offsets.size(); ++i) {
+        uchar entry[IndexEntrySize] = {};
+        qToLittleEndian<quint64>(m_offsets[i], entry);
+        qToLittleEndian<quint32>(m_sizes[i], entry + 8);
+        ok = m_file.write(reinterpret_cast<const char *>(entry), sizeof(entry)) == qint64(sizeof(entry));
+    }
+
+    if (ok) {
+        uchar header[HeaderSize - 12];
+        qToLittleEndian<quint32>(quint32(m_tileSize), header);
+        qToLittleEndian<quint32>(quint32(m_levels), header + 4);
+        qToLittleEndian<quint32>(0, header + 8);
+        qToLittleEndian<quint64>(indexOffset, header + 12);
+        ok = m_file.seek(12)
+            && m_file.write(reinterpret_cast<const char *>(header), sizeof(header)) == qint64(sizeof(header));
+    }
+    if (!ok)
+        m_error = m_file.errorString();
+    m_file.close();
+    m_offsets.clear();
+    m_sizes.clear();
+    return ok;
+}
+
+TilePyramidReader::~TilePyramidReader()
+{
+    close();
+}
+
+bool TilePyramidReader::open(const QString &fileName)
+{
+    close();
+    m_file.setFileName(fileName);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_error = m_file.errorString();
+        return false;
+    }
+    m_size = m_file.size();
+    if (m_size < HeaderSize) {
+        m_error = QStringLiteral("Not a tile pyramid: %1").arg(fileName);
+        close();
+        return false;
+    }
+    m_data = m_file.map(0, m_size);
+    if (!m_data) {
+        m_error = m_file.errorString();
+        close();
+        return false;
+    }
+
+    const int tileSize = int(qFromLittleEndian<quint32>(m_data + 12));
+    const int levels = int(qFromLittleEndian<quint32>(m_data + 16));
+    const quint64 indexOffset = qFromLittleEndian<quint64>(m_data + 24);
+    if (std::memcmp(m_data, Magic, sizeof(Magic)) != 0 || qFromLittleEndian<quint32>(m_data + 8) != Version) {
+        m_error = QStringLiteral("Not a tile pyramid (or unsupported version): %1").arg(fileName);
+        close();
+        return false;
+    }
+    // Bounds compared by subtraction so a corrupt offset can't wrap the sum.
+    if (tileSize <= 0 || levels <= 0 || levels > MaxLevels || indexOffset < quint64(HeaderSize)
+        || indexOffset > quint64(m_size)
+        || quint64(tileCount(levels)) * IndexEntrySize > quint64(m_size) - indexOffset) {
+        m_error = QStringLiteral("Truncated or unfinished tile pyramid: %1").arg(fileName);
+        close();
+        return false;
+    }
+    m_tileSize = tileSize;
+    m_levels = levels;
+    m_index = m_data + indexOffset;
+    return true;
+}
+
+void TilePyramidReader::close()
+{
+    if (m_data) {
+        m_file.unmap(const_cast<uchar *>(m_data));
+        m_data = nullptr;
+    }
+    if (m_file.isOpen())
+        m_file.close();
+    m_index = nullptr;
+    m_size = 0;
+    m_tileSize = 0;
+    m_levels = 0;
+}
+
+QByteArrayView TilePyramidReader::tile(const TileKey &key) const
+{
+    if (!m_index || key.level < 0 || key.level >= m_levels || key.column < 0 || key.column >= columns(key.level) || key.row < 0
+        || key.row >= rows(key.level)) {
+        return {};
+    }
+    const uchar *entry = m_index + key.index() * IndexEntrySize;
+    const quint64 offset = qFromLittleEndian<quint64>(entry);
+    const quint32 size = qFromLittleEndian<quint32>(entry + 8);
+    if (!size || offset > quint64(m_size) || size > quint64(m_size) - offset)
+        return {};
+    return QByteArrayView(reinterpret_cast<const char *>(m_data + offset), size);
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <QByteArrayView>
+#include <QFile>
+#include <QHashFunctions>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Equirectangular background as a tile pyramid in one file. Level L covers the world with 2^(L+1) x 2^L square
+// tiles (column 0 starts at -180 degrees, row 0 at the north pole), so each level doubles the resolution of the one
+// before. Tiles are stored encoded (PNG, JPEG or anything QImage reads). All integers little endian.
+//
+//   header (32 bytes): magic[8], u32 version, u32 tile size in pixels, u32 level count, u32 reserved,
+//                      u64 index offset
+//   tiles:             encoded images, in any order
+//   index:             per tile in level, row, column order: {u64 file offset, u32 size (0: missing), u32 reserved}
+namespace TilePyramid
+{
+inline constexpr char Magic[8] = {'E', 'V', 'T', 'I', 'L', 'E', 'S', '\1'};
+inline constexpr quint32 Version = 1;
+inline constexpr int HeaderSize = 32;
+inline constexpr int IndexEntrySize = 16;
+inline constexpr int MaxLevels = 16;
+
+inline int columns(int level) { return 2 << level; }
+inline int rows(int level) { return 1 << level; }
+// Tiles in levels [0, levels).
+inline qint64 tileCount(int levels) { return 2 * ((qint64(1) << (2 * levels)) - 1) / 3; }
+
+struct TileKey
+{
+    int level {0};
+    int column {0};
+    int row {0};
+
+    // Position in the index.
+    qint64 index() const { return tileCount(level) + qint64(row) * columns(level) + column; }
+    // The tile `levels` levels up that contains this one.
+    TileKey parent(int levels = 1) const { return {level - levels, column >> levels, row >> levels}; }
+    quint64 packed() const { return quint64(level) << 48 | quint64(row) << 24 | quint64(column); }
+
+    friend bool operator==(const TileKey &a, const TileKey &b)
+    {
+        return a.level == b.level && a.column == b.column && a.row == b.row;
+    }
+    friend size_t qHash(const TileKey &key, size_t seed = 0) { return ::qHash(key.packed(), seed); }
+};
+}
+
+// Builds a pyramid file; tiles may be added in any order, missing ones stay empty.
+class TilePyramidWriter
+{
+public:
+    ~TilePyramidWriter();
+
+    bool open(const QString &fileName, int tileSize, int levels);
+    bool addTile(const TilePyramid::TileKey &key, QByteArrayView encoded);
+    // Writes the index and finalises the header.
+    bool close();
+    QString errorString() const { return m_error; }
+
+private:
+    QFile m_file;
+    int m_tileSize {0};
+    int m_levels {0};
+    qint64 m_offset {0};
+    QVector<quint64> m_offsets;
+    QVector<quint32> m_sizes;
+    QString m_error;
+};
+
+// Memory-maps a pyramid; opening reads only the header and the index, and tiles are read in place.
+class TilePyramidReader
+{
+public:
+    ~TilePyramidReader();
+
+    bool open(const QString &fileName);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+    QString errorString() const { return m_error; }
+
+    int tileSize() const { return m_tileSize; }
+    int levelCount() const { return m_levels; }
+    // Encoded tile bytes in the mapping, empty if the tile is missing.
+    QByteArrayView tile(const TilePyramid::TileKey &key) const;
+
+private:
+    QFile m_file;
+    const uchar *m_data {nullptr};
+    qint64 m_size {0};
+    const uchar *m_index {nullptr};
+    int m_tileSize {0};
+    int m_levels {0};
+    QString m_error;
+};
@@ -0,0 +1,113 @@
+#include "TrackHistory.h"
+
+#include <QMutexLocker>
+#include <QVariantMap>
+#include <algorithm>
+#include <cmath>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+namespace
+{
+QString satelliteId(const QVariantMap &m)
+{
+    return m.value(QStringLiteral("ID"), m.value(QStringLiteral("id"))).toString();
+}
+}
+
+void TrackHistory::setWindow(qint64 windowNs, qint64 spacingNs)
+{
+    QMutexLocker locker(&m_mutex);
+    m_windowNs = std::max<qint64>(windowNs, 0);
+    m_spacingNs = std::max<qint64>(spacingNs, 0);
+}
+
+void TrackHistory::add(qint64 timestampNs, const QVariantList &satellites)
+{
+    if (!isEnabled())
+        return;
+    QMutexLocker locker(&m_mutex);
+    m_newestNs = std::max(m_newestNs, timestampNs);
+    if (timestampNs < m_newestNs - m_windowNs)
+        return; // backfill older than the window
+
+    for (const QVariant &v : satellites) {
+        const QVariantMap m = v.toMap();
+        const QString id = satelliteId(m);
+        if (id.isEmpty())
+            continue;
+        bool okLat = false;
+        bool okLon = false;
+        const double lat = m.value(QStringLiteral("Lat")).toDouble(&okLat);
+        const double lon = m.value(QStringLiteral("Lon")).toDouble(&okLon);
+        if (!okLat || !okLon || !std::isfinite(lat) || !std::isfinite(lon))
+            continue;
+
+        Track &track = m_tracks[id];
+        // Live batches append; backfilled ones may land anywhere.
+        const auto at = std::upper_bound(track.times.cbegin(), track.times.cend(), timestampNs);
+        const qsizetype index = at - track.times.cbegin();
+        if (index > 0 && timestampNs - track.times[index - 1] < m_spacingNs)
+            continue;
+        if (index < track.times.size() && track.times[index] - timestampNs < m_spacingNs)
+            continue;
+        track.times.insert(index, timestampNs);
+        track.points.insert(index, GeoPoint{lat, lon});
+    }
+
+    // Trimming walks every track, so do it at most once per spacing interval.
+    if (m_newestNs - m_lastTrimNs >= std::max<qint64>(m_spacingNs, 1000000000))
+        trim(m_newestNs);
+}
+
+void TrackHistory::trim(qint64 nowNs)
+{
+    const qint64 cutoff = nowNs - m_windowNs;
+    for (auto it = m_tracks.begin(); it != m_tracks.end();) {
+        Track &track = it.value();
+        const qsizetype stale = std::lower_bound(track.times.cbegin(), track.times.cend(), cutoff) - track.times.cbegin();
+        if (stale == track.times.size()) {
+            it = m_tracks.erase(it); // no recent samples: object has gone
+            continue;
+        }
+        if (stale > 0) {
+            track.times.remove(0, stale);
+            track.points.remove(0, stale);
+        }
+        ++it;
+    }
+    m_lastTrimNs = nowNs;
+}
+
+void TrackHistory::attach(QVariantList &satellites) const
+{
+    if (!isEnabled())
+        return;
+    const QString trackKey = QStringLiteral("TrackPast");
+    QMutexLocker locker(&m_mutex);
+    for (QVariant &v : satellites) {
+        QVariantMap m = v.toMap();
+        if (m.contains(trackKey))
+            continue;
+        const auto it = m_tracks.constFind(satelliteId(m));
+        if (it == m_tracks.constEnd() || it->points.size() < 2)
+            continue;
+        m.insert(trackKey, QVariant::fromValue(it->points));
+        v = m;
+    }
+}
+
+void TrackHistory::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_tracks.clear();
+    m_newestNs = 0;
+    m_lastTrimNs = 0;
+}
+
+int TrackHistory::size() const
+{
+    QMutexLocker locker(&m_mutex);
+    return int(m_tracks.size());
+}
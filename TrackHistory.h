@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QVariantList>
+#include <QVector>
+
+#include "GeoTypes.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Recent positions per satellite, built from streamed batches (live or backfilled, in any order) and attached to
+// outgoing batches as `TrackPast`. Samples closer than the spacing are dropped and samples older than the window
+// (relative to the newest batch) are trimmed, so memory stays bounded. Thread-safe.
+class TrackHistory
+{
+public:
+    // A zero window disables the history.
+    void setWindow(qint64 windowNs, qint64 spacingNs);
+    bool isEnabled() const { return m_windowNs > 0; }
+
+    void add(qint64 timestampNs, const QVariantList &satellites);
+    // Sets `TrackPast` on entries that do not already carry one. The point lists are shared, not copied.
+    void attach(QVariantList &satellites) const;
+    void clear();
+
+    int size() const;
+
+private:
+    struct Track
+    {
+        QVector<qint64> times;   // ascending
+        QVector<GeoPoint> points; // parallel to times
+    };
+
+    void trim(qint64 nowNs);
+
+    qint64 m_windowNs {0};
+    qint64 m_spacingNs {0};
+    mutable QMutex m_mutex;
+    QHash<QString, Track> m_tracks;
+    qint64 m_newestNs {0};
+    qint64 m_lastTrimNs {0};
+};
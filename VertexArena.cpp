@@ -0,0 +1,115 @@
+#include "VertexArena.h"
+
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+namespace
+{
+constexpr int MinCapacity = 256;
+}
+
+namespace VertexArena
+{
+
+void *reserveData(QSGGeometry *geometry, int maxVertices)
+{
+    const int capacity = geometry->vertexCount();
+    int wanted = capacity;
+    if (maxVertices > capacity)
+        wanted = std::max({maxVertices, capacity + capacity / 2, MinCapacity});
+    else if (capacity > MinCapacity && maxVertices < capacity / 4)
+        wanted = std::max(maxVertices * 2, MinCapacity); // hysteresis: shrink only when mostly unused
+    if (wanted != capacity)
+        geometry->allocate(wanted);
+    return geometry->vertexData();
+}
+
+void finish(QSGGeometry *geometry, int used)
+{
+    auto *data = static_cast<char *>(geometry->vertexData());
+    const int capacity = geometry->vertexCount();
+    const int stride = geometry->sizeOfVertex();
+    used = std::min(used, capacity);
+    if (used == 0) {
+        std::fill(data, data + qsizetype(capacity) * stride, char(0));
+        return;
+    }
+    const char *pad = data + qsizetype(used - 1) * stride;
+    for (int i = used; i < capacity; ++i)
+        std::memcpy(data + qsizetype(i) * stride, pad, size_t(stride));
+}
+
+int vertexLimit(qint64 byteLimit)
+{
+    if (byteLimit <= 0)
+        return std::numeric_limits<int>::max();
+    return int(std::min<qint64>(byteLimit / qint64(sizeof(QSGGeometry::Point2D)), std::numeric_limits<int>::max()));
+}
+
+int lodStride(qint64 vertices, int limit)
+{
+    return vertices <= limit ? 1 : int((vertices + limit - 1) / limit);
+}
+
+int dotSegmentsFor(int count, int segments, int limit)
+{
+    while (segments > 3 && qint64(count) * 3 * segments > limit)
+        --segments;
+    return segments;
+}
+
+void appendDotCentres(const float *xy, qsizetype n, const QRectF &rect, qreal radius, QVector<float> &centres)
+{
+    const float left = float(rect.x() + radius);
+    const float right = float(rect.x() + rect.width() - radius);
+    const float w = float(rect.width());
+    for (qsizetype i = 0; i < n; ++i) {
+        const float x = xy[2 * i];
+        const float y = xy[2 * i + 1];
+        centres.append(x);
+        centres.append(y);
+        if (x < left) {
+            centres.append(x + w);
+            centres.append(y);
+        }
+        if (x > right) {
+            centres.append(x - w);
+            centres.append(y);
+        }
+    }
+}
+
+void dotRing(int segments, float radius, float *ring)
+{
+    for (int s = 0; s <= segments; ++s) {
+        const double a = (2 * M_PI * s) / segments;
+        ring[2 * s] = float(std::cos(a) * radius);
+        ring[2 * s + 1] = float(std::sin(a) * radius);
+    }
+}
+
+void writeDot(QSGGeometry::Point2D *v, float cx, float cy, const float *ring, int segments)
+{
+    for (int s = 0; s < segments; ++s) {
+        v[3 * s].set(cx, cy);
+        v[3 * s + 1].set(cx + ring[2 * s], cy + ring[2 * s + 1]);
+        v[3 * s + 2].set(cx + ring[2 * s + 2], cy + ring[2 * s + 3]);
+    }
+}
+
+int writeDots(QSGGeometry::Point2D *v, const float *centres, int count, int segments, float radius)
+{
+    std::array<float, 2 * (MaxDotSegments + 1)> ring;
+    dotRing(segments, radius, ring.data());
+    for (int i = 0; i < count; ++i)
+        writeDot(v + 3 * segments * i, centres[2 * i], centres[2 * i + 1], ring.data(), segments);
+    return 3 * segments * count;
+}
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QRectF>
+#include <QSGGeometry>
+#include <QVector>
+#include <QtGlobal>
+#include <algorithm>
+
+#include "Projection.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Growth-only vertex storage for a layer's QSGGeometry. QSGGeometry::allocate() reallocates whenever the vertex count
+// changes, which for the overlay layers is nearly every update. Instead the geometry keeps a capacity that grows
+// geometrically (and shrinks only when mostly unused); layers write straight into it and the unused tail is filled
+// with copies of one vertex, i.e. zero-area triangles or zero-length lines that rasterise to nothing.
+namespace VertexArena
+{
+// Ensures room for `maxVertices` and returns the vertex array to write from index 0.
+void *reserveData(QSGGeometry *geometry, int maxVertices);
+inline QSGGeometry::Point2D *reserve(QSGGeometry *geometry, int maxVertices)
+{
+    return static_cast<QSGGeometry::Point2D *>(reserveData(geometry, maxVertices));
+}
+// Pads [used, capacity) with degenerate vertices (copies of the last one), for any vertex layout.
+void finish(QSGGeometry *geometry, int used);
+
+// Vertices that fit in `byteLimit` (0: unlimited).
+int vertexLimit(qint64 byteLimit);
+
+// Shared writers for the overlay layers. Positions are (x, y) float pairs as produced by Projection.
+
+constexpr int MaxDotSegments = 10;
+
+// Smallest stride that brings `vertices` within `limit`.
+int lodStride(qint64 vertices, int limit);
+// Segments per dot, reduced towards a triangle until `count` dots fit in `limit` vertices.
+int dotSegmentsFor(int count, int segments, int limit);
+// Appends the dot centre, plus a copy across the seam for dots within `radius` of a view edge.
+void appendDotCentres(const float *xy, qsizetype n, const QRectF &rect, qreal radius, QVector<float> &centres);
+// Offsets of a dot's rim, 2 * (segments + 1) floats, for writeDot.
+void dotRing(int segments, float radius, float *ring);
+// One filled circle (at most MaxDotSegments segments) as a triangle list, 3 * segments vertices.
+void writeDot(QSGGeometry::Point2D *v, float cx, float cy, const float *ring, int segments);
+// Dots around the (x, y) centres; returns the vertices written.
+int writeDots(QSGGeometry::Point2D *v, const float *centres, int count, int segments, float radius);
+// Line segments along xy[0..n), keeping every `step`-th point and the last, each ending at the copy of its end point
+// nearest its start (so none spans the seam). Writes from `idx`, stops at `cap`, and returns the new end. `Vertex` is
+// any type with set(float x, float y): Point2D in item pixels, or CompactPoint2D in map units (width 1). Segments
+// whose bounds miss a non-null `visible` rect are skipped.
+template <typename Vertex>
+int writePolyline(Vertex *v, int idx, int cap, const float *xy, int n, int step, qreal width, const QRectF &visible = QRectF())
+{
+    const bool cull = !visible.isNull();
+    for (int from = 0; from + 1 < n && idx + 2 <= cap;) {
+        const int to = std::min(from + step, n - 1);
+        const float ax = xy[2 * from];
+        const float ay = xy[2 * from + 1];
+        const float bx = float(Projection::nearestCopy(ax, xy[2 * to], width));
+        const float by = xy[2 * to + 1];
+        from = to;
+        if (cull && (std::max(ax, bx) < visible.left() || std::min(ax, bx) > visible.right() || std::max(ay, by) < visible.top()
+                     || std::min(ay, by) > visible.bottom()))
+            continue;
+        v[idx++].set(ax, ay);
+        v[idx++].set(bx, by);
+    }
+    return idx;
+}
+}
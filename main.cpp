@@ -1,9 +1,19 @@
+#include <QCommandLineParser>
 #include <QGuiApplication>
 #include <QQmlApplicationEngine>
 #include <QQmlEngine>
+#include <QStringList>
+#include <QTextStream>
+#include <cmath>
+#include <limits>
 
 #include "EarthView.h"
 #include "OrbitFeed.h"
+#include "ReplayFeedSource.h"
+#ifdef EARTH_VIEW_HAVE_SHM
+#include "ShmFeedSource.h"
+#endif
+#include "SyntheticFeedSource.h"
 
 // Copyright (c) 2026 Andy Armitage
 // This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
@@ -12,7 +22,134 @@ int main(int argc, char *argv[])
 {
     QGuiApplication app(argc, argv);
 
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    const QCommandLineOption natsUrlOption(QStringLiteral("nats"), QStringLiteral("NATS server URL."), QStringLiteral("url"),
+                                           QStringLiteral("nats://127.0.0.1:4222"));
+    const QCommandLineOption subjectOption(QStringLiteral("subject"), QStringLiteral("Orbit state subject."), QStringLiteral("subject"),
+                                           QStringLiteral("m.orbit.*"));
+    const QCommandLineOption bucketOption(QStringLiteral("kv-bucket"), QStringLiteral("Ground-station KV bucket."), QStringLiteral("bucket"),
+                                          QStringLiteral("mgs"));
+    const QCommandLineOption replayOption(QStringLiteral("replay"), QStringLiteral("Replay a feed capture file instead of NATS."),
+                                          QStringLiteral("file"));
+    const QCommandLineOption speedOption(QStringLiteral("speed"), QStringLiteral("Replay speed factor, or \"max\" for no delays."),
+                                         QStringLiteral("factor"), QStringLiteral("1"));
+    const QCommandLineOption loopOption(QStringLiteral("loop"), QStringLiteral("Loop the replay."));
+    const QCommandLineOption fromOption(QStringLiteral("from"), QStringLiteral("Start the replay this many seconds into the capture."),
+                                        QStringLiteral("seconds"), QStringLiteral("0"));
+    const QCommandLineOption recordOption(QStringLiteral("record"), QStringLiteral("Record NATS traffic to a capture file."),
+                                          QStringLiteral("file"));
+    const QCommandLineOption syntheticOption(QStringLiteral("synthetic"), QStringLiteral("Run a synthetic constellation of this many satellites."),
+                                             QStringLiteral("count"));
+    const QCommandLineOption rateOption(QStringLiteral("rate"), QStringLiteral("Synthetic update rate."), QStringLiteral("hz"),
+                                        QStringLiteral("1"));
+    const QCommandLineOption stationsOption(QStringLiteral("stations"), QStringLiteral("Synthetic ground-station count."),
+                                            QStringLiteral("count"), QStringLiteral("20"));
+    const QCommandLineOption maskPointsOption(QStringLiteral("mask-points"), QStringLiteral("Points per synthetic station mask."),
+                                              QStringLiteral("count"), QStringLiteral("72"));
+    const QCommandLineOption edgeCasesOption(QStringLiteral("edge-cases"), QStringLiteral("Add seam-crossing and pole-passing objects."));
+    const QCommandLineOption encodeOption(QStringLiteral("encode"), QStringLiteral("Round-trip synthetic batches through CBOR."));
+    const QCommandLineOption compressOption(QStringLiteral("compress"),
+                                            QStringLiteral("Compress encoded synthetic batches (zstd or lz4)."),
+                                            QStringLiteral("codec"));
+    const QCommandLineOption compactOption(QStringLiteral("compact"),
+                                           QStringLiteral("Round-trip synthetic batches through the compact delta encoding."));
+    const QCommandLineOption historyOption(QStringLiteral("history-minutes"),
+                                           QStringLiteral("Keep this much streamed track history; with NATS, backfill it from JetStream on start."),
+                                           QStringLiteral("minutes"), QStringLiteral("0"));
+    const QCommandLineOption backfillStreamOption(QStringLiteral("backfill-stream"),
+                                                  QStringLiteral("JetStream stream holding the orbit subject (default: look up by subject)."),
+                                                  QStringLiteral("stream"));
+    const QCommandLineOption propagationRateOption(QStringLiteral("propagation-rate"),
+                                                   QStringLiteral("Update rate for objects propagated from element sets."),
+                                                   QStringLiteral("hz"), QStringLiteral("10"));
+    const QCommandLineOption trackMinutesOption(QStringLiteral("track-minutes"),
+                                                QStringLiteral("Propagated track length either side of now."),
+                                                QStringLiteral("minutes"), QStringLiteral("45"));
+    const QCommandLineOption latencyOption(QStringLiteral("latency"),
+                                           QStringLiteral("Log per-stage feed and render latency every window."),
+                                           QStringLiteral("seconds"));
+    parser.addOptions({natsUrlOption, subjectOption, bucketOption, replayOption, speedOption, loopOption, fromOption, recordOption,
+                       syntheticOption, rateOption, stationsOption, maskPointsOption, edgeCasesOption, encodeOption,
+                       compactOption, compressOption, historyOption, backfillStreamOption, propagationRateOption,
+                       trackMinutesOption, latencyOption});
+#ifdef EARTH_VIEW_HAVE_SHM
+    const QCommandLineOption shmOption(QStringLiteral("shm"), QStringLiteral("Read states from a co-located publisher's shared-memory segment."),
+                                       QStringLiteral("name"));
+    parser.addOption(shmOption);
+#endif
+    parser.process(app);
+
+    // --speed is "max" or a positive factor; anything else is rejected before a window opens.
+    const QString speed = parser.value(speedOption);
+    const bool replayAsFastAsPossible = speed == QLatin1String("max");
+    bool speedOk = replayAsFastAsPossible;
+    const double speedFactor = replayAsFastAsPossible ? 1.0 : speed.toDouble(&speedOk);
+    if (!speedOk || !std::isfinite(speedFactor) || speedFactor <= 0.0) {
+        QTextStream(stderr) << "Invalid --speed " << speed << ": expected a positive factor or \"max\"" << Qt::endl;
+        return 2;
+    }
+    // Numeric options are range-checked the same way, so a typo fails here instead of silently becoming 0.
+    const auto reject = [&parser](const QCommandLineOption &option, const char *expected) {
+        QTextStream(stderr) << "Invalid --" << option.names().constFirst() << ' ' << parser.value(option)
+                            << ": expected " << expected << Qt::endl;
+        return 2;
+    };
+    const auto readNumber = [&parser](const QCommandLineOption &option, double minimum, double maximum, double &value) {
+        bool ok = false;
+        value = parser.value(option).toDouble(&ok);
+        return ok && std::isfinite(value) && value >= minimum && value <= maximum;
+    };
+    const auto readCount = [&parser](const QCommandLineOption &option, int &value) {
+        bool ok = false;
+        value = parser.value(option).toInt(&ok);
+        return ok && value >= 0;
+    };
+    const double maxOffsetSeconds = double(std::numeric_limits<qint64>::max()) / 1000.0;
+    double fromSeconds = 0.0;
+    if (!readNumber(fromOption, 0.0, maxOffsetSeconds, fromSeconds))
+        return reject(fromOption, "a non-negative number of seconds");
+    int satelliteCount = 0;
+    if (parser.isSet(syntheticOption) && !readCount(syntheticOption, satelliteCount))
+        return reject(syntheticOption, "a non-negative count");
+    int stationCount = 0;
+    if (!readCount(stationsOption, stationCount))
+        return reject(stationsOption, "a non-negative count");
+    int maskPoints = 0;
+    if (!readCount(maskPointsOption, maskPoints))
+        return reject(maskPointsOption, "a non-negative count");
+    double syntheticRateHz = 0.0;
+    if (!readNumber(rateOption, 0.0, 1000.0, syntheticRateHz) || syntheticRateHz == 0.0)
+        return reject(rateOption, "a rate above 0 and at most 1000 Hz");
+    double historyMinutes = 0.0;
+    if (!readNumber(historyOption, 0.0, 10080.0, historyMinutes))
+        return reject(historyOption, "0 to 10080 minutes");
+    double propagationRateHz = 0.0;
+    if (!readNumber(propagationRateOption, 0.0, 1000.0, propagationRateHz) || propagationRateHz == 0.0)
+        return reject(propagationRateOption, "a rate above 0 and at most 1000 Hz");
+    double trackMinutes = 0.0;
+    if (!readNumber(trackMinutesOption, 0.0, 1440.0, trackMinutes))
+        return reject(trackMinutesOption, "0 to 1440 minutes");
+    double latencyWindowSeconds = 0.0;
+    if (parser.isSet(latencyOption) && (!readNumber(latencyOption, 0.0, 86400.0, latencyWindowSeconds)
+                                        || latencyWindowSeconds == 0.0)) {
+        return reject(latencyOption, "a window above 0 and at most 86400 seconds");
+    }
+    PayloadCompression::Codec compression = PayloadCompression::Codec::None;
+    if (parser.isSet(compressOption)) {
+        const QString codec = parser.value(compressOption);
+        if (!PayloadCompression::fromName(codec, compression)) {
+            QTextStream(stderr) << "Invalid --compress " << codec << ": expected zstd or lz4" << Qt::endl;
+            return 2;
+        }
+        if (!PayloadCompression::isAvailable(compression)) {
+            QTextStream(stderr) << "--compress " << codec << ": this build has no " << codec << " support" << Qt::endl;
+            return 2;
+        }
+    }
+
     qmlRegisterType<EarthView>("EarthView", 1, 0, "EarthView");
+    qmlRegisterType<EarthModel>("EarthView", 1, 0, "EarthModel");
 
     QQmlApplicationEngine engine;
     engine.addImportPath(QStringLiteral("qrc:/"));
@@ -24,21 +161,92 @@ int main(int argc, char *argv[])
         Qt::QueuedConnection);
     engine.loadFromModule("EarthView", "Main");
 
-    // Wire NATS orbit feed to EarthView in the sample app (EarthView itself stays NATS-agnostic).
+    // Wire a feed source to EarthView in the sample app (EarthView itself stays transport-agnostic).
     if (!engine.rootObjects().isEmpty()) {
         QObject *root = engine.rootObjects().first();
         if (auto *earth = root->findChild<EarthView *>(QStringLiteral("earthView"))) {
-            auto *feed = new OrbitFeed(&app);
-            QObject::connect(feed, &OrbitFeed::satellitesUpdated, earth, [earth](const QVariantList &sats) {
-                earth->setSatellites(sats);
+            FeedSource *feed = nullptr;
+#ifdef EARTH_VIEW_HAVE_SHM
+            if (parser.isSet(shmOption)) {
+                auto *shm = new ShmFeedSource(&app);
+                shm->setName(parser.value(shmOption));
+                feed = shm;
+            } else
+#endif
+            if (parser.isSet(syntheticOption)) {
+                SyntheticConstellation::Config config;
+                config.satelliteCount = satelliteCount;
+                config.groundStationCount = stationCount;
+                config.maskPoints = maskPoints;
+                if (parser.isSet(edgeCasesOption))
+                    config.edgeCases = SyntheticConstellation::SeamCrossings | SyntheticConstellation::PolePasses;
+                auto *synthetic = new SyntheticFeedSource(&app);
+                synthetic->setConfig(config);
+                synthetic->setUpdateRateHz(syntheticRateHz);
+                if (parser.isSet(compactOption))
+                    synthetic->setPayloadEncoding(SyntheticFeedSource::PayloadEncoding::Compact);
+                else if (parser.isSet(encodeOption))
+                    synthetic->setPayloadEncoding(SyntheticFeedSource::PayloadEncoding::Cbor);
+                synthetic->setCompression(compression);
+                feed = synthetic;
+            } else if (parser.isSet(replayOption)) {
+                auto *replay = new ReplayFeedSource(&app);
+                replay->setFileName(parser.value(replayOption));
+                if (replayAsFastAsPossible) {
+                    replay->setPacing(ReplayFeedSource::Pacing::AsFastAsPossible);
+                } else {
+                    replay->setPacing(qFuzzyCompare(speedFactor, 1.0) ? ReplayFeedSource::Pacing::RealTime
+                                                                      : ReplayFeedSource::Pacing::Accelerated);
+                    replay->setSpeed(speedFactor);
+                }
+                replay->setLoop(parser.isSet(loopOption));
+                replay->setStartOffsetMs(qint64(fromSeconds * 1000.0));
+                feed = replay;
+            } else {
+                auto *nats = new OrbitFeed(&app);
+                nats->setUrl(parser.value(natsUrlOption));
+                nats->setSubject(parser.value(subjectOption));
+                nats->setKvBucket(parser.value(bucketOption));
+                nats->setBackfillMinutes(historyMinutes);
+                nats->setBackfillStream(parser.value(backfillStreamOption));
+                if (parser.isSet(recordOption))
+                    nats->startRecording(parser.value(recordOption));
+                feed = nats;
+            }
+
+            if (historyMinutes > 0.0)
+                feed->setTrackHistory(historyMinutes * 60.0, 10.0);
+            feed->setPropagationRateHz(propagationRateHz);
+            feed->setPropagationTrack(trackMinutes * 60.0, 60.0);
+
+            if (parser.isSet(latencyOption)) {
+                feed->setLatencyReport(latencyWindowSeconds, true);
+                QObject::connect(earth, &EarthView::latencyStatsChanged, earth, [earth]() {
+                    const QVariantMap stats = earth->latencyStats();
+                    QStringList parts;
+                    for (auto it = stats.constBegin(); it != stats.constEnd(); ++it)
+                        parts.append(QStringLiteral("%1 %2").arg(it.key(), LatencyHistogram::Summary::fromVariantMap(it.value().toMap()).toString()));
+                    if (!parts.isEmpty())
+                        qInfo().noquote() << QStringLiteral("View latency: %1; %2 batches never drawn")
+                                                 .arg(parts.join(QStringLiteral("; ")))
+                                                 .arg(earth->droppedBatches());
+                });
+            }
+
+            QObject::connect(feed, &FeedSource::satellitesUpdated, earth, [earth](const QVariantList &sats, qint64 originNs) {
+                earth->setSatellites(sats, originNs);
             });
-            QObject::connect(feed, &OrbitFeed::groundStationsUpdated, earth, [earth](const QVariantList &stations) {
-                earth->setGroundStations(stations);
+            QObject::connect(feed, &FeedSource::satelliteStatesUpdated, earth,
+                             [earth](const CompactStates::Batch &states, qint64 originNs) {
+                                 earth->setSatelliteStates(states, originNs);
+                             });
+            QObject::connect(feed, &FeedSource::groundStationsUpdated, earth, [earth](const GroundStationList &stations) {
+                earth->setGroundStationData(stations);
             });
-            QObject::connect(feed, &OrbitFeed::statusMessage, [](const QString &msg) {
+            QObject::connect(feed, &FeedSource::statusMessage, [](const QString &msg) {
                 qInfo().noquote() << msg;
             });
-            feed->setSubject(QStringLiteral("m.orbit.*"));
+            QObject::connect(&app, &QCoreApplication::aboutToQuit, feed, &FeedSource::stop);
             feed->start();
         }
     }
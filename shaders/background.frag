@@ -0,0 +1,27 @@
+#version 440
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+layout(location = 0) in vec2 texCoord;
+
+layout(location = 0) out vec4 fragColor;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    vec4 tint;
+    float uOffset;
+    float saturation; // 0: grey, 1: as drawn
+    float brightness; // 0: black, 1: as drawn
+    float qt_Opacity;
+};
+
+layout(binding = 1) uniform sampler2D source;
+
+void main()
+{
+    vec4 c = texture(source, texCoord); // premultiplied, so every step below keeps it premultiplied
+    float grey = dot(c.rgb, vec3(0.2126, 0.7152, 0.0722));
+    vec3 rgb = min(mix(vec3(grey), c.rgb, saturation) * tint.rgb * brightness, vec3(c.a));
+    fragColor = vec4(rgb, c.a) * qt_Opacity;
+}
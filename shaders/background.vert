@@ -0,0 +1,26 @@
+#version 440
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// The view's quad with map-fraction texture coordinates, shifted by the centre longitude; the texture repeats
+// horizontally, so a pan only changes uOffset.
+layout(location = 0) in vec4 qt_VertexPosition;
+layout(location = 1) in vec2 qt_VertexTexCoord;
+
+layout(location = 0) out vec2 texCoord;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    vec4 tint;
+    float uOffset; // centerLongitude / 360
+    float saturation;
+    float brightness;
+    float qt_Opacity;
+};
+
+void main()
+{
+    texCoord = qt_VertexTexCoord + vec2(uOffset, 0.0);
+    gl_Position = qt_Matrix * qt_VertexPosition;
+}
@@ -0,0 +1,18 @@
+#version 440
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+layout(location = 0) out vec4 fragColor;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    vec4 color; // premultiplied
+    vec4 mapRect;
+    float qt_Opacity;
+};
+
+void main()
+{
+    fragColor = color * qt_Opacity;
+}
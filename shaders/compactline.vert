@@ -0,0 +1,21 @@
+#version 440
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Unsigned 16-bit map coordinates (see CompactPoint2D) to item pixels.
+layout(location = 0) in uvec2 vertexCoord;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    vec4 color;
+    vec4 mapRect; // x, y, width, height in item pixels
+    float qt_Opacity;
+};
+
+void main()
+{
+    vec2 t = vec2(vertexCoord) / 65535.0;
+    vec2 pos = mapRect.xy + vec2(t.x * 3.0 - 1.0, t.y) * mapRect.zw;
+    gl_Position = qt_Matrix * vec4(pos, 0.0, 1.0);
+}
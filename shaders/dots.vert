@@ -0,0 +1,17 @@
+#version 440
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Dot triangles in item pixels (DotBufferNode).
+layout(location = 0) in vec2 vertexCoord;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 mvp;
+    vec4 color;
+};
+
+void main()
+{
+    gl_Position = mvp * vec4(vertexCoord, 0.0, 1.0);
+}
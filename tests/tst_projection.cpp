@@ -0,0 +1,143 @@
+#include <QVector>
+#include <QtTest>
+#include <algorithm>
+#include <cmath>
+
+#include "GeoTypes.h"
+#include "Projection.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// The batch projection kernels (SSE2, NEON or WASM SIMD128, whichever this build targets) against their scalar
+// references: wrapped and unwrapped, column (stride 1) and interleaved GeoPoint (stride 2) input, lengths that leave a
+// scalar tail, and longitudes far west of the view, where wrapping floors negative values.
+
+namespace
+{
+constexpr float Tolerance = 1e-3f;
+
+// Longitudes around and beyond the seam on both sides, negative multiples of a half and whole turn included.
+const double Longitudes[] = {-900.0, -540.0, -450.0, -360.0, -270.0, -180.0001, -180.0, -179.9999, -90.5, -0.0001,
+                             0.0,    0.0001, 45.25,  179.9999, 180.0,  180.0001,  270.0,  359.9,     540.0, 725.5};
+constexpr int LongitudeCount = int(sizeof(Longitudes) / sizeof(Longitudes[0]));
+
+using Kernel = void (*)(const Projection::Mapping &, const double *, const double *, qsizetype, qsizetype, float *);
+
+void compareKernels(Kernel kernel, Kernel reference, const Projection::Mapping &m, int n, qsizetype stride)
+{
+    // Element i * stride of each array is point i; with stride 2 the gaps hold garbage the kernels must skip.
+    QVector<double> lat(n * stride, 1e9);
+    QVector<double> lon(n * stride, 1e9);
+    for (int i = 0; i < n; ++i) {
+        lat[i * stride] = -89.5 + 179.0 * i / std::max(n - 1, 1);
+        lon[i * stride] = Longitudes[i % LongitudeCount];
+    }
+    QVector<float> actual(2 * n, -1.0f);
+    QVector<float> expected(2 * n, -2.0f);
+    kernel(m, lat.constData(), lon.constData(), n, stride, actual.data());
+    reference(m, lat.constData(), lon.constData(), n, stride, expected.data());
+    for (int i = 0; i < 2 * n; ++i) {
+        QVERIFY2(std::abs(actual[i] - expected[i]) <= Tolerance,
+                 qPrintable(QStringLiteral("n %1 stride %2 component %3 (lon %4): %5, reference %6")
+                                .arg(n)
+                                .arg(stride)
+                                .arg(i)
+                                .arg(lon[(i / 2) * stride])
+                                .arg(actual[i])
+                                .arg(expected[i])));
+    }
+}
+}
+
+class ProjectionTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void matchesReference_data();
+    void matchesReference();
+    void interleavedGeoPoints();
+    void wrapsNegativeLongitudes();
+    void pointHelpersMatchBatch();
+};
+
+void ProjectionTest::matchesReference_data()
+{
+    QTest::addColumn<bool>("wrapped");
+    QTest::addColumn<int>("stride");
+    QTest::addColumn<double>("centerLongitude");
+    for (bool wrapped : {true, false}) {
+        for (int stride : {1, 2}) {
+            for (double centre : {0.0, 123.4, -170.0}) {
+                QTest::addRow("%s stride %d centre %g", wrapped ? "wrapped" : "unwrapped", stride, centre)
+                    << wrapped << stride << centre;
+            }
+        }
+    }
+}
+
+void ProjectionTest::matchesReference()
+{
+    QFETCH(bool, wrapped);
+    QFETCH(int, stride);
+    QFETCH(double, centerLongitude);
+    const auto m = Projection::Mapping::forView(QRectF(-37.5, 12.0, 1280.0, 640.0), centerLongitude);
+    const Kernel kernel = wrapped ? Kernel(&Projection::projectWrapped) : Kernel(&Projection::projectUnwrapped);
+    const Kernel reference = wrapped ? &Projection::projectWrappedReference : &Projection::projectUnwrappedReference;
+    // Every length up to a few SIMD blocks, so each tail length is covered, then a long run.
+    for (int n : {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 11, 16, 17, LongitudeCount, 1000})
+        compareKernels(kernel, reference, m, n, stride);
+}
+
+void ProjectionTest::interleavedGeoPoints()
+{
+    // The stride-2 call as the layers make it, over a GeoPoint track.
+    QVector<GeoPoint> track;
+    for (int i = 0; i < LongitudeCount; ++i)
+        track.append(GeoPoint {-60.0 + i * 6.0, Longitudes[i]});
+    const auto m = Projection::Mapping::forView(QRectF(0.0, 0.0, 720.0, 360.0), 30.0);
+    QVector<float> actual(track.size() * 2);
+    QVector<float> expected(track.size() * 2);
+    Projection::projectWrapped(m, &track.constData()->lat, &track.constData()->lon, track.size(), 2, actual.data());
+    Projection::projectWrappedReference(m, &track.constData()->lat, &track.constData()->lon, track.size(), 2,
+                                        expected.data());
+    for (int i = 0; i < actual.size(); ++i)
+        QVERIFY2(std::abs(actual[i] - expected[i]) <= Tolerance, qPrintable(QStringLiteral("component %1").arg(i)));
+}
+
+void ProjectionTest::wrapsNegativeLongitudes()
+{
+    // One degree per pixel, the seam at x = 0: x is the longitude plus 180, wrapped into [0, 360). The values fill a
+    // whole SIMD block, so the vector floor sees negative inputs (truncation rounds those up).
+    const auto m = Projection::Mapping::forView(QRectF(0.0, 0.0, 360.0, 180.0), 0.0);
+    const double lat[4] = {0.0, 0.0, 0.0, 0.0};
+    const double lon[4] = {-450.0, -315.0, -190.0, -1000.0};
+    const float expectedX[4] = {90.0f, 225.0f, 350.0f, 260.0f};
+    float xy[8];
+    Projection::projectWrapped(m, lat, lon, 4, 1, xy);
+    for (int i = 0; i < 4; ++i) {
+        QVERIFY2(std::abs(xy[2 * i] - expectedX[i]) <= Tolerance,
+                 qPrintable(QStringLiteral("lon %1: x %2, expected %3").arg(lon[i]).arg(xy[2 * i]).arg(expectedX[i])));
+        QVERIFY(xy[2 * i] >= 0.0f && xy[2 * i] < 360.0f);
+        QCOMPARE(xy[2 * i + 1], 90.0f);
+    }
+}
+
+void ProjectionTest::pointHelpersMatchBatch()
+{
+    // Hit testing and the single-point helpers agree with a batch call, whose first blocks take the SIMD path.
+    const auto m = Projection::Mapping::forView(QRectF(10.0, 20.0, 1000.0, 500.0), -45.0);
+    QVector<double> lat(LongitudeCount, 12.5);
+    QVector<float> xy(2 * LongitudeCount);
+    Projection::projectWrapped(m, lat.constData(), Longitudes, LongitudeCount, 1, xy.data());
+    for (int i = 0; i < LongitudeCount; ++i) {
+        const QPointF p = Projection::projectWrapped(m, lat[i], Longitudes[i]);
+        QVERIFY2(std::abs(float(p.x()) - xy[2 * i]) <= Tolerance && std::abs(float(p.y()) - xy[2 * i + 1]) <= Tolerance,
+                 qPrintable(QStringLiteral("lon %1").arg(Longitudes[i])));
+    }
+}
+
+QTEST_APPLESS_MAIN(ProjectionTest)
+
+#include "tst_projection.moc"
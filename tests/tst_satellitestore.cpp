@@ -0,0 +1,115 @@
+#include <QVariantList>
+#include <QVariantMap>
+#include <QtNumeric>
+#include <QtTest>
+#include <cmath>
+
+#include "CompactStates.h"
+#include "SatelliteStore.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Row and slot bookkeeping of SatelliteStore, in particular batches that repeat an ID: the layers index rows by
+// drawing slot, so each ID must end up in exactly one row.
+
+namespace
+{
+QVariantMap state(const QVariant &id, double lat, double lon)
+{
+    QVariantMap m {{QStringLiteral("Lat"), lat}, {QStringLiteral("Lon"), lon}};
+    if (id.isValid())
+        m.insert(QStringLiteral("ID"), id);
+    return m;
+}
+
+// Every row has its own slot, and rowOf() finds each ID's row.
+void verifyOneRowPerSlot(const SatelliteStore &store)
+{
+    QVector<int> rowBySlot(store.slotCount(), -1);
+    for (int row = 0; row < store.size(); ++row) {
+        const int slot = store.slot(row);
+        QVERIFY(slot >= 0 && slot < store.slotCount());
+        QVERIFY2(rowBySlot[slot] < 0, qPrintable(QStringLiteral("slot %1 has rows %2 and %3")
+                                                     .arg(slot)
+                                                     .arg(rowBySlot[slot])
+                                                     .arg(row)));
+        rowBySlot[slot] = row;
+        if (!store.id(row).isEmpty())
+            QCOMPARE(store.rowOf(store.id(row)), row);
+    }
+}
+}
+
+class SatelliteStoreTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void duplicateIdsInList();
+    void duplicateIdsInColumns();
+    void rowsWithoutIdsAreKept();
+    void slotsStableAcrossBatches();
+};
+
+void SatelliteStoreTest::duplicateIdsInList()
+{
+    // The last entry for an ID wins and keeps the row of the first.
+    SatelliteStore store;
+    store.assign(QVariantList {state(QStringLiteral("a"), 10.0, 20.0), state(QStringLiteral("b"), 11.0, 21.0),
+                               state(QStringLiteral("a"), 12.0, 22.0)});
+    QCOMPARE(store.size(), 2);
+    verifyOneRowPerSlot(store);
+    const int a = store.rowOf(QStringLiteral("a"));
+    QCOMPARE(a, 0);
+    QCOMPARE(store.lat()[a], 12.0);
+    QCOMPARE(store.lon()[a], 22.0);
+    QCOMPARE(store.attributes(a).value(QStringLiteral("Lat")).toDouble(), 12.0);
+    QCOMPARE(store.lat()[store.rowOf(QStringLiteral("b"))], 11.0);
+}
+
+void SatelliteStoreTest::duplicateIdsInColumns()
+{
+    CompactStates::Batch batch;
+    batch.ids = {7, 8, 7, 7};
+    batch.lat = {1.0, 2.0, 3.0, 4.0};
+    batch.lon = {5.0, 6.0, 7.0, 8.0};
+    batch.alt = {100.0, 200.0, 300.0, qQNaN()};
+    SatelliteStore store;
+    store.assign(batch);
+    QCOMPARE(store.size(), 2);
+    verifyOneRowPerSlot(store);
+    const int row = store.rowOf(QStringLiteral("7"));
+    QCOMPARE(row, 0);
+    QCOMPARE(store.lat()[row], 4.0);
+    QCOMPARE(store.lon()[row], 8.0);
+    // The whole row comes from the last entry, missing values included.
+    QVERIFY(std::isnan(store.alt()[row]));
+    QCOMPARE(store.toVariantList().size(), 2);
+}
+
+void SatelliteStoreTest::rowsWithoutIdsAreKept()
+{
+    // Only IDs are deduplicated; anonymous entries are separate objects.
+    SatelliteStore store;
+    store.assign(QVariantList {state(QVariant(), 1.0, 1.0), state(QVariant(), 1.0, 1.0),
+                               state(QStringLiteral("x"), 2.0, 2.0)});
+    QCOMPARE(store.size(), 3);
+    verifyOneRowPerSlot(store);
+}
+
+void SatelliteStoreTest::slotsStableAcrossBatches()
+{
+    SatelliteStore store;
+    store.assign(QVariantList {state(QStringLiteral("a"), 1.0, 1.0), state(QStringLiteral("b"), 2.0, 2.0)});
+    const int slotB = store.slot(store.rowOf(QStringLiteral("b")));
+    store.assign(QVariantList {state(QStringLiteral("b"), 3.0, 3.0), state(QStringLiteral("b"), 4.0, 4.0)});
+    QCOMPARE(store.size(), 1);
+    QCOMPARE(store.slot(0), slotB);
+    QCOMPARE(store.rowOf(QStringLiteral("a")), -1);
+    QCOMPARE(store.lat()[0], 4.0);
+}
+
+QTEST_APPLESS_MAIN(SatelliteStoreTest)
+
+#include "tst_satellitestore.moc"
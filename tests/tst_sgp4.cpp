@@ -0,0 +1,152 @@
+#include <QtTest>
+#include <cmath>
+
+#include "Sgp4.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Sgp4Propagator against the near-Earth cases of Vallado's SGP4-VER verification set (tcppver.out, WGS-72): TEME
+// positions to within a metre, plus the rejection of a deep-space element set, which needs SDP4.
+
+namespace
+{
+constexpr double ToleranceKm = 1e-3;
+
+// A TLE epoch (two-digit year, fractional day of year) as a Julian date; both cases fall in 2000-2056.
+double tleEpochJd(int year2, double dayOfYear)
+{
+    const int year = 2000 + year2;
+    const int daysBefore = (year - 2000) * 365 + (year - 1997) / 4; // days from 2000-01-01 to 1 January of `year`
+    return 2451544.5 + daysBefore + (dayOfYear - 1.0);
+}
+
+// 1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753
+// 2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667
+Sgp4Elements vanguard()
+{
+    Sgp4Elements el;
+    el.epochJd = tleEpochJd(0, 179.78495062);
+    el.meanMotionRevDay = 10.82419157;
+    el.eccentricity = 0.1859667;
+    el.inclinationDeg = 34.2682;
+    el.raanDeg = 348.7242;
+    el.argPerigeeDeg = 331.7664;
+    el.meanAnomalyDeg = 19.3264;
+    el.bstar = 0.28098e-4;
+    return el;
+}
+
+// 1 06251U 62025E   06176.82412014  .00008885  00000-0  12808-3 0  3985
+// 2 06251  58.0579  54.0425 0030035 139.1568 221.1854 15.56387291  6374
+Sgp4Elements delta1Debris()
+{
+    Sgp4Elements el;
+    el.epochJd = tleEpochJd(6, 176.82412014);
+    el.meanMotionRevDay = 15.56387291;
+    el.eccentricity = 0.0030035;
+    el.inclinationDeg = 58.0579;
+    el.raanDeg = 54.0425;
+    el.argPerigeeDeg = 139.1568;
+    el.meanAnomalyDeg = 221.1854;
+    el.bstar = 0.12808e-3;
+    return el;
+}
+}
+
+class Sgp4Test : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void referencePositions_data();
+    void referencePositions();
+    void rejectsDeepSpace();
+    void rejectsInvalidElements();
+    void propagatesGeodetic();
+};
+
+void Sgp4Test::referencePositions_data()
+{
+    QTest::addColumn<int>("satellite");
+    QTest::addColumn<double>("tsince");
+    QTest::addColumn<double>("x");
+    QTest::addColumn<double>("y");
+    QTest::addColumn<double>("z");
+    QTest::newRow("00005 0") << 5 << 0.0 << 7022.46529266 << -1400.08296755 << 0.03995155;
+    QTest::newRow("00005 360") << 5 << 360.0 << -7154.03120202 << -3783.17682504 << -3536.19412294;
+    QTest::newRow("00005 720") << 5 << 720.0 << -7134.59340119 << 6531.68641334 << 3260.27186483;
+    QTest::newRow("00005 1080") << 5 << 1080.0 << 5568.53901181 << 4492.06992591 << 3863.87641983;
+    QTest::newRow("00005 1440") << 5 << 1440.0 << -938.55923943 << -6268.18748831 << -4294.02924751;
+    QTest::newRow("06251 0") << 6251 << 0.0 << 3988.31022699 << 5498.96657235 << 0.90055879;
+    QTest::newRow("06251 120") << 6251 << 120.0 << -3935.69800083 << 409.10980837 << 5471.33577327;
+}
+
+void Sgp4Test::referencePositions()
+{
+    QFETCH(int, satellite);
+    QFETCH(double, tsince);
+    QFETCH(double, x);
+    QFETCH(double, y);
+    QFETCH(double, z);
+    Sgp4Propagator propagator;
+    const int slot = propagator.add(satellite == 5 ? vanguard() : delta1Debris());
+    QCOMPARE(slot, 0);
+    double r[3];
+    QVERIFY(propagator.positionTeme(std::size_t(slot), tsince, r));
+    const double expected[3] = {x, y, z};
+    for (int i = 0; i < 3; ++i) {
+        const QString message = QStringLiteral("component %1: %2 km, reference %3 km")
+                                    .arg(i)
+                                    .arg(r[i], 0, 'f', 8)
+                                    .arg(expected[i], 0, 'f', 8);
+        QVERIFY2(std::abs(r[i] - expected[i]) <= ToleranceKm, qPrintable(message));
+    }
+}
+
+void Sgp4Test::rejectsDeepSpace()
+{
+    // 2 rev/day is a 720 min period, well past the 225 min SDP4 boundary.
+    Sgp4Elements el = vanguard();
+    el.meanMotionRevDay = 2.0;
+    Sgp4Propagator propagator;
+    QCOMPARE(propagator.add(el), -1);
+    QCOMPARE(propagator.size(), std::size_t(0));
+}
+
+void Sgp4Test::rejectsInvalidElements()
+{
+    Sgp4Propagator propagator;
+    Sgp4Elements el = vanguard();
+    el.eccentricity = 1.0;
+    QCOMPARE(propagator.add(el), -1);
+    el = vanguard();
+    el.meanMotionRevDay = 0.0;
+    QCOMPARE(propagator.add(el), -1);
+    QCOMPARE(propagator.size(), std::size_t(0));
+}
+
+void Sgp4Test::propagatesGeodetic()
+{
+    // The batch call at each epoch: latitudes within the inclination, altitudes between perigee and apogee.
+    struct Case
+    {
+        Sgp4Elements elements;
+        double maxLat, minAlt, maxAlt;
+    };
+    for (const Case &c : {Case {vanguard(), 34.3, 600.0, 3900.0}, Case {delta1Debris(), 58.1, 250.0, 450.0}}) {
+        Sgp4Propagator propagator;
+        QCOMPARE(propagator.add(c.elements), 0);
+        double lat = 0.0, lon = 0.0, alt = 0.0;
+        unsigned char ok = 0;
+        propagator.propagate(c.elements.epochJd + 0.1, &lat, &lon, &alt, &ok);
+        QVERIFY(ok);
+        QVERIFY2(std::abs(lat) <= c.maxLat, qPrintable(QString::number(lat)));
+        QVERIFY2(lon >= -180.0 && lon <= 180.0, qPrintable(QString::number(lon)));
+        QVERIFY2(alt > c.minAlt && alt < c.maxAlt, qPrintable(QString::number(alt)));
+    }
+}
+
+QTEST_APPLESS_MAIN(Sgp4Test)
+
+#include "tst_sgp4.moc"
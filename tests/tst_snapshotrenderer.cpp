@@ -0,0 +1,86 @@
+#include <QGuiApplication>
+#include <QImage>
+#include <QtTest>
+#include <algorithm>
+#include <cstdlib>
+
+#include "EarthSnapshotRenderer.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// The snapshot renderer draws the overlay layers, not only the background: a satellite dot changes the pixels under
+// it. Needs an RHI backend; headless, that is QT_QPA_PLATFORM=offscreen with Mesa llvmpipe.
+
+namespace
+{
+int channelDistance(QRgb a, QRgb b)
+{
+    return std::max({std::abs(qRed(a) - qRed(b)), std::abs(qGreen(a) - qGreen(b)), std::abs(qBlue(a) - qBlue(b))});
+}
+}
+
+class SnapshotRendererTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void drawsSatelliteOverBackground();
+    void failedRenderKeepsRendererValid();
+};
+
+void SnapshotRendererTest::drawsSatelliteOverBackground()
+{
+    EarthSnapshotRenderer renderer;
+    QVERIFY2(renderer.isValid(), qPrintable(renderer.errorString()));
+
+    EarthSnapshotRenderer::Options options;
+    options.size = QSize(512, 256);
+    const QImage background = renderer.render({}, options);
+    QVERIFY2(!background.isNull(), qPrintable(renderer.errorString()));
+    QCOMPARE(background.size(), options.size);
+
+    // Lat 0, lon 0 is the centre of a whole-world view centred on the prime meridian.
+    EarthSnapshotRenderer::Snapshot snapshot;
+    snapshot.satellites.append(QVariantMap {{QStringLiteral("ID"), QStringLiteral("SAT-1")},
+                                            {QStringLiteral("Lat"), 0.0},
+                                            {QStringLiteral("Lon"), 0.0}});
+    const QImage overlay = renderer.render(snapshot, options);
+    QVERIFY2(!overlay.isNull(), qPrintable(renderer.errorString()));
+
+    const QPoint dot(options.size.width() / 2, options.size.height() / 2);
+    const int distance = channelDistance(overlay.pixel(dot), background.pixel(dot));
+    QVERIFY2(distance > 32, qPrintable(QStringLiteral("satellite pixel differs from the background by %1").arg(distance)));
+
+    // Away from the dot the frame is unchanged.
+    const QPoint away(dot.x() / 2, dot.y() / 2);
+    QCOMPARE(overlay.pixel(away), background.pixel(away));
+}
+
+void SnapshotRendererTest::failedRenderKeepsRendererValid()
+{
+    EarthSnapshotRenderer renderer;
+    QVERIFY2(renderer.isValid(), qPrintable(renderer.errorString()));
+
+    EarthSnapshotRenderer::Options options;
+    options.size = QSize();
+    QVERIFY(renderer.render({}, options).isNull());
+    QVERIFY(!renderer.errorString().isEmpty());
+    QVERIFY(renderer.isValid());
+
+    // The next snapshot renders and clears the error.
+    options.size = QSize(256, 128);
+    QVERIFY2(!renderer.render({}, options).isNull(), qPrintable(renderer.errorString()));
+    QVERIFY(renderer.errorString().isEmpty());
+}
+
+int main(int argc, char *argv[])
+{
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QGuiApplication app(argc, argv);
+    SnapshotRendererTest test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "tst_snapshotrenderer.moc"
@@ -0,0 +1,301 @@
+#include <QGuiApplication>
+#include <QQuickItem>
+#include <QQuickWindow>
+#include <QtTest>
+#include <memory>
+
+#include "EarthView.h"
+#include "FeedCodec.h"
+#include "OffscreenRenderer.h"
+#include "Projection.h"
+#include "SyntheticConstellation.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// EarthView micro-benchmarks over synthetic constellations: ingestion, a full frame, hit testing and decoding.
+// Machine-readable output comes from QtTest, e.g. `earth-view-bench -o results.xml,xml` or `-o results.csv,csv`.
+
+namespace
+{
+constexpr QSize ViewSize(1280, 640);
+
+SyntheticConstellation makeConstellation(int satellites, int stations)
+{
+    SyntheticConstellation::Config config;
+    config.satelliteCount = satellites;
+    config.groundStationCount = stations;
+    config.edgeCases = SyntheticConstellation::SeamCrossings | SyntheticConstellation::PolePasses;
+    return SyntheticConstellation(config);
+}
+
+// Probe points spread over the view, half of them near objects.
+QVector<QPointF> probePoints(EarthView &view, const QVariantList &satellites)
+{
+    QVector<QPointF> points;
+    const int grid = 8;
+    for (int y = 0; y < grid; ++y) {
+        for (int x = 0; x < grid; ++x)
+            points.append(QPointF((x + 0.5) * view.width() / grid, (y + 0.5) * view.height() / grid));
+    }
+    const int step = std::max(1, int(satellites.size() / 64));
+    for (int i = 0; i < satellites.size() && points.size() < 128; i += step) {
+        const QVariantMap m = satellites[i].toMap();
+        const double lon = m.value(QStringLiteral("Lon")).toDouble();
+        const double lat = m.value(QStringLiteral("Lat")).toDouble();
+        points.append(QPointF((lon + 180.0) / 360.0 * view.width(), (90.0 - lat) / 180.0 * view.height()));
+    }
+    return points;
+}
+}
+
+class EarthViewBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void setSatellites_data();
+    void setSatellites();
+    void setGroundStations_data();
+    void setGroundStations();
+    void setGroundStationData_data();
+    void setGroundStationData();
+
+    void renderFrame_data();
+    void renderFrame();
+
+    void satelliteAt_data();
+    void satelliteAt();
+    void groundStationAt_data();
+    void groundStationAt();
+
+    void projectWrapped_data();
+    void projectWrapped();
+
+    void decodeCborStates_data();
+    void decodeCborStates();
+    void decodeCompactStates_data();
+    void decodeCompactStates();
+
+private:
+    void addSatelliteRows();
+    void addStationRows();
+
+    std::unique_ptr<OffscreenRenderer> m_renderer;
+    EarthView *m_view {nullptr};
+};
+
+void EarthViewBench::initTestCase()
+{
+    m_renderer = std::make_unique<OffscreenRenderer>();
+    m_view = new EarthView(m_renderer->window()->contentItem());
+    m_view->waitForBackground();
+    m_view->setSize(ViewSize);
+    QVERIFY2(m_renderer->setSize(ViewSize), qPrintable(m_renderer->errorString()));
+}
+
+void EarthViewBench::addSatelliteRows()
+{
+    QTest::addColumn<int>("satellites");
+    for (int n : {100, 1000, 10000, 100000})
+        QTest::addRow("%d", n) << n;
+}
+
+void EarthViewBench::addStationRows()
+{
+    QTest::addColumn<int>("stations");
+    for (int n : {10, 100, 1000, 5000})
+        QTest::addRow("%d", n) << n;
+}
+
+void EarthViewBench::setSatellites_data()
+{
+    addSatelliteRows();
+}
+
+void EarthViewBench::setSatellites()
+{
+    QFETCH(int, satellites);
+    const QVariantList sats = makeConstellation(satellites, 0).satellites(0.0);
+    QBENCHMARK {
+        m_view->setSatellites(sats);
+    }
+}
+
+void EarthViewBench::setGroundStations_data()
+{
+    addStationRows();
+}
+
+void EarthViewBench::setGroundStations()
+{
+    QFETCH(int, stations);
+    QVariantList list;
+    for (const GroundStation &gs : makeConstellation(0, stations).groundStations())
+        list.append(gs.toVariantMap());
+    QBENCHMARK {
+        m_view->setGroundStations(list);
+    }
+}
+
+void EarthViewBench::setGroundStationData_data()
+{
+    addStationRows();
+}
+
+void EarthViewBench::setGroundStationData()
+{
+    QFETCH(int, stations);
+    const GroundStationList list = makeConstellation(0, stations).groundStations();
+    QBENCHMARK {
+        m_view->setGroundStationData(list);
+    }
+}
+
+void EarthViewBench::renderFrame_data()
+{
+    QTest::addColumn<int>("satellites");
+    QTest::addColumn<int>("stations");
+    QTest::addColumn<bool>("moving");
+    const QList<std::pair<int, int>> sizes {{100, 10}, {1000, 100}, {10000, 1000}, {100000, 5000}};
+    for (const auto &[satellites, stations] : sizes) {
+        QTest::addRow("%dx%d", satellites, stations) << satellites << stations << true;
+        QTest::addRow("%dx%d idle", satellites, stations) << satellites << stations << false;
+    }
+}
+
+// A full frame as the app renders it: sync (updatePaintNode), then every layer drawn through the RHI into an offscreen
+// texture, up to GPU completion. Moving rows hand the view a new batch before each frame, as a live feed does; idle
+// rows redraw unchanged data.
+void EarthViewBench::renderFrame()
+{
+    QFETCH(int, satellites);
+    QFETCH(int, stations);
+    QFETCH(bool, moving);
+    const SyntheticConstellation constellation = makeConstellation(satellites, stations);
+    // Built up front so the constellation model isn't part of the measurement.
+    QVector<QVariantList> batches;
+    for (int i = 0; i < (moving ? 4 : 1); ++i)
+        batches.append(constellation.satellites(i * 10.0));
+    m_view->setSatellites(batches.first());
+    m_view->setGroundStationData(constellation.groundStations());
+    QVERIFY(m_renderer->renderFrame(false)); // build the node tree once
+
+    int next = 0;
+    QBENCHMARK {
+        if (moving) {
+            next = (next + 1) % batches.size();
+            m_view->setSatellites(batches[next]);
+        }
+        m_view->update();
+        m_renderer->renderFrame(false);
+    }
+    m_view->setSatellites({});
+    m_view->setGroundStationData({});
+}
+
+void EarthViewBench::satelliteAt_data()
+{
+    addSatelliteRows();
+}
+
+void EarthViewBench::satelliteAt()
+{
+    QFETCH(int, satellites);
+    const QVariantList sats = makeConstellation(satellites, 0).satellites(0.0);
+    m_view->setSatellites(sats);
+    const QVector<QPointF> points = probePoints(*m_view, sats);
+    QBENCHMARK {
+        for (const QPointF &p : points)
+            m_view->satelliteAtPoint(p.x(), p.y());
+    }
+    m_view->setSatellites({});
+}
+
+void EarthViewBench::groundStationAt_data()
+{
+    addStationRows();
+}
+
+void EarthViewBench::groundStationAt()
+{
+    QFETCH(int, stations);
+    m_view->setGroundStationData(makeConstellation(0, stations).groundStations());
+    const QVector<QPointF> points = probePoints(*m_view, {});
+    QBENCHMARK {
+        for (const QPointF &p : points)
+            m_view->groundStationAtPoint(p.x(), p.y());
+    }
+    m_view->setGroundStationData({});
+}
+
+void EarthViewBench::projectWrapped_data()
+{
+    addSatelliteRows();
+}
+
+// Throughput of the batch kernel; tests/tst_projection.cpp checks it against the scalar reference.
+void EarthViewBench::projectWrapped()
+{
+    QFETCH(int, satellites);
+    QVector<double> lat;
+    QVector<double> lon;
+    for (const QVariant &v : makeConstellation(satellites, 0).satellites(0.0)) {
+        const QVariantMap m = v.toMap();
+        lat.append(m.value(QStringLiteral("Lat")).toDouble());
+        lon.append(m.value(QStringLiteral("Lon")).toDouble());
+    }
+    const auto mapping = Projection::Mapping::forView(QRectF(QPointF(0, 0), ViewSize), 123.4);
+    QVector<float> xy(lat.size() * 2);
+    QBENCHMARK {
+        Projection::projectWrapped(mapping, lat.constData(), lon.constData(), lat.size(), 1, xy.data());
+    }
+}
+
+void EarthViewBench::decodeCborStates_data()
+{
+    addSatelliteRows();
+}
+
+void EarthViewBench::decodeCborStates()
+{
+    QFETCH(int, satellites);
+    const QByteArray payload = makeConstellation(satellites, 0).statesPayload(0.0);
+    QVERIFY(!FeedCodec::decodeStates(payload).isEmpty());
+    QBENCHMARK {
+        FeedCodec::decodeStates(payload);
+    }
+}
+
+void EarthViewBench::decodeCompactStates_data()
+{
+    addSatelliteRows();
+}
+
+void EarthViewBench::decodeCompactStates()
+{
+    QFETCH(int, satellites);
+    const SyntheticConstellation constellation = makeConstellation(satellites, 0);
+    CompactStates::Encoder encoder;
+    const QByteArray key = encoder.encode(constellation.batch(0.0));
+    const QByteArray delta = encoder.encode(constellation.batch(1.0));
+    FeedCodec::States states;
+    QBENCHMARK {
+        FeedCodec::StatesDecoder decoder;
+        decoder.decode(key, states);
+        decoder.decode(delta, states);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QGuiApplication app(argc, argv);
+    EarthViewBench bench;
+    return QTest::qExec(&bench, argc, argv);
+}
+
+#include "bench.moc"
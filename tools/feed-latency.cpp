@@ -0,0 +1,233 @@
+#include <QByteArray>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QTextStream>
+#include <QtNumeric>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "CompactStates.h"
+#include "FeedCodec.h"
+#include "LatencyHistogram.h"
+#include "ShmStateRing.h"
+#include "SyntheticConstellation.h"
+#include "nats.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Publish-to-decoded latency of the two same-host transports, measured in one process over a synthetic constellation:
+//
+//   shm:  ShmStateWriter commit -> ShmStateReader -> CompactStates::Batch columns (the ShmFeedSource path)
+//   nats: compact frame published to a nats-server on loopback -> subscription -> FeedCodec decode into the columns
+//         OrbitFeed publishes
+//
+// Both consumers read as soon as data arrives. The shared-memory reader spins here, whereas ShmFeedSource polls once per
+// display frame, so the figures compare the transports rather than the poll interval. The NATS leg needs a server at
+// --server and is skipped if none answers.
+
+namespace
+{
+constexpr char SentTimeHeader[] = "Ev-Sent-Ns";
+constexpr auto DrainTimeout = std::chrono::seconds(2);
+
+using Clock = std::chrono::steady_clock;
+
+// Calls `publish(frame)` `frames` times at `rateHz`.
+template<typename Publish>
+void paced(int frames, double rateHz, Publish publish)
+{
+    const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rateHz));
+    auto nextTick = Clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        publish(frame);
+        nextTick += period;
+        std::this_thread::sleep_until(nextTick);
+    }
+}
+
+bool measureShm(const SyntheticConstellation &constellation, int frames, double rateHz, LatencyHistogram &latency,
+                QString &error)
+{
+    const QString name = QStringLiteral("earth-view-latency-%1").arg(QCoreApplication::applicationPid());
+    const int count = constellation.config().satelliteCount;
+    ShmStateWriter writer;
+    ShmStateReader reader;
+    if (!writer.create(name, quint32(count)) || !reader.open(name)) {
+        error = writer.isOpen() ? reader.errorString() : writer.errorString();
+        return false;
+    }
+
+    std::atomic<int> received {0};
+    std::atomic<bool> done {false};
+    std::thread consumer([&]() {
+        quint64 lastFrame = 0;
+        ShmState::State st;
+        CompactStates::Batch batch;
+        while (!done.load(std::memory_order_relaxed)) {
+            const quint64 frame = reader.frame();
+            if (frame == lastFrame) {
+                std::this_thread::yield();
+                continue;
+            }
+            lastFrame = frame;
+            batch = CompactStates::Batch();
+            const quint32 n = reader.count();
+            for (quint32 i = 0; i < n; ++i) {
+                if (!reader.read(i, st))
+                    continue;
+                batch.ids.append(quint32(st.id));
+                batch.lat.append(st.lat);
+                batch.lon.append(st.lon);
+                batch.alt.append(st.altKm);
+                batch.latPast.append(double(st.latPast));
+                batch.lonPast.append(double(st.lonPast));
+                batch.latFuture.append(double(st.latFuture));
+                batch.lonFuture.append(double(st.lonFuture));
+            }
+            latency.record(qint64(ShmState::nowNs() - reader.frameTimeNs()));
+            received.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    paced(frames, rateHz, [&](int frame) {
+        const CompactStates::Batch batch = constellation.batch(frame / rateHz);
+        for (int i = 0; i < batch.count(); ++i) {
+            ShmState::State st;
+            st.id = batch.ids[i];
+            st.lat = batch.lat[i];
+            st.lon = batch.lon[i];
+            st.altKm = batch.alt[i];
+            st.latPast = float(batch.latPast.value(i, qQNaN()));
+            st.lonPast = float(batch.lonPast.value(i, qQNaN()));
+            st.latFuture = float(batch.latFuture.value(i, qQNaN()));
+            st.lonFuture = float(batch.lonFuture.value(i, qQNaN()));
+            writer.write(quint32(i), st);
+        }
+        writer.commit(quint32(batch.count()), ShmState::nowNs());
+    });
+
+    // A reader that falls behind sees only the latest frame, so not every frame is necessarily counted.
+    const auto deadline = Clock::now() + DrainTimeout;
+    while (Clock::now() < deadline && reader.frame() != quint64(frames))
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    done = true;
+    consumer.join();
+    return received > 0;
+}
+
+struct NatsReceiver
+{
+    FeedCodec::StatesDecoder decoder;
+    LatencyHistogram *latency {nullptr};
+    std::atomic<int> received {0};
+    qint64 objects {0};
+};
+
+void onNatsMessage(natsConnection *, natsSubscription *, natsMsg *msg, void *closure)
+{
+    auto *receiver = static_cast<NatsReceiver *>(closure);
+    const char *sent = nullptr;
+    const qint64 sentNs =
+        natsMsgHeader_Get(msg, SentTimeHeader, &sent) == NATS_OK && sent ? QByteArray(sent).toLongLong() : 0;
+    FeedCodec::States states;
+    receiver->decoder.decode(QByteArray::fromRawData(natsMsg_GetData(msg), natsMsg_GetDataLength(msg)), states);
+    if (sentNs > 0)
+        receiver->latency->record(LatencyHistogram::nowNs() - sentNs);
+    receiver->objects += states.columns.count();
+    receiver->received.fetch_add(1, std::memory_order_release);
+    natsMsg_Destroy(msg);
+}
+
+bool measureNats(const SyntheticConstellation &constellation, const QByteArray &url, int frames, double rateHz,
+                 LatencyHistogram &latency, QString &error)
+{
+    const QByteArray subject = QByteArray("earth-view.latency.") + QByteArray::number(QCoreApplication::applicationPid());
+    natsConnection *conn = nullptr;
+    natsSubscription *sub = nullptr;
+    NatsReceiver receiver;
+    receiver.latency = &latency;
+
+    natsStatus s = natsConnection_ConnectTo(&conn, url.constData());
+    if (s == NATS_OK)
+        s = natsConnection_Subscribe(&sub, conn, subject.constData(), &onNatsMessage, &receiver);
+    if (s == NATS_OK)
+        s = natsConnection_Flush(conn); // the subscription is registered before the first publish
+    if (s != NATS_OK) {
+        error = QString::fromLatin1(natsStatus_GetText(s));
+        natsSubscription_Destroy(sub);
+        natsConnection_Destroy(conn);
+        return false;
+    }
+
+    CompactStates::Encoder encoder;
+    paced(frames, rateHz, [&](int frame) {
+        const QByteArray payload = encoder.encode(constellation.batch(frame / rateHz));
+        natsMsg *msg = nullptr;
+        if (natsMsg_Create(&msg, subject.constData(), nullptr, payload.constData(), int(payload.size())) != NATS_OK)
+            return;
+        natsMsgHeader_Set(msg, SentTimeHeader, QByteArray::number(LatencyHistogram::nowNs()).constData());
+        natsConnection_PublishMsg(conn, msg);
+        natsMsg_Destroy(msg);
+    });
+
+    const auto deadline = Clock::now() + DrainTimeout;
+    while (Clock::now() < deadline && receiver.received.load(std::memory_order_acquire) < frames)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    natsSubscription_Unsubscribe(sub);
+    natsSubscription_Destroy(sub);
+    natsConnection_Destroy(conn);
+    if (receiver.received < frames)
+        error = QStringLiteral("%1 of %2 messages arrived").arg(receiver.received.load()).arg(frames);
+    return receiver.received > 0;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        QStringLiteral("Compares publish-to-decoded latency of shared memory and NATS over loopback."));
+    parser.addHelpOption();
+    const QCommandLineOption countOption(QStringLiteral("count"), QStringLiteral("Satellite count."), QStringLiteral("count"),
+                                         QStringLiteral("5000"));
+    const QCommandLineOption framesOption(QStringLiteral("frames"), QStringLiteral("Frames per transport."),
+                                          QStringLiteral("frames"), QStringLiteral("500"));
+    const QCommandLineOption rateOption(QStringLiteral("rate"), QStringLiteral("Frames per second."), QStringLiteral("hz"),
+                                        QStringLiteral("50"));
+    const QCommandLineOption serverOption(QStringLiteral("server"), QStringLiteral("NATS server on this host."),
+                                          QStringLiteral("url"), QStringLiteral("nats://127.0.0.1:4222"));
+    parser.addOptions({countOption, framesOption, rateOption, serverOption});
+    parser.process(app);
+
+    SyntheticConstellation::Config config;
+    config.satelliteCount = std::max(parser.value(countOption).toInt(), 1);
+    const SyntheticConstellation constellation(config);
+    const int frames = std::max(parser.value(framesOption).toInt(), 1);
+    const double rateHz = std::max(parser.value(rateOption).toDouble(), 0.1);
+
+    QTextStream out(stdout);
+    out << config.satelliteCount << " objects, " << frames << " frames at " << rateHz << " Hz" << Qt::endl;
+
+    QString error;
+    LatencyHistogram shmLatency;
+    if (measureShm(constellation, frames, rateHz, shmLatency, error))
+        out << "shm:  " << shmLatency.take().toString() << Qt::endl;
+    else
+        out << "shm:  failed (" << error << ")" << Qt::endl;
+
+    error.clear();
+    LatencyHistogram natsLatency;
+    const bool natsOk = measureNats(constellation, parser.value(serverOption).toUtf8(), frames, rateHz, natsLatency, error);
+    if (natsOk)
+        out << "nats: " << natsLatency.take().toString() << Qt::endl;
+    if (!error.isEmpty())
+        out << "nats: " << (natsOk ? "incomplete" : "skipped") << " (" << error << ")" << Qt::endl;
+    nats_Close();
+    return 0;
+}
@@ -0,0 +1,263 @@
+#include <QCommandLineParser>
+#include <QCryptographicHash>
+#include <QFile>
+#include <QGuiApplication>
+#include <QImage>
+#include <QQuickItem>
+#include <QQuickWindow>
+#include <QTextStream>
+#include <ctime>
+#include <memory>
+
+#include "EarthView.h"
+#include "OffscreenRenderer.h"
+#include "SyntheticConstellation.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Headless frame-time harness: renders an EarthView through QQuickRenderControl and an RHI backend into a texture (no
+// display; Mesa llvmpipe stands in for a GPU), drives scripted data updates and centerLongitude pans, and writes one
+// CSV row per frame. With --golden it also reads back fixed seam-crossing scenes, overlays included, and compares
+// image checksums against a file. Checksums depend on the rasteriser, so keep one golden file per backend and driver.
+
+namespace
+{
+struct Scene
+{
+    QSize size;
+    bool portrait {false};
+};
+
+// One offscreen window rendering an EarthView through the RHI, so every layer is drawn, timed and hashed.
+class OffscreenView
+{
+public:
+    explicit OffscreenView(const Scene &scene)
+    {
+        m_view = new EarthView(m_renderer.window()->contentItem());
+        m_view->waitForBackground(); // golden scenes include it
+        m_view->setSize(scene.size);
+        m_view->setRotatePortrait(scene.portrait);
+        m_renderer.window()->setColor(Qt::black);
+        m_ok = m_renderer.setSize(scene.size);
+    }
+
+    bool isValid() const { return m_ok; }
+    QString errorString() const { return m_renderer.errorString(); }
+    EarthView *view() const { return m_view; }
+
+    // Returns the sync (polish + updatePaintNode) time; `renderNs` gets the time to record, submit and finish the
+    // frame on the GPU. With `readback` the frame is also copied back for checksum().
+    qint64 renderFrame(qint64 &renderNs, bool readback = false)
+    {
+        OffscreenRenderer::FrameTimes times;
+        if (!m_renderer.renderFrame(readback, &times))
+            return -1;
+        renderNs = times.renderNs;
+        return times.syncNs;
+    }
+
+    QByteArray checksum() const
+    {
+        const QImage &image = m_renderer.image();
+        return QCryptographicHash::hash(QByteArrayView(reinterpret_cast<const char *>(image.constBits()), image.sizeInBytes()),
+                                        QCryptographicHash::Sha1)
+            .toHex();
+    }
+
+private:
+    OffscreenRenderer m_renderer;
+    EarthView *m_view {nullptr};
+    bool m_ok {false};
+};
+
+QList<Scene> parseScenes(const QString &sizes, const QString &rotate)
+{
+    QList<bool> rotations;
+    if (rotate == QLatin1String("on"))
+        rotations = {true};
+    else if (rotate == QLatin1String("both"))
+        rotations = {false, true};
+    else
+        rotations = {false};
+
+    QList<Scene> scenes;
+    for (const QString &spec : sizes.split(QLatin1Char(','), Qt::SkipEmptyParts)) {
+        const QStringList wh = spec.trimmed().split(QLatin1Char('x'));
+        const int w = wh.value(0).toInt();
+        const int h = wh.value(1).toInt();
+        if (w <= 0 || h <= 0)
+            continue;
+        for (bool portrait : rotations)
+            scenes.append({QSize(w, h), portrait});
+    }
+    return scenes;
+}
+
+QString sceneName(const Scene &scene)
+{
+    return QStringLiteral("%1x%2%3").arg(scene.size.width()).arg(scene.size.height()).arg(scene.portrait ? QStringLiteral("r") : QString());
+}
+
+// Seam regressions show up as changed pixels near the dateline: render the edge-case constellation at centres
+// that put the seam at the edges and in the middle of the view.
+QStringList goldenChecksums(const QList<Scene> &scenes)
+{
+    SyntheticConstellation::Config config;
+    config.satelliteCount = 200;
+    config.groundStationCount = 20;
+    config.edgeCases = SyntheticConstellation::SeamCrossings | SyntheticConstellation::PolePasses;
+    const SyntheticConstellation constellation(config);
+
+    QStringList lines;
+    for (const Scene &scene : scenes) {
+        OffscreenView offscreen(scene);
+        if (!offscreen.isValid()) {
+            lines.append(QStringLiteral("%1 unavailable: %2").arg(sceneName(scene), offscreen.errorString()));
+            continue;
+        }
+        offscreen.view()->setSatellites(constellation.satellites(0.0));
+        offscreen.view()->setGroundStationData(constellation.groundStations());
+        for (double centre : {-180.0, -90.0, 0.0, 90.0, 179.5}) {
+            offscreen.view()->setCenterLongitude(centre);
+            qint64 renderNs = 0;
+            offscreen.renderFrame(renderNs, true);
+            lines.append(QStringLiteral("%1 %2 %3").arg(sceneName(scene)).arg(centre).arg(QString::fromLatin1(offscreen.checksum())));
+        }
+    }
+    return lines;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QGuiApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    const QCommandLineOption sizesOption(QStringLiteral("sizes"), QStringLiteral("Comma-separated view sizes."), QStringLiteral("WxH,..."),
+                                         QStringLiteral("1280x640,390x844"));
+    const QCommandLineOption rotateOption(QStringLiteral("rotate"), QStringLiteral("Portrait rotation: off, on or both."),
+                                          QStringLiteral("mode"), QStringLiteral("off"));
+    const QCommandLineOption satellitesOption(QStringLiteral("satellites"), QStringLiteral("Synthetic satellite count."),
+                                              QStringLiteral("count"), QStringLiteral("5000"));
+    const QCommandLineOption stationsOption(QStringLiteral("stations"), QStringLiteral("Synthetic ground-station count."),
+                                            QStringLiteral("count"), QStringLiteral("50"));
+    const QCommandLineOption framesOption(QStringLiteral("frames"), QStringLiteral("Frames per scene."), QStringLiteral("count"),
+                                          QStringLiteral("300"));
+    const QCommandLineOption updateOption(QStringLiteral("update-every"), QStringLiteral("New satellite batch every n frames (0: never)."),
+                                          QStringLiteral("frames"), QStringLiteral("6"));
+    const QCommandLineOption panOption(QStringLiteral("pan"), QStringLiteral("centerLongitude change per frame."), QStringLiteral("degrees"),
+                                       QStringLiteral("0.5"));
+    const QCommandLineOption csvOption(QStringLiteral("csv"), QStringLiteral("Per-frame CSV output (default: stdout)."), QStringLiteral("file"));
+    const QCommandLineOption goldenOption(QStringLiteral("golden"),
+                                          QStringLiteral("Compare seam-scene checksums with this file (written if missing)."),
+                                          QStringLiteral("file"));
+    const QCommandLineOption updateGoldenOption(QStringLiteral("update-golden"), QStringLiteral("Rewrite the golden file."));
+    parser.addOptions({sizesOption, rotateOption, satellitesOption, stationsOption, framesOption, updateOption, panOption, csvOption,
+                       goldenOption, updateGoldenOption});
+    parser.process(app);
+
+    QTextStream err(stderr);
+    const QList<Scene> scenes = parseScenes(parser.value(sizesOption), parser.value(rotateOption));
+    if (scenes.isEmpty()) {
+        err << "No valid --sizes\n";
+        return 2;
+    }
+
+    QFile csvFile;
+    if (parser.isSet(csvOption)) {
+        csvFile.setFileName(parser.value(csvOption));
+        if (!csvFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+            err << "Cannot write " << csvFile.fileName() << "\n";
+            return 2;
+        }
+    } else {
+        csvFile.open(stdout, QIODevice::WriteOnly | QIODevice::Text);
+    }
+    QTextStream csv(&csvFile);
+    csv << "scene,frame,centerLongitude,dataUpdate,cpuMs,syncMs,renderMs,updatePaintNodeMs,nodes,vertices,vertexBytes\n";
+
+    SyntheticConstellation::Config config;
+    config.satelliteCount = parser.value(satellitesOption).toInt();
+    config.groundStationCount = parser.value(stationsOption).toInt();
+    const SyntheticConstellation constellation(config);
+    const int frames = parser.value(framesOption).toInt();
+    const int updateEvery = parser.value(updateOption).toInt();
+    const double pan = parser.value(panOption).toDouble();
+
+    for (const Scene &scene : scenes) {
+        OffscreenView offscreen(scene);
+        if (!offscreen.isValid()) {
+            err << sceneName(scene) << ": " << offscreen.errorString() << "\n";
+            return 1;
+        }
+        EarthView *view = offscreen.view();
+        view->setGroundStationData(constellation.groundStations());
+        view->setSatellites(constellation.satellites(0.0));
+
+        double centre = 0.0;
+        for (int frame = 0; frame < frames; ++frame) {
+            const bool dataUpdate = updateEvery > 0 && frame > 0 && frame % updateEvery == 0;
+            if (dataUpdate)
+                view->setSatellites(constellation.satellites(frame / 60.0));
+            view->setCenterLongitude(centre);
+
+            const std::clock_t cpuStart = std::clock();
+            qint64 renderNs = 0;
+            const qint64 syncNs = offscreen.renderFrame(renderNs);
+            if (syncNs < 0) {
+                err << sceneName(scene) << ": " << offscreen.errorString() << "\n";
+                return 1;
+            }
+            const double cpuMs = 1000.0 * double(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+            const QVariantMap stats = view->renderStats();
+            qint64 vertices = 0;
+            const QVariantMap perLayer = stats.value(QStringLiteral("vertices")).toMap();
+            for (const QVariant &v : perLayer)
+                vertices += v.toLongLong();
+            csv << sceneName(scene) << ',' << frame << ',' << centre << ',' << int(dataUpdate) << ',' << cpuMs << ',' << syncNs / 1e6 << ','
+                << renderNs / 1e6 << ',' << stats.value(QStringLiteral("totalMs")).toDouble() << ','
+                << stats.value(QStringLiteral("nodes")).toInt() << ',' << vertices << ','
+                << stats.value(QStringLiteral("totalBytes")).toLongLong() << '\n';
+
+            centre += pan;
+            if (centre > 180.0)
+                centre -= 360.0;
+        }
+    }
+    csv.flush();
+
+    if (!parser.isSet(goldenOption))
+        return 0;
+
+    const QStringList checksums = goldenChecksums(scenes);
+    QFile golden(parser.value(goldenOption));
+    if (parser.isSet(updateGoldenOption) || !golden.exists()) {
+        if (!golden.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+            err << "Cannot write " << golden.fileName() << "\n";
+            return 2;
+        }
+        golden.write(checksums.join(QLatin1Char('\n')).toUtf8() + '\n');
+        err << "Wrote " << checksums.size() << " checksums to " << golden.fileName() << "\n";
+        return 0;
+    }
+    if (!golden.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        err << "Cannot read " << golden.fileName() << "\n";
+        return 2;
+    }
+    const QStringList expected = QString::fromUtf8(golden.readAll()).split(QLatin1Char('\n'), Qt::SkipEmptyParts);
+    int mismatches = 0;
+    for (const QString &line : checksums) {
+        if (!expected.contains(line)) {
+            err << "Golden mismatch: " << line << "\n";
+            ++mismatches;
+        }
+    }
+    err << (mismatches ? "FAIL" : "PASS") << ": " << checksums.size() - mismatches << "/" << checksums.size() << " seam scenes match\n";
+    return mismatches ? 1 : 0;
+}
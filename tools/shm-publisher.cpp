@@ -0,0 +1,84 @@
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QTextStream>
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <thread>
+
+#include "ShmStateRing.h"
+#include "SyntheticConstellation.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Stand-in for a co-located propagator: writes a synthetic constellation into a shared-memory segment at a fixed
+// rate, for exercising `appEarthView --shm <name>`.
+
+namespace
+{
+volatile std::sig_atomic_t g_stop = 0;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    const QCommandLineOption nameOption(QStringLiteral("name"), QStringLiteral("Shared-memory segment name."), QStringLiteral("name"),
+                                        QStringLiteral("earth-view-states"));
+    const QCommandLineOption countOption(QStringLiteral("count"), QStringLiteral("Satellite count."), QStringLiteral("count"),
+                                         QStringLiteral("1000"));
+    const QCommandLineOption rateOption(QStringLiteral("rate"), QStringLiteral("Frames per second."), QStringLiteral("hz"),
+                                        QStringLiteral("10"));
+    parser.addOptions({nameOption, countOption, rateOption});
+    parser.process(app);
+
+    SyntheticConstellation::Config config;
+    config.satelliteCount = parser.value(countOption).toInt();
+    const SyntheticConstellation constellation(config);
+    const double rateHz = std::max(parser.value(rateOption).toDouble(), 0.1);
+
+    ShmStateWriter writer;
+    if (!writer.create(parser.value(nameOption), quint32(config.satelliteCount))) {
+        QTextStream(stderr) << "shm-publisher: " << writer.errorString() << Qt::endl;
+        return 1;
+    }
+
+    std::signal(SIGINT, [](int) { g_stop = 1; });
+    std::signal(SIGTERM, [](int) { g_stop = 1; });
+
+    using Clock = std::chrono::steady_clock;
+    const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rateHz));
+    const auto start = Clock::now();
+    auto nextTick = start;
+    while (!g_stop) {
+        const double t = std::chrono::duration<double>(Clock::now() - start).count();
+        const double dt = config.trackSeconds;
+        for (int i = 0; i < config.satelliteCount; ++i) {
+            const SyntheticConstellation::Position now = constellation.position(i, t);
+            const SyntheticConstellation::Position past = constellation.position(i, t - dt);
+            const SyntheticConstellation::Position future = constellation.position(i, t + dt);
+            ShmState::State st;
+            st.id = quint64(100000 + i);
+            st.lat = now.lat;
+            st.lon = now.lon;
+            st.altKm = now.altKm;
+            st.latPast = float(past.lat);
+            st.lonPast = float(past.lon);
+            st.latFuture = float(future.lat);
+            st.lonFuture = float(future.lon);
+            writer.write(quint32(i), st);
+        }
+        writer.commit(quint32(config.satelliteCount), ShmState::nowNs());
+
+        nextTick += period;
+        if (nextTick < Clock::now())
+            nextTick = Clock::now();
+        std::this_thread::sleep_until(nextTick);
+    }
+
+    writer.close();
+    return 0;
+}
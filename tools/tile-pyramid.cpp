@@ -0,0 +1,93 @@
+#include <QBuffer>
+#include <QCommandLineParser>
+#include <QGuiApplication>
+#include <QImage>
+#include <QTextStream>
+#include <algorithm>
+#include <cmath>
+
+#include "TilePyramid.h"
+
+// Copyright (c) 2026 Andy Armitage
+// This source is distributed under the Mozilla Public License 2.0; see LICENSE.txt.
+
+// Cuts an equirectangular image (2:1, longitude -180 at the left edge) into a tile pyramid for
+// `EarthView.backgroundTiles`. Each level is scaled down from the one above it, finest first.
+
+int main(int argc, char *argv[])
+{
+    QGuiApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Builds an EarthView background tile pyramid."));
+    parser.addHelpOption();
+    parser.addPositionalArgument(QStringLiteral("image"), QStringLiteral("Equirectangular source image."));
+    parser.addPositionalArgument(QStringLiteral("output"), QStringLiteral("Pyramid file to write."));
+    const QCommandLineOption tileSizeOption(QStringLiteral("tile-size"), QStringLiteral("Tile edge in pixels."), QStringLiteral("px"),
+                                            QStringLiteral("256"));
+    const QCommandLineOption levelsOption(QStringLiteral("levels"),
+                                          QStringLiteral("Level count (default: until the finest level matches the image)."),
+                                          QStringLiteral("n"));
+    const QCommandLineOption formatOption(QStringLiteral("format"), QStringLiteral("Tile encoding, png or jpg."), QStringLiteral("format"),
+                                          QStringLiteral("png"));
+    const QCommandLineOption qualityOption(QStringLiteral("quality"), QStringLiteral("Encoder quality, 0 to 100 (-1: default)."),
+                                           QStringLiteral("q"), QStringLiteral("-1"));
+    parser.addOptions({tileSizeOption, levelsOption, formatOption, qualityOption});
+    parser.process(app);
+
+    QTextStream err(stderr);
+    const QStringList args = parser.positionalArguments();
+    if (args.size() != 2) {
+        parser.showHelp(1);
+    }
+    QImage image(args[0]);
+    if (image.isNull()) {
+        err << "tile-pyramid: cannot read " << args[0] << Qt::endl;
+        return 1;
+    }
+    image = image.convertToFormat(QImage::Format_ARGB32);
+
+    const int tileSize = parser.value(tileSizeOption).toInt();
+    if (tileSize <= 0) {
+        err << "tile-pyramid: invalid tile size" << Qt::endl;
+        return 1;
+    }
+    // By default the finest level has 2^levels columns, as many as the image width holds.
+    int levels = parser.isSet(levelsOption) ? parser.value(levelsOption).toInt()
+                                            : int(std::floor(std::log2(std::max(1.0, double(image.width()) / tileSize))));
+    levels = std::clamp(levels, 1, TilePyramid::MaxLevels);
+    const QByteArray format = parser.value(formatOption).toLatin1();
+    const int quality = parser.value(qualityOption).toInt();
+
+    TilePyramidWriter writer;
+    if (!writer.open(args[1], tileSize, levels)) {
+        err << "tile-pyramid: " << writer.errorString() << Qt::endl;
+        return 1;
+    }
+    for (int level = levels - 1; level >= 0; --level) {
+        const int cols = TilePyramid::columns(level);
+        const int rows = TilePyramid::rows(level);
+        image = image.scaled(cols * tileSize, rows * tileSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        for (int row = 0; row < rows; ++row) {
+            for (int col = 0; col < cols; ++col) {
+                QByteArray encoded;
+                QBuffer buffer(&encoded);
+                buffer.open(QIODevice::WriteOnly);
+                if (!image.copy(col * tileSize, row * tileSize, tileSize, tileSize).save(&buffer, format.constData(), quality)) {
+                    err << "tile-pyramid: cannot encode " << format << Qt::endl;
+                    return 1;
+                }
+                if (!writer.addTile({level, col, row}, encoded)) {
+                    err << "tile-pyramid: " << writer.errorString() << Qt::endl;
+                    return 1;
+                }
+            }
+        }
+        err << "level " << level << ": " << cols << " x " << rows << " tiles" << Qt::endl;
+    }
+    if (!writer.close()) {
+        err << "tile-pyramid: " << writer.errorString() << Qt::endl;
+        return 1;
+    }
+    return 0;
+}